@@ -0,0 +1,91 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/Base64.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace AL {
+namespace usdmaya {
+
+namespace {
+const char* const g_base64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string encodeBase64(const std::string& data)
+{
+  std::string result;
+  result.reserve(((data.size() + 2) / 3) * 4);
+  size_t i = 0;
+  for(const size_t n = data.size(); i + 2 < n; i += 3)
+  {
+    const uint32_t bits = (uint8_t(data[i]) << 16) | (uint8_t(data[i + 1]) << 8) | uint8_t(data[i + 2]);
+    result += g_base64Chars[(bits >> 18) & 0x3F];
+    result += g_base64Chars[(bits >> 12) & 0x3F];
+    result += g_base64Chars[(bits >> 6) & 0x3F];
+    result += g_base64Chars[bits & 0x3F];
+  }
+  const size_t remaining = data.size() - i;
+  if(remaining)
+  {
+    uint32_t bits = uint8_t(data[i]) << 16;
+    if(remaining == 2)
+      bits |= uint8_t(data[i + 1]) << 8;
+    result += g_base64Chars[(bits >> 18) & 0x3F];
+    result += g_base64Chars[(bits >> 12) & 0x3F];
+    result += remaining == 2 ? g_base64Chars[(bits >> 6) & 0x3F] : '=';
+    result += '=';
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool decodeBase64(const char* text, size_t length, std::string& data)
+{
+  int8_t lookup[256];
+  std::memset(lookup, -1, sizeof(lookup));
+  for(int8_t i = 0; i < 64; ++i)
+  {
+    lookup[uint8_t(g_base64Chars[i])] = i;
+  }
+
+  data.clear();
+  data.reserve((length / 4) * 3);
+  uint32_t bits = 0;
+  int32_t numBits = 0;
+  for(size_t i = 0; i < length && text[i] != '='; ++i)
+  {
+    const int8_t value = lookup[uint8_t(text[i])];
+    if(value < 0)
+    {
+      return false;
+    }
+    bits = (bits << 6) | uint32_t(value);
+    numBits += 6;
+    if(numBits >= 8)
+    {
+      numBits -= 8;
+      data += char((bits >> numBits) & 0xFF);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,48 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "./Api.h"
+
+#include <string>
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  encodes binary data as base64 text, so that it can be stored in a maya string attribute
+/// \param  data the binary data to encode
+/// \return the base64 text
+/// \ingroup usdmaya
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_PUBLIC
+std::string encodeBase64(const std::string& data);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  decodes base64 text back into binary data
+/// \param  text the base64 text to decode
+/// \param  length the number of characters in text
+/// \param  data the returned binary data
+/// \return false if the text contains characters that are not valid base64
+/// \ingroup usdmaya
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_PUBLIC
+bool decodeBase64(const char* text, size_t length, std::string& data);
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
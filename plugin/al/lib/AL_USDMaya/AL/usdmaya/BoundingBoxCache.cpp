@@ -0,0 +1,234 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/BoundingBoxCache.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/base/tf/debug.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usdGeom/boundable.h"
+#include "pxr/usd/usdGeom/pointBased.h"
+#include "pxr/usd/usdGeom/xformable.h"
+
+#include <algorithm>
+
+namespace AL {
+namespace usdmaya {
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if any of the attributes that contribute to the bounds of a prim may be time varying
+bool mightBoundsBeTimeVarying(const UsdPrim& prim)
+{
+  UsdGeomXformable xformable(prim);
+  if(xformable)
+  {
+    if(xformable.TransformMightBeTimeVarying() || xformable.GetVisibilityAttr().ValueMightBeTimeVarying())
+    {
+      return true;
+    }
+  }
+
+  UsdGeomBoundable boundable(prim);
+  if(!boundable)
+  {
+    return false;
+  }
+  if(boundable.GetExtentAttr().ValueMightBeTimeVarying())
+  {
+    return true;
+  }
+
+  UsdGeomPointBased pointBased(prim);
+  if(pointBased)
+  {
+    return pointBased.GetPointsAttr().ValueMightBeTimeVarying();
+  }
+
+  // the bounds of the other boundable prims (e.g. spheres, cubes) are driven by their own schema attributes
+  for(const UsdAttribute& attribute : prim.GetAttributes())
+  {
+    if(!TfStringStartsWith(attribute.GetName().GetString(), "primvars:") && attribute.ValueMightBeTimeVarying())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool mightHierarchyBoundsBeTimeVarying(const UsdPrim& root)
+{
+  for(const UsdPrim& prim : UsdPrimRange(root, UsdTraverseInstanceProxies()))
+  {
+    if(mightBoundsBeTimeVarying(prim))
+    {
+      TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("BoundingBoxCache: bounds of %s are animated by %s\n",
+                                         root.GetPath().GetText(), prim.GetPath().GetText());
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+BoundingBoxCache::BoundingBoxCache(size_t capacity)
+  : m_entries(), m_bboxCache(UsdTimeCode::Default(), TfTokenVector(), false), m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::clear()
+{
+  m_entries.clear();
+  m_bboxCache.Clear();
+  m_rootPath = SdfPath();
+  m_state = kUnknown;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::invalidate(const UsdNotice::ObjectsChanged& notice)
+{
+  if(m_state == kUnknown)
+  {
+    return;
+  }
+
+  const UsdStageWeakPtr stage = notice.GetStage();
+  bool affected = false;
+  bool animated = false;
+  bool rescan = false;
+  auto check = [&](const SdfPath& changedPath, bool resynced)
+  {
+    const SdfPath primPath = changedPath.GetPrimPath();
+    if(primPath.HasPrefix(m_rootPath))
+    {
+      affected = true;
+      if(m_state == kStatic && !animated)
+      {
+        const UsdPrim prim = stage->GetPrimAtPath(primPath);
+        animated = prim && (resynced ? mightHierarchyBoundsBeTimeVarying(prim) : mightBoundsBeTimeVarying(prim));
+      }
+    }
+    else
+    if(m_rootPath.HasPrefix(primPath))
+    {
+      // an edit of an ancestor (e.g. its visibility) can change the bounds, and resyncing it rebuilds the hierarchy
+      affected = true;
+      rescan = rescan || resynced;
+    }
+  };
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    check(path, true);
+  }
+  for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+  {
+    check(path, false);
+  }
+
+  if(!affected)
+  {
+    return;
+  }
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("BoundingBoxCache: invalidating the bounds of %s\n", m_rootPath.GetText());
+  m_entries.clear();
+  m_bboxCache.Clear();
+  if(rescan)
+  {
+    m_state = kUnknown;
+  }
+  else
+  if(animated)
+  {
+    m_state = kAnimated;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::update(const UsdPrim& prim, const TfTokenVector& purposes)
+{
+  if(m_bboxCache.GetIncludedPurposes() != purposes)
+  {
+    m_bboxCache.SetIncludedPurposes(purposes);
+    m_entries.clear();
+  }
+
+  // the bounds of a different prim have nothing in common with the cached ones
+  if(m_state != kUnknown && prim.GetPath() != m_rootPath)
+  {
+    clear();
+  }
+
+  if(m_state == kUnknown)
+  {
+    m_rootPath = prim.GetPath();
+    m_state = mightHierarchyBoundsBeTimeVarying(prim) ? kAnimated : kStatic;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+BoundingBoxCache::Entries::iterator BoundingBoxCache::lowerBound(UsdTimeCode time)
+{
+  return std::lower_bound(m_entries.begin(), m_entries.end(), time,
+                          [](const Entry& entry, UsdTimeCode time) { return entry.time < time; });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::insert(UsdTimeCode time, const GfRange3d& bound)
+{
+  if(m_entries.size() >= m_capacity)
+  {
+    auto leastRecentlyUsed = std::min_element(m_entries.begin(), m_entries.end(),
+                                              [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+    m_entries.erase(leastRecentlyUsed);
+  }
+  m_entries.insert(lowerBound(time), Entry{ time, bound, ++m_lastUsed });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+GfRange3d BoundingBoxCache::bound(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes)
+{
+  update(prim, purposes);
+
+  // the only entry of a static hierarchy is valid at all times
+  if(m_state == kStatic && !m_entries.empty())
+  {
+    return m_entries.front().bound;
+  }
+
+  auto it = lowerBound(time);
+  if(it != m_entries.end() && it->time == time)
+  {
+    it->lastUsed = ++m_lastUsed;
+    return it->bound;
+  }
+
+  m_bboxCache.SetTime(time);
+  const GfRange3d bound = m_bboxCache.ComputeUntransformedBound(prim).ComputeAlignedBox();
+  insert(time, bound);
+  return bound;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "./Api.h"
+
+#include "pxr/pxr.h"
+#include "pxr/base/gf/range3d.h"
+#include "pxr/base/tf/token.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/usdGeom/bboxCache.h"
+
+#include <cstdint>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A bounded cache of the untransformed bounds of a prim over time.
+///
+///         The first time bounds are requested, the prim hierarchy is inspected to find out whether any of the
+///         attributes that affect the bounds are time varying. If none are, a single bound is cached and returned for
+///         all times. Otherwise the bounds are stored in an array sorted by time, which is searched with a binary
+///         search, and once the capacity of the cache is reached the least recently used bound is evicted.
+///
+///         Misses are computed with a UsdGeomBBoxCache that is kept between calls, so the bounds of the static parts
+///         of an animated hierarchy are only computed once.
+//----------------------------------------------------------------------------------------------------------------------
+class BoundingBoxCache
+{
+public:
+
+  /// \brief  ctor
+  /// \param  capacity the maximum number of bounds cached for an animated hierarchy
+  AL_USDMAYA_PUBLIC
+  explicit BoundingBoxCache(size_t capacity = 256);
+
+  /// \brief  removes all of the cached bounds, and forgets whether the hierarchy is static. This needs to be called
+  ///         whenever the stage changes (a change of prim is picked up by bound()).
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  returns the untransformed bound of the prim at the specified time, computing it if it isn't cached.
+  /// \param  prim the prim to compute the bounds of. Passing a different prim than the last call discards the cached
+  ///         bounds.
+  /// \param  time the time at which to compute the bounds
+  /// \param  purposes the purposes of the prims included in the bounds. Changing them discards the cached bounds.
+  /// \return the aligned range of the bounds
+  AL_USDMAYA_PUBLIC
+  GfRange3d bound(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes);
+
+  /// \brief  discards the cached bounds that an edit of the stage may have changed. Edits that are not below the prim
+  ///         (or to one of its ancestors) are ignored. A static hierarchy only checks the edited prims to find out
+  ///         whether they have become animated, rather than inspecting the whole hierarchy again.
+  /// \param  notice the notice sent for the edit
+  AL_USDMAYA_PUBLIC
+  void invalidate(const UsdNotice::ObjectsChanged& notice);
+
+  /// \brief  returns true if the hierarchy has been found to be static.
+  inline bool isStatic() const
+    { return m_state == kStatic; }
+
+  /// \brief  returns the number of cached bounds
+  inline size_t size() const
+    { return m_entries.size(); }
+
+  /// \brief  returns the maximum number of cached bounds
+  inline size_t capacity() const
+    { return m_capacity; }
+
+private:
+  struct Entry
+  {
+    UsdTimeCode time;
+    GfRange3d bound;
+    uint64_t lastUsed;
+  };
+  typedef std::vector<Entry> Entries;
+
+  enum State
+  {
+    kUnknown,
+    kStatic,
+    kAnimated
+  };
+
+  void update(const UsdPrim& prim, const TfTokenVector& purposes);
+  Entries::iterator lowerBound(UsdTimeCode time);
+  void insert(UsdTimeCode time, const GfRange3d& bound);
+
+  Entries m_entries;
+  UsdGeomBBoxCache m_bboxCache;
+  SdfPath m_rootPath;
+  size_t m_capacity;
+  uint64_t m_lastUsed = 0;
+  State m_state = kUnknown;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
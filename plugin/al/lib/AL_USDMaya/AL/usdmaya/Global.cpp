@@ -13,7 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include "AL/maya/utils/Utils.h"
 #include "AL/usdmaya/Global.h"
+#include "AL/usdmaya/CodeTimings.h"
 #include "AL/usdmaya/StageCache.h"
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/TypeIDs.h"
@@ -46,6 +48,7 @@
 #include "maya/MSelectionList.h"
 
 #include <iostream>
+#include <sstream>
 
 #ifndef AL_USDMAYA_LOCATION_NAME
   #define AL_USDMAYA_LOCATION_NAME "AL_USDMAYA_LOCATION"
@@ -391,6 +394,8 @@ static void postFileRead(void*)
   MFnDependencyNode fn;
   {
     std::vector<MObjectHandle>& unloadedProxies = nodes::ProxyShape::GetUnloadedProxyShapes();
+    std::vector<nodes::ProxyShape*> proxies;
+    proxies.reserve(unloadedProxies.size());
     unsigned int numUnloadedProxies = unloadedProxies.size();
     for(unsigned int i = 0; i < numUnloadedProxies; ++i)
     {
@@ -405,17 +410,32 @@ static void postFileRead(void*)
         continue;
       }
 
-      // execute a pull on each proxy shape to ensure that each one has a valid USD stage!
-      nodes::ProxyShape* proxy = (nodes::ProxyShape*)fn.userNode();
-      proxy->loadStage();
-      auto stage = proxy->getUsdStage();
+      proxies.push_back((nodes::ProxyShape*)fn.userNode());
+    }
+    unloadedProxies.clear();
+
+    // execute a pull on each proxy shape to ensure that each one has a valid USD stage! The stages are opened
+    // together, after which the Maya side of each proxy shape is restored against its open stage.
+    nodes::ProxyShape::loadStages(proxies);
+
+    AL_BEGIN_PROFILE_SECTION(RestoreProxyShapes);
+    for(nodes::ProxyShape* proxy : proxies)
+    {
       proxy->deserialiseTranslatorContext();
       proxy->findTaggedPrims();
       proxy->deserialiseTransformRefs();
       proxy->constructGLImagingEngine();
       proxy->addAttributeChangedCallback();
     }
-    unloadedProxies.clear();
+    AL_END_PROFILE_SECTION();
+
+    if(!proxies.empty() && MGlobal::kInteractive == MGlobal::mayaState())
+    {
+      std::stringstream strstr;
+      strstr << "Breakdown for " << proxies.size() << " proxy shapes" << std::endl;
+      Profiler::printReport(strstr);
+      MGlobal::displayInfo(AL::maya::utils::convert(strstr.str()));
+    }
   }
   {
     MItDependencyNodes iter(MFn::kPluginTransformNode);
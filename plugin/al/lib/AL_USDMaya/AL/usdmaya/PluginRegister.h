@@ -182,6 +182,11 @@ MStatus registerPlugin(AFnPlugin& plugin)
     MGlobal::setOptionVarValue("AL_usdmaya_pickMode", static_cast<int>(nodes::ProxyShape::PickMode::kPrims));
   }
 
+  if(!MGlobal::optionVarExists("AL_usdmaya_parallelStageLoad"))
+  {
+    MGlobal::setOptionVarValue("AL_usdmaya_parallelStageLoad", 1);
+  }
+
 
   MStatus status;
 
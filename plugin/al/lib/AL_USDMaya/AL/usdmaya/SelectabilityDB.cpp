@@ -1,13 +1,16 @@
 #include <AL/usdmaya/SelectabilityDB.h>
 
+#include <iterator>
+
 namespace AL {
 namespace usdmaya {
 
 bool SelectabilityDB::isPathUnselectable(const SdfPath& path) const
 {
-  for(SdfPath unselectablePath : m_unselectablePaths)
+  for(SdfPath ancestor = path; !ancestor.IsEmpty(); ancestor = ancestor.GetParentPath())
   {
-    if(path.HasPrefix(unselectablePath))
+    auto entry = m_unselectableIndex.find(ancestor);
+    if(entry != m_unselectableIndex.end() && entry->second)
     {
       return true;
     }
@@ -18,64 +21,104 @@ bool SelectabilityDB::isPathUnselectable(const SdfPath& path) const
 
 void SelectabilityDB::removePathsAsUnselectable(const SdfPathVector& paths)
 {
-  bool needsSort = false;
-  for(SdfPath path : paths)
+  SdfPathVector removed;
+  removed.reserve(paths.size());
+  for(const SdfPath& path : paths)
   {
-    needsSort |= removeUnselectablePath(path);
+    if(removeUnselectablePath(path))
+    {
+      removed.push_back(path);
+    }
   }
 
-  if(needsSort)
+  if(removed.empty())
   {
-    sort();
+    return;
   }
+
+  std::sort(removed.begin(), removed.end());
+  m_unselectablePaths.erase(
+      std::remove_if(m_unselectablePaths.begin(), m_unselectablePaths.end(),
+                     [&removed](const SdfPath& path) { return std::binary_search(removed.begin(), removed.end(), path); }),
+      m_unselectablePaths.end());
 }
 
 void SelectabilityDB::removePathAsUnselectable(const SdfPath& path)
 {
   if(removeUnselectablePath(path))
   {
-    sort();
+    auto foundPathEntry = std::lower_bound(m_unselectablePaths.begin(), m_unselectablePaths.end(), path);
+    if(foundPathEntry != m_unselectablePaths.end() && *foundPathEntry == path)
+    {
+      m_unselectablePaths.erase(foundPathEntry);
+    }
   }
 }
 
 void SelectabilityDB::addPathsAsUnselectable(const SdfPathVector& paths)
 {
-  bool needsSort = false;
-  for(SdfPath path : paths)
+  SdfPathVector added;
+  added.reserve(paths.size());
+  for(const SdfPath& path : paths)
   {
-    needsSort |= addUnselectablePath(path);
+    if(addUnselectablePath(path))
+    {
+      added.push_back(path);
+    }
   }
 
-  if(needsSort)
+  if(added.empty())
   {
-    sort();
+    return;
   }
+
+  // merge the new paths into the sorted list in one go, rather than sorting the whole list again.
+  std::sort(added.begin(), added.end());
+  const size_t numPaths = m_unselectablePaths.size();
+  m_unselectablePaths.insert(m_unselectablePaths.end(), added.begin(), added.end());
+  std::inplace_merge(m_unselectablePaths.begin(), m_unselectablePaths.begin() + numPaths, m_unselectablePaths.end());
 }
 
 void SelectabilityDB::addPathAsUnselectable(const SdfPath& path)
 {
   if(addUnselectablePath(path))
   {
-    sort();
+    m_unselectablePaths.insert(
+        std::lower_bound(m_unselectablePaths.begin(), m_unselectablePaths.end(), path), path);
   }
 }
 
 bool SelectabilityDB::removeUnselectablePath(const SdfPath& path)
 {
-  auto foundPathEntry = std::find(m_unselectablePaths.begin(), m_unselectablePaths.end(), path);
-  if(foundPathEntry != m_unselectablePaths.end())
+  auto entry = m_unselectableIndex.find(path);
+  if(entry == m_unselectableIndex.end() || !entry->second)
   {
-    m_unselectablePaths.erase(foundPathEntry);
-    return true;
+    return false;
   }
-  return false;
+
+  // the entry can only be dropped from the index if no other unselectable path is relying on it as an ancestor.
+  auto subtree = m_unselectableIndex.FindSubtreeRange(path);
+  if(std::next(subtree.first) == subtree.second)
+  {
+    m_unselectableIndex.erase(entry);
+  }
+  else
+  {
+    entry->second = false;
+  }
+  return true;
 }
 
 bool SelectabilityDB::addUnselectablePath(const SdfPath& path)
 {
-  if(!std::binary_search(m_unselectablePaths.begin(), m_unselectablePaths.end(), path))
+  auto inserted = m_unselectableIndex.insert(std::make_pair(path, true));
+  if(inserted.second)
+  {
+    return true;
+  }
+  if(!inserted.first->second)
   {
-    m_unselectablePaths.push_back(path);
+    inserted.first->second = true;
     return true;
   }
   return false;
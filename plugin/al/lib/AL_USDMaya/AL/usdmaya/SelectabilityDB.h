@@ -5,6 +5,7 @@
 #include "pxr/pxr.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/sdf/path.h"
+#include "pxr/usd/sdf/pathTable.h"
 #include <algorithm>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -13,7 +14,9 @@ namespace AL {
 namespace usdmaya {
 
 ///---------------------------------------------------------------------------------------------------------------------
-/// \brief  Logic that stores a sorted list of paths which represent Selectable points in the USD hierarchy
+/// \brief  Logic that stores a sorted list of paths which represent Selectable points in the USD hierarchy. The paths
+///         are also indexed in a prefix tree, so that looking up whether a path is unselectable only costs one lookup
+///         per ancestor of that path, and batches of paths can be added or removed without re-sorting the whole list.
 ///---------------------------------------------------------------------------------------------------------------------
 class SelectabilityDB {
 public:
@@ -60,12 +63,13 @@ public:
   void removePathAsUnselectable(const SdfPath& path);
 
 private:
-  inline void sort(){std::sort(m_unselectablePaths.begin(), m_unselectablePaths.end());}
   bool addUnselectablePath(const SdfPath& path);
   bool removeUnselectablePath(const SdfPath& path);
 
 private:
   SdfPathVector m_unselectablePaths;
+  /// the unselectable paths map to true, other entries only exist because they are ancestors of unselectable paths
+  SdfPathTable<bool> m_unselectableIndex;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,267 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/TransformSampleCache.h"
+#include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/utils/Utils.h"
+
+#include "pxr/base/tf/debug.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampler::init(const std::vector<UsdGeomXformOp>& xformops, const std::vector<TransformOperation>& orderedOps)
+{
+  m_ops.clear();
+  auto opIt = orderedOps.begin();
+  for(auto it = xformops.begin(), e = xformops.end(); it != e && opIt != orderedOps.end(); ++it, ++opIt)
+  {
+    switch(*opIt)
+    {
+    case kTranslate:
+    case kRotate:
+    case kScale:
+    case kShear:
+    case kTransform:
+      if(it->GetNumTimeSamples() > 1)
+      {
+        m_ops.push_back(AnimatedOp{ UsdAttributeQuery(it->GetAttr()), it->GetOpType(), *opIt,
+                                    utils::getAttributeType(it->GetTypeName()) });
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampler::init(const UsdPrim& prim)
+{
+  m_ops.clear();
+  UsdGeomXformable xformable(prim);
+  if(!xformable)
+    return;
+
+  bool resetsXformStack = false;
+  std::vector<UsdGeomXformOp> xformops = xformable.GetOrderedXformOps(&resetsXformStack);
+  std::vector<TransformOperation> orderedOps(xformops.size());
+  matchesMayaProfile(xformops.begin(), xformops.end(), orderedOps.begin());
+  init(xformops, orderedOps);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampler::sample(TransformSample& sample, UsdTimeCode time) const
+{
+  for(const AnimatedOp& op : m_ops)
+  {
+    switch(op.operation)
+    {
+    case kTranslate:
+      xformop::readVector(sample.translation, op.query, op.dataType, time);
+      break;
+
+    case kRotate:
+      xformop::readRotation(sample.rotation, op.query, op.opType, op.dataType, time);
+      break;
+
+    case kScale:
+      xformop::readVector(sample.scale, op.query, op.dataType, time);
+      break;
+
+    case kShear:
+      {
+        GfMatrix4d matrix;
+        if(xformop::readMatrix(matrix, op.query, op.dataType, time))
+        {
+          sample.shear = MVector(matrix[1][0], matrix[2][0], matrix[2][1]);
+        }
+      }
+      break;
+
+    case kTransform:
+      {
+        GfMatrix4d matrix;
+        if(xformop::readMatrix(matrix, op.query, op.dataType, time))
+        {
+          double T[3], S[3];
+          AL::usdmaya::utils::matrixToSRT(matrix, S, sample.rotation, T);
+          sample.scale = MVector(S[0], S[1], S[2]);
+          sample.translation = MVector(T[0], T[1], T[2]);
+        }
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::clear()
+{
+  m_offsets.clear();
+  m_samples.clear();
+  m_startFrame = 0;
+  m_numFrames = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TransformSampleCache::frameIndex(UsdTimeCode time, size_t& index) const
+{
+  if(time.IsDefault() || !m_numFrames)
+    return false;
+
+  // only whole frames from the start of the window are sampled
+  const double frame = time.GetValue() - m_startFrame;
+  if(frame < 0 || frame != std::floor(frame))
+    return false;
+
+  index = size_t(frame);
+  return index < m_numFrames;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TransformSampleCache::contains(UsdTimeCode time) const
+{
+  size_t index;
+  return frameIndex(time, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TransformSampleCache::lookup(const SdfPath& path, UsdTimeCode time, TransformSample& sample) const
+{
+  size_t index;
+  if(!frameIndex(time, index))
+    return false;
+
+  auto it = m_offsets.find(path);
+  if(it == m_offsets.end())
+    return false;
+
+  sample = m_samples[it->second + index];
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::prefetch(const UsdStageRefPtr& stage, const SdfPathVector& paths, double startFrame, double endFrame)
+{
+  clear();
+  if(!stage || paths.empty())
+    return;
+
+  std::vector<TransformSampler> samplers(paths.size());
+  WorkParallelForN(paths.size(), [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      UsdPrim prim = stage->GetPrimAtPath(paths[i]);
+      if(prim)
+      {
+        samplers[i].init(prim);
+      }
+    }
+  });
+
+  m_startFrame = startFrame;
+  m_numFrames = endFrame < startFrame ? 1 : size_t(std::floor(endFrame - startFrame)) + 1;
+
+  // only the prims with animated transform ops get a range of samples
+  std::vector<size_t> animated;
+  for(size_t i = 0, n = paths.size(); i < n; ++i)
+  {
+    if(!samplers[i].empty())
+    {
+      animated.push_back(i);
+    }
+  }
+  if(animated.empty())
+    return;
+
+  // shorten the window rather than exceed the sampling budget of a single cache miss
+  m_numFrames = std::max(size_t(1), std::min(m_numFrames, kMaxPrefetchSamples / animated.size()));
+  for(size_t i = 0, n = animated.size(); i < n; ++i)
+  {
+    m_offsets[paths[animated[i]]] = i * m_numFrames;
+  }
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformSampleCache::prefetch %zu transforms for frames %f to %f\n",
+                                     animated.size(), m_startFrame, m_startFrame + double(m_numFrames - 1));
+
+  m_samples.resize(animated.size() * m_numFrames);
+  WorkParallelForN(animated.size() * m_numFrames, [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      const TransformSampler& sampler = samplers[animated[i / m_numFrames]];
+      sampler.sample(m_samples[i], UsdTimeCode(m_startFrame + double(i % m_numFrames)));
+    }
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::invalidate(const UsdNotice::ObjectsChanged& notice)
+{
+  bool edited = false;
+  bool cachedPrimEdited = false;
+  if(!notice.GetResyncedPaths().empty())
+  {
+    edited = true;
+    cachedPrimEdited = true;
+    m_resyncEditCount = m_editCount + 1;
+    m_primEdits.clear();
+  }
+
+  for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+  {
+    const TfToken& name = path.GetNameToken();
+    if(!path.IsPropertyPath() || !(UsdGeomXformOp::IsXformOp(name) || name == UsdGeomTokens->xformOpOrder))
+      continue;
+
+    edited = true;
+    m_primEdits[path.GetPrimPath()] = m_editCount + 1;
+    cachedPrimEdited = cachedPrimEdited || contains(path.GetPrimPath());
+  }
+
+  if(edited)
+  {
+    ++m_editCount;
+  }
+  if(cachedPrimEdited)
+  {
+    clear();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t TransformSampleCache::editCount(const SdfPath& path) const
+{
+  auto it = m_primEdits.find(path);
+  return it == m_primEdits.end() ? m_resyncEditCount : std::max(m_resyncEditCount, it->second);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
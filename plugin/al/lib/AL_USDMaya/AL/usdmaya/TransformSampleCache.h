@@ -0,0 +1,367 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "./Api.h"
+
+#include "AL/usdmaya/TransformOperation.h"
+#include "AL/usdmaya/utils/AttributeType.h"
+
+#include "maya/MEulerRotation.h"
+#include "maya/MVector.h"
+
+#include "pxr/pxr.h"
+#include "pxr/base/gf/half.h"
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/gf/vec3h.h"
+#include "pxr/base/gf/vec3i.h"
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/usdGeom/xformOp.h"
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The animated scale, rotation, translation and shear values of a transform at a single time.
+//----------------------------------------------------------------------------------------------------------------------
+struct TransformSample
+{
+  MVector translation = MVector(0, 0, 0);
+  MEulerRotation rotation = MEulerRotation(0, 0, 0);
+  MVector scale = MVector(1.0, 1.0, 1.0);
+  MVector shear = MVector(0, 0, 0);
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Helpers that convert the value of a transform op to its Maya equivalent. The value is read from either a
+///         UsdGeomXformOp or a UsdAttributeQuery of its attribute, so that TransformationMatrix and TransformSampler
+///         share the conversions.
+//----------------------------------------------------------------------------------------------------------------------
+namespace xformop {
+
+/// \brief  reads a 3 component vector value
+/// \param  result the returned value, which is left untouched on failure
+/// \param  source the transform op, or attribute query, to read
+/// \param  dataType the data type of the attribute
+/// \param  time the time at which to read the value
+/// \return true if the value was read
+template<typename SourceType>
+bool readVector(MVector& result, const SourceType& source, utils::UsdDataType dataType, UsdTimeCode time)
+{
+  switch(dataType)
+  {
+  case utils::UsdDataType::kVec3d:
+    {
+      GfVec3d value;
+      if(!source.Get(&value, time))
+        return false;
+      result = MVector(value[0], value[1], value[2]);
+    }
+    break;
+
+  case utils::UsdDataType::kVec3f:
+    {
+      GfVec3f value;
+      if(!source.Get(&value, time))
+        return false;
+      result = MVector(double(value[0]), double(value[1]), double(value[2]));
+    }
+    break;
+
+  case utils::UsdDataType::kVec3h:
+    {
+      GfVec3h value;
+      if(!source.Get(&value, time))
+        return false;
+      result = MVector(double(value[0]), double(value[1]), double(value[2]));
+    }
+    break;
+
+  case utils::UsdDataType::kVec3i:
+    {
+      GfVec3i value;
+      if(!source.Get(&value, time))
+        return false;
+      result = MVector(double(value[0]), double(value[1]), double(value[2]));
+    }
+    break;
+
+  default:
+    return false;
+  }
+  return true;
+}
+
+/// \brief  reads a scalar value
+/// \param  result the returned value, which is left untouched on failure
+/// \param  source the transform op, or attribute query, to read
+/// \param  dataType the data type of the attribute
+/// \param  time the time at which to read the value
+/// \return true if the value was read
+template<typename SourceType>
+bool readDouble(double& result, const SourceType& source, utils::UsdDataType dataType, UsdTimeCode time)
+{
+  switch(dataType)
+  {
+  case utils::UsdDataType::kHalf:
+    {
+      GfHalf value;
+      if(!source.Get(&value, time))
+        return false;
+      result = float(value);
+    }
+    break;
+
+  case utils::UsdDataType::kFloat:
+    {
+      float value;
+      if(!source.Get(&value, time))
+        return false;
+      result = double(value);
+    }
+    break;
+
+  case utils::UsdDataType::kDouble:
+    {
+      double value;
+      if(!source.Get(&value, time))
+        return false;
+      result = value;
+    }
+    break;
+
+  case utils::UsdDataType::kInt:
+    {
+      int32_t value;
+      if(!source.Get(&value, time))
+        return false;
+      result = double(value);
+    }
+    break;
+
+  default:
+    return false;
+  }
+  return true;
+}
+
+/// \brief  reads the value of a rotate op, and converts it from degrees to an euler rotation in radians. A single
+///         axis rotation that cannot be read is returned as a zero rotation.
+/// \param  result the returned value, which is left untouched if a 3 axis rotation cannot be read
+/// \param  source the transform op, or attribute query, to read
+/// \param  opType the type of the rotate op
+/// \param  dataType the data type of the attribute
+/// \param  time the time at which to read the value
+/// \return false if the op is not a rotation, or a 3 axis rotation could not be read
+template<typename SourceType>
+bool readRotation(MEulerRotation& result, const SourceType& source, UsdGeomXformOp::Type opType,
+                  utils::UsdDataType dataType, UsdTimeCode time)
+{
+  const double degToRad = 3.141592654 / 180.0;
+  MEulerRotation::RotationOrder order = MEulerRotation::kXYZ;
+  switch(opType)
+  {
+  case UsdGeomXformOp::TypeRotateX:
+  case UsdGeomXformOp::TypeRotateY:
+  case UsdGeomXformOp::TypeRotateZ:
+    {
+      double angle = 0;
+      readDouble(angle, source, dataType, time);
+      angle *= degToRad;
+      result = MEulerRotation(opType == UsdGeomXformOp::TypeRotateX ? angle : 0.0,
+                              opType == UsdGeomXformOp::TypeRotateY ? angle : 0.0,
+                              opType == UsdGeomXformOp::TypeRotateZ ? angle : 0.0,
+                              MEulerRotation::kXYZ);
+    }
+    return true;
+
+  case UsdGeomXformOp::TypeRotateXYZ: order = MEulerRotation::kXYZ; break;
+  case UsdGeomXformOp::TypeRotateXZY: order = MEulerRotation::kXZY; break;
+  case UsdGeomXformOp::TypeRotateYXZ: order = MEulerRotation::kYXZ; break;
+  case UsdGeomXformOp::TypeRotateYZX: order = MEulerRotation::kYZX; break;
+  case UsdGeomXformOp::TypeRotateZXY: order = MEulerRotation::kZXY; break;
+  case UsdGeomXformOp::TypeRotateZYX: order = MEulerRotation::kZYX; break;
+  default:
+    return false;
+  }
+
+  MVector v;
+  if(!readVector(v, source, dataType, time))
+    return false;
+  result = MEulerRotation(v.x * degToRad, v.y * degToRad, v.z * degToRad, order);
+  return true;
+}
+
+/// \brief  reads a matrix value
+/// \param  result the returned value, which is left untouched on failure
+/// \param  source the transform op, or attribute query, to read
+/// \param  dataType the data type of the attribute
+/// \param  time the time at which to read the value
+/// \return true if the value was read
+template<typename SourceType>
+bool readMatrix(GfMatrix4d& result, const SourceType& source, utils::UsdDataType dataType, UsdTimeCode time)
+{
+  return dataType == utils::UsdDataType::kMatrix4d && source.Get(&result, time);
+}
+
+} // xformop
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Reads the animated transform ops of a prim through UsdAttributeQuery objects, so that the value resolution
+///         of each op is only performed once, rather than every time the values are read.
+///
+///         Only the translate, rotate, scale, shear and transform ops that have more than one time sample are
+///         sampled, which matches the components that TransformationMatrix::updateToTime refreshes.
+//----------------------------------------------------------------------------------------------------------------------
+class TransformSampler
+{
+public:
+
+  /// \brief  builds the attribute queries of the animated transform ops
+  /// \param  xformops the ordered transform ops of the prim
+  /// \param  orderedOps the type of each of the transform ops, as returned by matchesMayaProfile
+  AL_USDMAYA_PUBLIC
+  void init(const std::vector<UsdGeomXformOp>& xformops, const std::vector<TransformOperation>& orderedOps);
+
+  /// \brief  builds the attribute queries of the animated transform ops of the specified prim
+  /// \param  prim the prim to sample
+  AL_USDMAYA_PUBLIC
+  void init(const UsdPrim& prim);
+
+  /// \brief  removes all of the attribute queries
+  inline void clear()
+    { m_ops.clear(); }
+
+  /// \brief  returns true if the prim has no animated transform ops
+  inline bool empty() const
+    { return m_ops.empty(); }
+
+  /// \brief  reads the values of the animated transform ops at the specified time. The components of the sample that
+  ///         are not animated, or that cannot be read, are left untouched.
+  /// \param  sample the returned values
+  /// \param  time the time at which to read the values
+  AL_USDMAYA_PUBLIC
+  void sample(TransformSample& sample, UsdTimeCode time) const;
+
+private:
+  struct AnimatedOp
+  {
+    UsdAttributeQuery query;
+    UsdGeomXformOp::Type opType;
+    TransformOperation operation;
+    utils::UsdDataType dataType;
+  };
+  std::vector<AnimatedOp> m_ops;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A cache of the animated transform values of a set of prims for a window of frames, which is shared by all
+///         of the transforms of a proxy shape.
+///
+///         The values of all of the prims for all of the frames in the window are sampled in one parallel pass, after
+///         which reading the values of a transform at a frame within the window is a lookup into an array. Times that
+///         fall between frames, or outside of the window, are not cached.
+///
+///         The cache also counts the edits made to the transform ops of the stage, so that the transforms know when
+///         the attribute queries of their own TransformSampler need to be rebuilt.
+//----------------------------------------------------------------------------------------------------------------------
+class TransformSampleCache
+{
+public:
+
+  /// \brief  the maximum number of samples taken by a single call to prefetch. The window of frames is shortened
+  ///         when sampling all of the animated prims for all of the requested frames would exceed it.
+  static constexpr size_t kMaxPrefetchSamples = 1 << 17;
+
+  /// \brief  removes all of the cached samples
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  samples the animated transforms of the specified prims for every frame from startFrame to endFrame in
+  ///         parallel, replacing the previously cached samples. Prims without animated transform ops are not cached.
+  ///         The window is shortened, to as little as a single frame, so that no more than kMaxPrefetchSamples samples
+  ///         are taken.
+  /// \param  stage the stage that contains the prims
+  /// \param  paths the paths of the prims to sample
+  /// \param  startFrame the first frame to sample
+  /// \param  endFrame the last frame to sample
+  AL_USDMAYA_PUBLIC
+  void prefetch(const UsdStageRefPtr& stage, const SdfPathVector& paths, double startFrame, double endFrame);
+
+  /// \brief  records the edits of the notice that may change the transform values of a prim, and removes all of the
+  ///         cached samples if any of the cached prims are affected.
+  /// \param  notice the notice sent by the stage the samples were read from
+  AL_USDMAYA_PUBLIC
+  void invalidate(const UsdNotice::ObjectsChanged& notice);
+
+  /// \brief  returns a value that changes every time the transform ops of the specified prim may have been edited.
+  ///         Attribute queries built for the prim are stale once it differs from the value at the time they were built.
+  /// \param  path the path of the prim
+  AL_USDMAYA_PUBLIC
+  size_t editCount(const SdfPath& path) const;
+
+  /// \brief  returns true if the specified time is one of the frames of the cached window
+  /// \param  time the time to query
+  AL_USDMAYA_PUBLIC
+  bool contains(UsdTimeCode time) const;
+
+  /// \brief  returns true if the samples of the specified prim are cached
+  /// \param  path the path of the prim to query
+  inline bool contains(const SdfPath& path) const
+    { return m_offsets.find(path) != m_offsets.end(); }
+
+  /// \brief  retrieves the cached values of a prim at the specified time
+  /// \param  path the path of the prim
+  /// \param  time the time at which to retrieve the values
+  /// \param  sample the returned values
+  /// \return true if the values are cached, false if they need to be read from the prim
+  AL_USDMAYA_PUBLIC
+  bool lookup(const SdfPath& path, UsdTimeCode time, TransformSample& sample) const;
+
+  /// \brief  returns the number of prims in the cache
+  inline size_t size() const
+    { return m_offsets.size(); }
+
+private:
+  bool frameIndex(UsdTimeCode time, size_t& index) const;
+
+  TfHashMap<SdfPath, size_t, SdfPath::Hash> m_offsets;
+  std::vector<TransformSample> m_samples;
+  double m_startFrame = 0;
+  size_t m_numFrames = 0;
+
+  // the number of notices with transform edits, the notice that last resynced the stage, and the notice that last
+  // edited the transform ops of each prim
+  TfHashMap<SdfPath, size_t, SdfPath::Hash> m_primEdits;
+  size_t m_editCount = 0;
+  size_t m_resyncEditCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -845,6 +845,10 @@ MSyntax EventQuery::createSyntax()
   syntax.addFlag("-h", "-help");
   syntax.addFlag("-e", "-eventId");
   syntax.addFlag("-p", "-parentId");
+  syntax.addFlag("-tc", "-triggerCount");
+  syntax.addFlag("-dt", "-dispatchTime");
+  syntax.addFlag("-mdt", "-maxDispatchTime");
+  syntax.addFlag("-rs", "-resetStatistics");
   syntax.addArg(MSyntax::kString);
   syntax.useSelectionAsDefault(false);
   syntax.setObjectType(MSyntax::kSelectionList, 0, 1);
@@ -909,6 +913,26 @@ MStatus EventQuery::doIt(const MArgList& args)
         setResult(eventId);
       }
       else
+      if(database.isFlagSet("-tc"))
+      {
+        setResult(int(dispatcher->triggerCount()));
+      }
+      else
+      if(database.isFlagSet("-dt"))
+      {
+        setResult(dispatcher->totalDispatchTime());
+      }
+      else
+      if(database.isFlagSet("-mdt"))
+      {
+        setResult(dispatcher->maxDispatchTime());
+      }
+      else
+      if(database.isFlagSet("-rs"))
+      {
+        dispatcher->resetStatistics();
+      }
+      else
       {
         MGlobal::displayError("AL_usdmaya_EventQuery: no flag specified");
         return MS::kFailure;
@@ -1137,6 +1161,27 @@ Parent Events
 const char* const EventQuery::g_helpText =  R"(
     AL_usdmaya_EventQuery Overview:
 
+    Given the name of an event (and optionally the node that owns it), this command can return some information
+    about that event. e.g.
+
+      // returns the ID of the event
+      AL_usdmaya_EventQuery -eventId "PreStageLoaded" "AL_usdmaya_ProxyShape1";
+
+      // returns the 2 integer ID of the callback that triggers the event (if any)
+      AL_usdmaya_EventQuery -parentId "PreStageLoaded" "AL_usdmaya_ProxyShape1";
+
+      // returns the number of times the event has been triggered
+      AL_usdmaya_EventQuery -triggerCount "PreStageLoaded" "AL_usdmaya_ProxyShape1";
+
+      // returns the total time (in seconds) spent running the callbacks of the event
+      AL_usdmaya_EventQuery -dispatchTime "PreStageLoaded" "AL_usdmaya_ProxyShape1";
+
+      // returns the longest time (in seconds) spent running the callbacks for a single trigger of the event
+      AL_usdmaya_EventQuery -maxDispatchTime "PreStageLoaded" "AL_usdmaya_ProxyShape1";
+
+      // resets the trigger count and dispatch times of the event
+      AL_usdmaya_EventQuery -resetStatistics "PreStageLoaded" "AL_usdmaya_ProxyShape1";
+
 )";
 
 //----------------------------------------------------------------------------------------------------------------------
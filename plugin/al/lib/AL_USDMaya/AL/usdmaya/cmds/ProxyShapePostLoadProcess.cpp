@@ -44,6 +44,7 @@
 #include "maya/MObjectHandle.h"
 
 #include <pxr/base/tf/type.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/base/vt/dictionary.h>
 #include <pxr/usd/kind/registry.h>
 #include <pxr/usd/usd/modelAPI.h>
@@ -278,11 +279,32 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
                                           " will read default values\n");
     }
 
-    auto it = objsToCreate.begin();
-    const auto end = objsToCreate.end();
-    for(; it != end; ++it)
+    std::vector<fileio::translators::TranslatorRefPtr> translators(objsToCreate.size());
+    for(size_t i = 0, n = objsToCreate.size(); i < n; ++i)
     {
-      UsdPrim prim = *it;
+      translators[i] = translatorManufacture.get(objsToCreate[i].GetTypeName());
+    }
+
+    // Let the translators read what they need from the stage up front. Nothing is imported (and so nothing edits the
+    // stage) until all of the reads are done, so they can happen in parallel, leaving only the Maya work to be done
+    // serially below.
+    AL_BEGIN_PROFILE_SECTION(PreImportPrims);
+    WorkParallelForN(objsToCreate.size(), [&objsToCreate, &translators, &param](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const fileio::translators::TranslatorRefPtr& translator = translators[i];
+        if(translator && (param.forceTranslatorImport() || translator->importableByDefault()))
+        {
+          translator->preImport(objsToCreate[i]);
+        }
+      }
+    });
+    AL_END_PROFILE_SECTION();
+
+    for(size_t i = 0, n = objsToCreate.size(); i < n; ++i)
+    {
+      UsdPrim prim = objsToCreate[i];
       bool parentUnmerged = parentNodeIsUnmerged(prim);
       MObject object;
       if (parentUnmerged)
@@ -294,7 +316,7 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
         object = proxy->findRequiredPath(prim.GetPath());
       }
 
-      fileio::translators::TranslatorRefPtr translator = translatorManufacture.get(prim.GetTypeName());
+      const fileio::translators::TranslatorRefPtr& translator = translators[i];
 
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims prim=%s\n", prim.GetPath().GetText());
 
@@ -490,6 +512,21 @@ MStatus ProxyShapePostLoadProcess::initialise(nodes::ProxyShape* ptrNode)
   // now perform any post-creation fix up
   connectSchemaPrims(ptrNode, schemaPrims);
 
+  // record the composition of the imported prims, so that a later variant switch only re-translates the prims that
+  // it actually affects
+  std::vector<size_t> compositionHashes(schemaPrims.size());
+  WorkParallelForN(schemaPrims.size(), [&schemaPrims, &compositionHashes](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      compositionHashes[i] = fileio::translators::TranslatorContext::computeCompositionHash(schemaPrims[i]);
+    }
+  });
+  for(size_t i = 0, n = schemaPrims.size(); i < n; ++i)
+  {
+    ptrNode->context()->setCompositionHashForPath(schemaPrims[i].GetPath(), compositionHashes[i]);
+  }
+
   return MS::kSuccess;
 }
 
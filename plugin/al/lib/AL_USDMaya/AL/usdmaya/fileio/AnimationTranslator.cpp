@@ -28,6 +28,7 @@
 #include "maya/MGlobal.h"
 #include "maya/MFnMesh.h"
 #include "maya/MAnimUtil.h"
+#include "maya/MFnNumericAttribute.h"
 #include "maya/MNodeClass.h"
 
 namespace AL {
@@ -44,6 +45,202 @@ const static std::array<MFn::Type, 4> g_nodeTypesConsiderToBeAnimation {
 //----------------------------------------------------------------------------------------------------------------------
 const static AnimationCheckTransformAttributes g_AnimationCheckTransformAttributes;
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+inline void readPlugColumnValue(const MPlug* plugs, T& value)
+{
+  plugs[0].getValue(value);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline void readPlugColumnValue(const MPlug* plugs, GfVec3f& value)
+{
+  plugs[0].getValue(value[0]);
+  plugs[1].getValue(value[1]);
+  plugs[2].getValue(value[2]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline void readPlugColumnValue(const MPlug* plugs, GfVec3d& value)
+{
+  plugs[0].getValue(value[0]);
+  plugs[1].getValue(value[1]);
+  plugs[2].getValue(value[2]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+inline void scalePlugColumnValue(T& value, const float scale)
+{
+  value *= scale;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline void scalePlugColumnValue(bool&, const float)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline void scalePlugColumnValue(int32_t&, const float)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if the value was written to the attribute, or false if it was filtered out
+template<typename T>
+bool setFilteredSample(const UsdAttribute& attribute, const T& value, const UsdTimeCode& timeCode,
+                       AnimationTranslator::SampleFilter<T>& filter)
+{
+  if(filter.m_hasLastValue && value == filter.m_lastValue)
+  {
+    // hold on to the time, so that the end of the run can be written if the value changes again.
+    filter.m_heldTime = timeCode.GetValue();
+    filter.m_isHeld = true;
+    return false;
+  }
+
+  if(filter.m_isHeld)
+  {
+    attribute.Set(filter.m_lastValue, UsdTimeCode(filter.m_heldTime));
+    filter.m_isHeld = false;
+  }
+  attribute.Set(value, timeCode);
+  filter.m_lastValue = value;
+  filter.m_hasLastValue = true;
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// filters a sample that has already been written by a method that doesn't hand back the value it wrote (such as
+/// DgNodeTranslator::copyAttributeValue), by reading the sample back and clearing it if it repeats the last value.
+void filterWrittenSample(const UsdAttribute& attribute, const UsdTimeCode& timeCode,
+                         AnimationTranslator::SampleFilter<VtValue>& filter)
+{
+  VtValue value;
+  if(!attribute.Get(&value, timeCode))
+    return;
+
+  if(filter.m_hasLastValue && value == filter.m_lastValue)
+  {
+    attribute.ClearAtTime(timeCode);
+    filter.m_heldTime = timeCode.GetValue();
+    filter.m_isHeld = true;
+    return;
+  }
+
+  if(filter.m_isHeld)
+  {
+    attribute.Set(filter.m_lastValue, UsdTimeCode(filter.m_heldTime));
+    filter.m_isHeld = false;
+  }
+  filter.m_lastValue.Swap(value);
+  filter.m_hasLastValue = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// removes the duplicate samples of all the authored attributes of a prim once the whole frame range has been written.
+/// This is only used for the attributes written by custom translators, since their values and attributes aren't known
+/// to the animation translator.
+void filterPrimSamples(const UsdPrim& prim)
+{
+  std::vector<double> timeSamples;
+  std::vector<double> dupSamples;
+  for(const UsdAttribute& attr : prim.GetAuthoredAttributes())
+  {
+    timeSamples.clear();
+    dupSamples.clear();
+    attr.GetTimeSamples(&timeSamples);
+    VtValue prevSampleBlob;
+    for(const double sample : timeSamples)
+    {
+      VtValue currSampleBlob;
+      attr.Get(&currSampleBlob, sample);
+      if(prevSampleBlob == currSampleBlob)
+      {
+        dupSamples.emplace_back(sample);
+      }
+      else
+      {
+        prevSampleBlob = currSampleBlob;
+        // only clear samples between constant segment
+        if(dupSamples.size() > 1)
+        {
+          dupSamples.pop_back();
+          for(const double dup : dupSamples)
+          {
+            attr.ClearAtTime(dup);
+          }
+        }
+        dupSamples.clear();
+      }
+    }
+    for(const double dup : dupSamples)
+    {
+      attr.ClearAtTime(dup);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename Column>
+void appendToPlugColumn(Column& column, const MPlug& plug, const UsdAttribute& attribute, const float scale, const uint32_t numComponents)
+{
+  if(numComponents == 1)
+  {
+    column.m_plugs.push_back(plug);
+  }
+  else
+  {
+    for(uint32_t i = 0; i < numComponents; ++i)
+      column.m_plugs.push_back(plug.child(i));
+  }
+  column.m_attributes.push_back(attribute);
+  column.m_scales.push_back(scale);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, uint32_t numComponents, typename Column>
+void exportPlugColumn(Column& column, const UsdTimeCode& timeCode, const bool filterSamples)
+{
+  const size_t count = column.m_attributes.size();
+  column.m_values.resize(count);
+
+  // pull all of the values out of maya first, so that the DG evaluation isn't interleaved with the layer edits
+  const MPlug* plugs = column.m_plugs.data();
+  const float* scales = column.m_scales.data();
+  for(size_t i = 0; i < count; ++i, plugs += numComponents)
+  {
+    T value;
+    readPlugColumnValue(plugs, value);
+    if(scales[i] != 1.0f)
+    {
+      scalePlugColumnValue(value, scales[i]);
+    }
+    column.m_values[i] = value;
+  }
+
+  if(filterSamples)
+  {
+    column.m_filters.resize(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+      setFilteredSample(column.m_attributes[i], column.m_values[i], timeCode, column.m_filters[i]);
+    }
+  }
+  else
+  {
+    for(size_t i = 0; i < count; ++i)
+    {
+      const T value = column.m_values[i];
+      column.m_attributes[i].Set(value, timeCode);
+    }
+  }
+}
+
+} // anon
+
 //----------------------------------------------------------------------------------------------------------------------
 bool AnimationTranslator::considerToBeAnimation(const MFn::Type nodeType)
 {
@@ -272,45 +469,266 @@ void AnimationTranslator::exportAnimation(const ExporterParams& params)
      (startMesh != endMesh) ||
      (!m_animatedNodes.empty()))
   {
+    m_filterSamples = params.m_filterSample;
+    compilePlugColumns();
+    m_untypedFilters.assign(m_filterSamples ? m_untypedPlugs.size() : 0, SampleFilter<VtValue>());
+    m_untypedScaledFilters.assign(m_filterSamples ? m_untypedScaledPlugs.size() : 0, SampleFilter<VtValue>());
+    m_transformFilters.assign(m_filterSamples ? m_animatedTransformPlugs.size() : 0, SampleFilter<VtValue>());
+    initialiseMeshContexts();
+
     double increment = 1.0 / std::max(1U, params.m_subSamples);
     for(double t = params.m_minFrame, e = params.m_maxFrame + 1e-3f; t < e; t += increment)
     {
       MAnimControl::setCurrentTime(t);
       UsdTimeCode timeCode(t);
-      for(auto it = startAttrib; it != endAttrib; ++it)
+      exportPlugColumns(timeCode);
+      for(size_t i = 0, n = m_untypedPlugs.size(); i < n; ++i)
       {
         /// \todo This feels wrong. Split the DgNodeTranslator class into 3 ...
         ///         maya::Dg
         ///         usdmaya::Dg
         ///         usdmaya::fileio::translator::Dg
-        translators::DgNodeTranslator::copyAttributeValue(it->first, it->second, timeCode);
+        auto& it = m_untypedPlugs[i];
+        translators::DgNodeTranslator::copyAttributeValue(it.first, it.second, timeCode);
+        if(m_filterSamples)
+          filterWrittenSample(it.second, timeCode, m_untypedFilters[i]);
       }
-      for(auto it = startAttribScaled; it != endAttribScaled; ++it)
+      for(size_t i = 0, n = m_untypedScaledPlugs.size(); i < n; ++i)
       {
         /// \todo This feels wrong. Split the DgNodeTranslator class into 3 ...
         ///         maya::Dg
         ///         usdmaya::Dg
         ///         usdmaya::fileio::translator::Dg
-        translators::DgNodeTranslator::copyAttributeValue(it->first, it->second.attr, it->second.scale, timeCode);
+        auto& it = m_untypedScaledPlugs[i];
+        translators::DgNodeTranslator::copyAttributeValue(it.first, it.second.attr, it.second.scale, timeCode);
+        if(m_filterSamples)
+          filterWrittenSample(it.second.attr, timeCode, m_untypedScaledFilters[i]);
       }
-      for (auto it = startTransformAttrib; it != endTransformAttrib; ++it)
+      size_t transformIndex = 0;
+      for (auto it = startTransformAttrib; it != endTransformAttrib; ++it, ++transformIndex)
       {
         translators::TransformTranslator::copyAttributeValue(it->first, it->second, timeCode);
+        if(m_filterSamples)
+          filterWrittenSample(it->second, timeCode, m_transformFilters[transformIndex]);
       }
-      for(auto it = startMesh; it != endMesh; ++it)
-      {
-        UsdGeomMesh mesh(it->second.GetPrim());
-        AL::usdmaya::utils::MeshExportContext context(it->first, mesh, timeCode);
-        context.copyVertexData(timeCode);
-      }
+      exportMeshContexts(timeCode);
       for(auto nodeAnim : m_animatedNodes)
       {
         nodeAnim.m_translator->exportCustomAnim(nodeAnim.m_path, nodeAnim.m_prim, timeCode);
       }
     }
+
+    // the attributes written by custom translators are filtered once all of their samples have been written
+    if(m_filterSamples)
+    {
+      for(const auto& nodeAnim : m_animatedNodes)
+      {
+        filterPrimSamples(nodeAnim.m_prim);
+      }
+    }
+
+    m_meshContexts.clear();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AnimationTranslator::initialiseMeshContexts()
+{
+  m_meshContexts.clear();
+  m_meshPointsBufferReuses = 0;
+  m_meshContexts.reserve(m_animatedMeshes.size());
+  for(const auto& it : m_animatedMeshes)
+  {
+    std::unique_ptr<MeshContext> context(new MeshContext);
+    context->m_path = it.first;
+    MStatus status = context->m_fnMesh.setObject(it.first);
+    AL_MAYA_CHECK_ERROR2(status, MString("unable to attach function set to mesh") + it.first.fullPathName());
+    if(status && it.second)
+    {
+      context->m_pointsAttr = it.second;
+      m_meshContexts.push_back(std::move(context));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AnimationTranslator::exportMeshContexts(const UsdTimeCode& timeCode)
+{
+  for(auto& it : m_meshContexts)
+  {
+    MeshContext& context = *it;
+    // Everything a MeshExportContext would rebuild here (the function set, and the face counts and connects arrays)
+    // is topology that the points sample doesn't need, so only the points buffer is kept in the context.
+    MStatus status;
+    const uint32_t numVertices = context.m_fnMesh.numVertices();
+    const float* pointsData = context.m_fnMesh.getRawPoints(&status);
+    if(status)
+    {
+      // The layer keeps hold of the array of each sample that is written, so the buffer can only be filled again if
+      // the last sample was filtered out. Otherwise a new buffer is created, rather than copying the shared one.
+      if(context.m_pointsWritten)
+      {
+        context.m_points = VtArray<GfVec3f>(numVertices);
+        context.m_pointsWritten = false;
+      }
+      else
+      if(context.m_points.size() != numVertices)
+      {
+        context.m_points.resize(numVertices);
+      }
+      else
+      {
+        ++m_meshPointsBufferReuses;
+      }
+
+      memcpy((GfVec3f*)context.m_points.data(), pointsData, sizeof(float) * 3 * numVertices);
+      if(m_filterSamples)
+      {
+        context.m_pointsWritten = setFilteredSample(context.m_pointsAttr, context.m_points, timeCode,
+                                                    context.m_pointsFilter);
+      }
+      else
+      {
+        context.m_pointsAttr.Set(context.m_points, timeCode);
+        context.m_pointsWritten = true;
+      }
+    }
+    else
+    {
+      MGlobal::displayError(MString("Unable to access mesh vertices on mesh: ") + context.m_path.fullPathName());
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AnimationTranslator::compilePlugColumns()
+{
+  m_floatColumn.clear();
+  m_doubleColumn.clear();
+  m_intColumn.clear();
+  m_boolColumn.clear();
+  m_vec3fColumn.clear();
+  m_vec3dColumn.clear();
+  m_untypedPlugs.clear();
+  m_untypedScaledPlugs.clear();
+
+  for(const auto& it : m_animatedPlugs)
+  {
+    if(!addToPlugColumn(it.first, it.second, 1.0f, false))
+      m_untypedPlugs.emplace_back(it.first, it.second);
+  }
+  for(const auto& it : m_scaledAnimatedPlugs)
+  {
+    if(!addToPlugColumn(it.first, it.second.attr, it.second.scale, true))
+      m_untypedScaledPlugs.emplace_back(it.first, it.second);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool AnimationTranslator::addToPlugColumn(const MPlug& plug, const UsdAttribute& attribute, const float scale, const bool scaled)
+{
+  // this mirrors the types handled by DgNodeTranslator::copyAttributeValue, restricted to the common non-array cases.
+  if(plug.isArray())
+    return false;
+
+  const usdmaya::utils::UsdDataType usdType = usdmaya::utils::getAttributeType(attribute);
+  const MObject attributeObject = plug.attribute();
+  bool isSimpleValue = false;
+  switch(attributeObject.apiType())
+  {
+  case MFn::kAttribute3Double:
+  case MFn::kAttribute3Float:
+  case MFn::kAttribute3Long:
+  case MFn::kAttribute3Short:
+    switch(usdType)
+    {
+    case usdmaya::utils::UsdDataType::kVec3f:
+      appendToPlugColumn(m_vec3fColumn, plug, attribute, scale, 3);
+      return true;
+    case usdmaya::utils::UsdDataType::kVec3d:
+      appendToPlugColumn(m_vec3dColumn, plug, attribute, scale, 3);
+      return true;
+    default:
+      return false;
+    }
+
+  case MFn::kNumericAttribute:
+    {
+      MFnNumericAttribute fn(attributeObject);
+      switch(fn.unitType())
+      {
+      case MFnNumericData::kBoolean:
+        if(scaled || usdType != usdmaya::utils::UsdDataType::kBool)
+          return false;
+        appendToPlugColumn(m_boolColumn, plug, attribute, 1.0f, 1);
+        return true;
+
+      case MFnNumericData::kFloat:
+      case MFnNumericData::kDouble:
+      case MFnNumericData::kInt:
+      case MFnNumericData::kShort:
+      case MFnNumericData::kInt64:
+      case MFnNumericData::kByte:
+      case MFnNumericData::kChar:
+        isSimpleValue = true;
+        break;
+
+      default:
+        return false;
+      }
+    }
+    break;
+
+  case MFn::kTimeAttribute:
+  case MFn::kFloatAngleAttribute:
+  case MFn::kDoubleAngleAttribute:
+  case MFn::kDoubleLinearAttribute:
+  case MFn::kFloatLinearAttribute:
+    isSimpleValue = true;
+    break;
+
+  case MFn::kEnumAttribute:
+    if(scaled || usdType != usdmaya::utils::UsdDataType::kInt)
+      return false;
+    appendToPlugColumn(m_intColumn, plug, attribute, 1.0f, 1);
+    return true;
+
+  default:
+    return false;
+  }
+
+  if(!isSimpleValue)
+    return false;
+
+  switch(usdType)
+  {
+  case usdmaya::utils::UsdDataType::kFloat:
+    appendToPlugColumn(m_floatColumn, plug, attribute, scale, 1);
+    return true;
+  case usdmaya::utils::UsdDataType::kDouble:
+    appendToPlugColumn(m_doubleColumn, plug, attribute, scale, 1);
+    return true;
+  case usdmaya::utils::UsdDataType::kInt:
+    if(scaled)
+      return false;
+    appendToPlugColumn(m_intColumn, plug, attribute, 1.0f, 1);
+    return true;
+  default:
+    return false;
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void AnimationTranslator::exportPlugColumns(const UsdTimeCode& timeCode)
+{
+  exportPlugColumn<float, 1>(m_floatColumn, timeCode, m_filterSamples);
+  exportPlugColumn<double, 1>(m_doubleColumn, timeCode, m_filterSamples);
+  exportPlugColumn<int32_t, 1>(m_intColumn, timeCode, m_filterSamples);
+  exportPlugColumn<bool, 1>(m_boolColumn, timeCode, m_filterSamples);
+  exportPlugColumn<GfVec3f, 3>(m_vec3fColumn, timeCode, m_filterSamples);
+  exportPlugColumn<GfVec3d, 3>(m_vec3dColumn, timeCode, m_filterSamples);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 AnimationCheckTransformAttributes::AnimationCheckTransformAttributes()
 {
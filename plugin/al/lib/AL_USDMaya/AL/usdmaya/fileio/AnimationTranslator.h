@@ -20,6 +20,7 @@
 #include "AL/usdmaya/fileio/translators/DgNodeTranslator.h"
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 
+#include "maya/MFnMesh.h"
 #include "maya/MPlug.h"
 #include "maya/MString.h"
 #include "maya/MDagPath.h"
@@ -28,10 +29,14 @@
 #include <vector>
 #include <array>
 #include <map>
+#include <memory>
 
 #include <utility>
 
 #include "pxr/pxr.h"
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/vt/array.h"
 #include "pxr/usd/usd/stage.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -214,10 +219,51 @@ public:
   inline void addCustomAnimNode(translators::TranslatorBase* translator, MDagPath dagPath, UsdPrim usdPrim)
     { m_animatedNodes.push_back({translator, dagPath, usdPrim}); }
 
+  /// \brief  returns the number of mesh point samples read by the last call to exportAnimation into the buffer of the
+  ///         previous sample, because that sample was filtered out rather than kept by the layer.
+  inline size_t meshPointsBufferReuses() const
+    { return m_meshPointsBufferReuses; }
+
+  /// \brief  the state of duplicate sample filtering for an attribute. When filtering, a sample is only written if
+  ///         its value differs from the previous one. Only the first and last sample of each run of identical values
+  ///         are written, and only the first sample of a run that is still held at the end of the frame range.
+  template<typename T>
+  struct SampleFilter
+  {
+    T m_lastValue; ///< the last value seen for the attribute
+    double m_heldTime = 0.0; ///< the time of the last sample matching m_lastValue, if m_isHeld is true
+    bool m_hasLastValue = false; ///< false until the first sample of the attribute has been written
+    bool m_isHeld = false; ///< true if samples matching m_lastValue have been skipped since it was written
+  };
+
 private:
   static bool considerToBeAnimation(const MFn::Type nodeType);
   static bool inheritTransform(const MDagPath &path);
   static bool areTransformAttributesConnected(const MDagPath &path);
+
+  /// \brief  sorts the animated plugs into typed columns, so that the type of each plug only has to be determined
+  ///         once, rather than on every frame. Plugs that can't be placed in a column are exported with the generic
+  ///         DgNodeTranslator::copyAttributeValue methods.
+  void compilePlugColumns();
+
+  /// \brief  creates the persistent export contexts for the animated meshes
+  void initialiseMeshContexts();
+
+  /// \brief  writes the points of all animated meshes at the given time
+  /// \param  timeCode the time at which to write the samples
+  void exportMeshContexts(const UsdTimeCode& timeCode);
+
+  /// \brief  reads the current values of all the plugs in the typed columns, and writes them to their attributes
+  /// \param  timeCode the time at which to write the samples
+  void exportPlugColumns(const UsdTimeCode& timeCode);
+
+  /// \brief  adds the plug to the typed column matching its maya and usd types
+  /// \param  plug the maya plug to export
+  /// \param  attribute the usd attribute to write the values into
+  /// \param  scale the scale to apply to the values
+  /// \param  scaled true if the plug was added with a unit scale
+  /// \return false if there is no typed column for this type of plug
+  bool addToPlugColumn(const MPlug& plug, const UsdAttribute& attribute, float scale, bool scaled);
 private:
   struct NodeExportInfo
   {
@@ -225,6 +271,47 @@ private:
     MDagPath m_path;
     UsdPrim m_prim;
   };
+
+  /// \brief  a contiguous column of animated plugs which all read a maya value of the same type, and write it to
+  ///         usd attributes of type T.
+  template<typename T, uint32_t numComponents = 1>
+  struct PlugColumn
+  {
+    std::vector<MPlug> m_plugs; ///< the plugs to read (or for vector types, the child plugs of each compound)
+    std::vector<UsdAttribute> m_attributes; ///< the attributes to write into
+    std::vector<float> m_scales; ///< the unit scale to apply to each value
+    std::vector<T> m_values; ///< the values read for the current frame
+    std::vector<SampleFilter<T>> m_filters; ///< the duplicate sample filtering state of each attribute
+
+    inline void clear()
+      { m_plugs.clear(); m_attributes.clear(); m_scales.clear(); m_values.clear(); m_filters.clear(); }
+  };
+
+  /// \brief  the export state of an animated mesh which is kept for the whole frame range
+  struct MeshContext
+  {
+    MDagPath m_path; ///< the path to the maya mesh
+    MFnMesh m_fnMesh; ///< the function set attached to the mesh
+    UsdAttribute m_pointsAttr; ///< the points attribute to write into
+    SampleFilter<VtArray<GfVec3f>> m_pointsFilter; ///< the duplicate sample filtering state of the points
+    VtArray<GfVec3f> m_points; ///< the buffer the points of the current frame are read into
+    bool m_pointsWritten = false; ///< true if m_points was written to the layer, which keeps hold of it
+  };
+
+  std::vector<std::unique_ptr<MeshContext>> m_meshContexts;
+  size_t m_meshPointsBufferReuses = 0;
+  bool m_filterSamples = false;
+  PlugColumn<float> m_floatColumn;
+  PlugColumn<double> m_doubleColumn;
+  PlugColumn<int32_t> m_intColumn;
+  PlugColumn<bool> m_boolColumn;
+  PlugColumn<GfVec3f, 3> m_vec3fColumn;
+  PlugColumn<GfVec3d, 3> m_vec3dColumn;
+  std::vector<std::pair<MPlug, UsdAttribute>> m_untypedPlugs;
+  std::vector<std::pair<MPlug, ScaledPair>> m_untypedScaledPlugs;
+  std::vector<SampleFilter<VtValue>> m_untypedFilters; ///< the duplicate sample filtering state of m_untypedPlugs
+  std::vector<SampleFilter<VtValue>> m_untypedScaledFilters; ///< the filtering state of m_untypedScaledPlugs
+  std::vector<SampleFilter<VtValue>> m_transformFilters; ///< the filtering state of m_animatedTransformPlugs
   std::vector<NodeExportInfo> m_animatedNodes;
   PlugAttrVector m_animatedPlugs;
   PlugAttrScaledVector m_scaledAnimatedPlugs;
@@ -249,57 +249,9 @@ struct Export::Impl
     }
   }
 
-  void filterSample()
-  {
-    std::vector<double> timeSamples;
-    std::vector<double> dupSamples;
-    for (auto prim : m_stage->Traverse())
-    {
-      std::vector<UsdAttribute> attributes = prim.GetAuthoredAttributes();
-      for (auto attr : attributes)
-      {
-        timeSamples.clear();
-        dupSamples.clear();
-        attr.GetTimeSamples(&timeSamples);
-        VtValue prevSampleBlob;
-        for (auto sample : timeSamples)
-        {
-          VtValue currSampleBlob;
-          attr.Get(&currSampleBlob, sample);
-          if (prevSampleBlob == currSampleBlob)
-          {
-            dupSamples.emplace_back(sample);
-          }
-          else
-          {
-            prevSampleBlob = currSampleBlob;
-            // only clear samples between constant segment
-            if (dupSamples.size() > 1)
-            {
-              dupSamples.pop_back();
-              for (auto dup : dupSamples)
-              {
-                attr.ClearAtTime(dup);
-              }
-            }
-            dupSamples.clear();
-          }
-        }
-        for (auto dup : dupSamples)
-        {
-          attr.ClearAtTime(dup);
-        }
-      }
-    }
-  }
-
-  void doExport(const char* const filename, bool toFilter = false, SdfPath defaultPrim = SdfPath())
+  void doExport(const char* const filename, SdfPath defaultPrim = SdfPath())
   {
     setDefaultPrimIfOnlyOneRoot(defaultPrim);
-    if (toFilter)
-    {
-      filterSample();
-    }
     m_stage->GetRootLayer()->Save();
     m_nodeMap.clear();
   }
@@ -979,7 +931,7 @@ void Export::doExport()
   }
 
   m_impl->processInstances();
-  m_impl->doExport(m_params.m_fileName.asChar(), m_params.m_filterSample, defaultPrim);
+  m_impl->doExport(m_params.m_fileName.asChar(), defaultPrim);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
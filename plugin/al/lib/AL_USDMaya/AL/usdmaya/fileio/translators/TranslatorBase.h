@@ -108,6 +108,15 @@ public:
   virtual MStatus initialize()
     { return MS::kSuccess; }
 
+  /// \brief  Optionally override this method to read the data import() needs from a prim ahead of time. When a set
+  ///         of prims is imported, this is called for all of them before any of them are imported, from several
+  ///         threads at once, so it must only read from the stage and must not touch Maya. Anything it keeps should
+  ///         be thread safe to store, and is consumed by the call to import() that follows for the same prim.
+  /// \param  prim the usd prim that is about to be imported into maya
+  /// \return MS::kSuccess if all ok
+  virtual MStatus preImport(const UsdPrim& prim)
+    { return MS::kSuccess; }
+
   /// \brief  Override this method to import a prim into your scene.
   /// \param  prim the usd prim to be imported into maya
   /// \param  parent a handle to an MObject that represents an AL_usd_Transform node. You should parent your DAG
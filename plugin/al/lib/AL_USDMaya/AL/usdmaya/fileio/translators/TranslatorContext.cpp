@@ -15,10 +15,23 @@
 //
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
+#include "AL/usdmaya/Base64.h"
 #include "AL/usdmaya/DebugCodes.h"
 #include "maya/MSelectionList.h"
 #include "maya/MFnDagNode.h"
 
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/base/tf/hashset.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/primSpec.h"
+
+#include <boost/functional/hash.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+
 namespace AL {
 namespace usdmaya {
 namespace fileio {
@@ -40,11 +53,12 @@ UsdStageRefPtr TranslatorContext::getUsdStage() const
 void TranslatorContext::validatePrims()
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALIDATE PRIMS **\n");
-  for(auto it : m_primMapping)
+  for(const auto& it : m_primMapping)
   {
-    if(it.objectHandle().isValid() && it.objectHandle().isAlive())
+    const PrimLookup& lookup = it.second;
+    if(lookup.isValid() && lookup.objectHandle().isValid() && lookup.objectHandle().isAlive())
     {
-      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALID HANDLE DETECTED %s **\n", it.path().GetText());
+      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALID HANDLE DETECTED %s **\n", lookup.path().GetText());
     }
   }
 }
@@ -53,8 +67,8 @@ void TranslatorContext::validatePrims()
 bool TranslatorContext::getTransform(const SdfPath& path, MObjectHandle& object)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTransform %s\n", path.GetText());
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  PrimLookup* it = find(path);
+  if(it)
   {
     if(!it->objectHandle().isValid())
     {
@@ -71,25 +85,41 @@ bool TranslatorContext::getTransform(const SdfPath& path, MObjectHandle& object)
 void TranslatorContext::updatePrimTypes()
 {
   auto stage = m_proxyShape->usdStage();
-  for(auto it = m_primMapping.begin(); it != m_primMapping.end(); )
+  SdfPathVector removedPaths;
+  for(auto& it : m_primMapping)
   {
-    SdfPath path(it->path());
-    UsdPrim prim = stage->GetPrimAtPath(path);
+    PrimLookup& lookup = it.second;
+    if(!lookup.isValid())
+      continue;
+    UsdPrim prim = stage->GetPrimAtPath(lookup.path());
     if(!prim)
     {
-      it = m_primMapping.erase(it);
+      removedPaths.push_back(lookup.path());
     }
     else
-    if(it->type() != prim.GetTypeName())
+    if(lookup.type() != prim.GetTypeName())
     {
-      it->type() = prim.GetTypeName();
-      ++it;
-    }
-    else
-    {
-      ++it;
+      lookup.type() = prim.GetTypeName();
     }
   }
+  for(const SdfPath& path : removedPaths)
+  {
+    erase(path);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t TranslatorContext::computeCompositionHash(const UsdPrim& prim)
+{
+  size_t hash = 0;
+  boost::hash_combine(hash, prim.GetTypeName());
+  for(const SdfPrimSpecHandle& spec : prim.GetPrimStack())
+  {
+    boost::hash_combine(hash, spec->GetLayer()->GetIdentifier());
+    boost::hash_combine(hash, spec->GetPath());
+  }
+  // zero is reserved for prims whose composition is unknown
+  return hash ? hash : 1;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -97,8 +127,8 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObject '%s' \n", path.GetText());
 
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  PrimLookup* it = find(path);
+  if(it)
   {
     const MTypeId zero(0);
     if(zero != typeId)
@@ -141,8 +171,8 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObject '%s' \n", path.GetText());
 
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  PrimLookup* it = find(path);
+  if(it)
   {
     const MTypeId zero(0);
     if(MFn::kInvalid != type)
@@ -183,8 +213,8 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& returned)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObjects: %s\n", path.GetText());
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  PrimLookup* it = find(path);
+  if(it)
   {
     returned = it->createdNodes();
     return true;
@@ -196,11 +226,7 @@ bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& ret
 void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
-  auto iter = findLocation(prim.GetPath());
-  if(iter == m_primMapping.end() || iter->path() != prim.GetPath())
-  {
-    iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), prim.GetTypeName(), object.object()));
-  }
+  PrimLookup* iter = &findOrInsert(prim.GetPath(), prim.GetTypeName(), object.object());
 
   if(object.object() == MObject::kNullObj)
   {
@@ -213,14 +239,51 @@ void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
+TranslatorContext::PrimLookup& TranslatorContext::findOrInsert(const SdfPath& path, const TfToken& type, const MObject& object)
 {
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
-  auto iter = findLocation(prim.GetPath());
-  if(iter == m_primMapping.end() || iter->path() != prim.GetPath())
+  // inserting a path into the table also inserts (invalid) entries for its ancestors
+  PrimLookup& lookup = m_primMapping[path];
+  if(!lookup.isValid())
   {
-    iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), prim.GetTypeName(), object.object()));
+    lookup = PrimLookup(path, type, object);
+  }
+  return lookup;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::erase(const SdfPath& path)
+{
+  // erasing an entry from the table would erase all of its descendants too, so entries that still have descendants
+  // are only reset to an invalid lookup. Ancestors that are left without any descendants are pruned.
+  SdfPath current = path;
+  bool first = true;
+  while(!current.IsEmpty())
+  {
+    PrimLookups::iterator it = m_primMapping.find(current);
+    if(it == m_primMapping.end() || (!first && it->second.isValid()))
+    {
+      break;
+    }
+    auto range = m_primMapping.FindSubtreeRange(current);
+    if(std::next(range.first) != range.second)
+    {
+      if(first)
+      {
+        it->second = PrimLookup();
+      }
+      break;
+    }
+    m_primMapping.erase(it);
+    current = current.GetParentPath();
+    first = false;
   }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
+  PrimLookup* iter = &findOrInsert(prim.GetPath(), prim.GetTypeName(), object.object());
   iter->createdNodes().push_back(object);
 
   if(object.object() == MObject::kNullObj)
@@ -238,8 +301,8 @@ void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
 void TranslatorContext::removeItems(const SdfPath& path)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems remove under primPath=%s\n", path.GetText());
-  auto it = find(path);
-  if(it != m_primMapping.end() && it->path() == path)
+  PrimLookup* it = find(path);
+  if(it)
   {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems removing path=%s\n", it->path().GetText());
     MDGModifier modifier1;
@@ -309,7 +372,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
       status = modifier2.doIt();
       AL_MAYA_CHECK_ERROR2(status, "failed to delete dag nodes");
     }
-    m_primMapping.erase(it);
+    erase(path);
   }
   validatePrims();
 }
@@ -328,6 +391,119 @@ MString getNodeName(MObject obj)
   return fn.name();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+namespace {
+
+// The binary format starts with this tag, followed by the format version, which lets deserialise tell it apart from the
+// older text format (which always starts with a prim path).
+const char* const g_binaryTag = "ALTC";
+const uint32_t g_binaryVersion = 1;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  writes unsigned integers as variable length (7 bits per byte) values, and strings prefixed by their length
+struct BinaryWriter
+{
+  void writeUInt(uint64_t value)
+  {
+    while(value >= 0x80)
+    {
+      m_data += char((value & 0x7F) | 0x80);
+      value >>= 7;
+    }
+    m_data += char(value);
+  }
+
+  void writeString(const std::string& value)
+  {
+    writeUInt(value.size());
+    m_data += value;
+  }
+
+  std::string m_data;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  reads the values written by the BinaryWriter. Once a read runs past the end of the data, all following
+///         reads fail.
+struct BinaryReader
+{
+  BinaryReader(const std::string& data)
+    : m_data(data), m_offset(0), m_valid(true) {}
+
+  bool readUInt(uint64_t& value)
+  {
+    value = 0;
+    for(uint32_t shift = 0; m_valid && shift < 64; shift += 7)
+    {
+      if(m_offset >= m_data.size())
+        break;
+      const uint8_t byte = uint8_t(m_data[m_offset++]);
+      value |= uint64_t(byte & 0x7F) << shift;
+      if(!(byte & 0x80))
+        return true;
+    }
+    m_valid = false;
+    return false;
+  }
+
+  bool readString(std::string& value)
+  {
+    uint64_t length;
+    if(!readUInt(length) || length > m_data.size() - m_offset)
+    {
+      m_valid = false;
+      return false;
+    }
+    value.assign(m_data, m_offset, length);
+    m_offset += length;
+    return true;
+  }
+
+  const std::string& m_data;
+  size_t m_offset;
+  bool m_valid;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  assigns consecutive indices to unique strings, in the order they are first seen
+struct StringTable
+{
+  uint64_t index(const std::string& value)
+  {
+    auto inserted = m_indices.insert(std::make_pair(value, m_strings.size()));
+    if(inserted.second)
+    {
+      m_strings.push_back(value);
+    }
+    return inserted.first->second;
+  }
+
+  TfHashMap<std::string, uint64_t, TfHash> m_indices;
+  std::vector<std::string> m_strings;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  resolves the maya nodes from their names, reusing a single selection list. Names that cannot be found are
+///         resolved to null objects.
+void resolveNodes(const std::vector<std::string>& names, std::vector<MObject>& nodes)
+{
+  nodes.assign(names.size(), MObject::kNullObj);
+
+  MSelectionList sl;
+  for(size_t i = 0, n = names.size(); i < n; ++i)
+  {
+    if(names[i].empty())
+      continue;
+    sl.clear();
+    if(sl.add(names[i].c_str()))
+    {
+      sl.getDependNode(0, nodes[i]);
+    }
+  }
+}
+
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MString TranslatorContext::serialise() const
 {
@@ -340,24 +516,183 @@ MString TranslatorContext::serialise() const
 
   m_proxyShape->excludedTranslatedGeometryPlug().setString(MString(oss.str().c_str()));
 
-  oss.str("");
-  oss.clear();
+  // The node names and prim types are stored once in a table, and the prim mappings refer to them by index. An index
+  // of zero is used for null nodes, so the node indices are offset by one.
+  StringTable nodeNames;
+  StringTable typeNames;
+  BinaryWriter entries;
+  uint64_t numEntries = 0;
+  for(const auto& it : m_primMapping)
+  {
+    const PrimLookup& lookup = it.second;
+    if(!lookup.isValid())
+      continue;
+
+    entries.writeString(lookup.path().GetString());
+    entries.writeUInt(typeNames.index(lookup.type().GetString()));
+    entries.writeUInt(lookup.object().isNull() ? 0 : nodeNames.index(getNodeName(lookup.object()).asChar()) + 1);
+    entries.writeUInt(lookup.createdNodes().size());
+    for(const MObjectHandle& node : lookup.createdNodes())
+    {
+      entries.writeUInt(node.object().isNull() ? 0 : nodeNames.index(getNodeName(node.object()).asChar()) + 1);
+    }
+    ++numEntries;
+  }
+
+  BinaryWriter writer;
+  writer.m_data.reserve(entries.m_data.size() + 16);
+  writer.writeUInt(nodeNames.m_strings.size());
+  for(const std::string& name : nodeNames.m_strings)
+  {
+    writer.writeString(name);
+  }
+  writer.writeUInt(typeNames.m_strings.size());
+  for(const std::string& name : typeNames.m_strings)
+  {
+    writer.writeString(name);
+  }
+  writer.writeUInt(numEntries);
+  writer.m_data += entries.m_data;
+
+  std::string result = g_binaryTag;
+  result += std::to_string(g_binaryVersion);
+  result += ':';
+  result += encodeBase64(writer.m_data);
+  return MString(result.c_str(), int(result.size()));
+}
 
-  for(auto it : m_primMapping)
+//----------------------------------------------------------------------------------------------------------------------
+std::string TranslatorContext::describe() const
+{
+  std::ostringstream oss;
+  oss << m_primMapping.size() << " prims\n";
+  for(const auto& it : m_primMapping)
   {
-    oss << it.path() << "=" << it.type().GetText() << ",";
-    oss << getNodeName(it.object());
-    for(uint32_t i = 0; i < it.createdNodes().size(); ++i)
+    const PrimLookup& lookup = it.second;
+    oss << "  " << lookup.path().GetString() << " (" << lookup.type().GetString() << ") ";
+    oss << (lookup.object().isNull() ? "<null>" : getNodeName(lookup.object()).asChar());
+    for(const MObjectHandle& node : lookup.createdNodes())
     {
-      oss << "," << getNodeName(it.createdNodes()[i].object());
+      oss << ", " << (node.object().isNull() ? "<null>" : getNodeName(node.object()).asChar());
     }
-    oss << ";";
+    oss << "\n";
   }
-  return MString(oss.str().c_str());
+  return oss.str();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void TranslatorContext::deserialise(const MString& string)
+{
+  const size_t tagLength = std::strlen(g_binaryTag);
+  if(std::strncmp(string.asChar(), g_binaryTag, tagLength) == 0)
+  {
+    const char* const version = string.asChar() + tagLength;
+    const char* const separator = std::strchr(version, ':');
+    if(!separator || std::strtoul(version, nullptr, 10) != g_binaryVersion)
+    {
+      MGlobal::displayError("TranslatorContext::deserialise unsupported translator context version");
+    }
+    else
+    {
+      std::string data;
+      if(!decodeBase64(separator + 1, string.length() - (separator + 1 - string.asChar()), data) ||
+         !deserialiseBinary(data))
+      {
+        MGlobal::displayError("TranslatorContext::deserialise the translator context data is corrupt");
+      }
+    }
+  }
+  else
+  if(string.length())
+  {
+    deserialiseText(string);
+  }
+
+  SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(m_proxyShape->excludedTranslatedGeometryPlug().asString());
+  m_excludedGeometry.insert(vec.begin(), vec.end());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TranslatorContext::deserialiseBinary(const std::string& data)
+{
+  BinaryReader reader(data);
+
+  // every string takes at least one byte, so a count larger than the data is corrupt
+  uint64_t count = 0;
+  std::vector<std::string> nodeNames;
+  if(!reader.readUInt(count) || count > data.size())
+    return false;
+  nodeNames.resize(count);
+  for(std::string& name : nodeNames)
+  {
+    if(!reader.readString(name))
+      return false;
+  }
+
+  std::vector<TfToken> typeNames;
+  if(!reader.readUInt(count) || count > data.size())
+    return false;
+  typeNames.reserve(count);
+  std::string name;
+  for(uint64_t i = 0; i < count; ++i)
+  {
+    if(!reader.readString(name))
+      return false;
+    typeNames.push_back(TfToken(name));
+  }
+
+  uint64_t numEntries = 0;
+  if(!reader.readUInt(numEntries) || numEntries > data.size())
+    return false;
+
+  // read all of the entries before touching the prim mappings, so that corrupt data leaves them as they were
+  struct Entry
+  {
+    SdfPath path;
+    uint64_t typeIndex;
+    uint64_t objectIndex;
+    std::vector<uint64_t> createdNodeIndices;
+  };
+  std::vector<Entry> entries(numEntries);
+  std::string path;
+  for(Entry& entry : entries)
+  {
+    uint64_t numCreatedNodes;
+    if(!reader.readString(path) || !reader.readUInt(entry.typeIndex) || !reader.readUInt(entry.objectIndex) ||
+       !reader.readUInt(numCreatedNodes) || entry.typeIndex >= typeNames.size() || numCreatedNodes > data.size())
+    {
+      return false;
+    }
+    entry.path = SdfPath(path);
+    entry.createdNodeIndices.resize(numCreatedNodes);
+    for(uint64_t& index : entry.createdNodeIndices)
+    {
+      if(!reader.readUInt(index))
+        return false;
+    }
+  }
+
+  std::vector<MObject> nodes;
+  resolveNodes(nodeNames, nodes);
+  auto getNode = [&nodes] (uint64_t index)
+  {
+    return index && index <= nodes.size() ? nodes[index - 1] : MObject::kNullObj;
+  };
+
+  for(const Entry& entry : entries)
+  {
+    PrimLookup& lookup = m_primMapping[entry.path];
+    lookup = PrimLookup(entry.path, typeNames[entry.typeIndex], getNode(entry.objectIndex));
+    for(uint64_t index : entry.createdNodeIndices)
+    {
+      lookup.createdNodes().push_back(getNode(index));
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::deserialiseText(const MString& string)
 {
   MStringArray strings;
   string.split(';', strings);
@@ -377,7 +712,9 @@ void TranslatorContext::deserialise(const MString& string)
       sl.getDependNode(0, obj);
     }
 
-    PrimLookup lookup(SdfPath(strings2[0].asChar()), TfToken(strings3[0].asChar()), obj);
+    SdfPath path(strings2[0].asChar());
+    PrimLookup& lookup = m_primMapping[path];
+    lookup = PrimLookup(path, TfToken(strings3[0].asChar()), obj);
 
     for(uint32_t j = 2; j < strings3.length(); ++j)
     {
@@ -387,12 +724,7 @@ void TranslatorContext::deserialise(const MString& string)
       sl.getDependNode(0, obj);
       lookup.createdNodes().push_back(obj);
     }
-
-    m_primMapping.push_back(lookup);
   }
-
-  SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(m_proxyShape->excludedTranslatedGeometryPlug().asString());
-  m_excludedGeometry.insert(vec.begin(), vec.end());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -400,34 +732,31 @@ void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& i
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry primPath=%s\n", primPath.GetText());
 
-  PrimLookups::iterator end = m_primMapping.end();
-  PrimLookups::iterator range_begin = std::lower_bound(m_primMapping.begin(), end, primPath, value_compare());
-  PrimLookups::iterator range_end = range_begin;
-  for(; range_end != end; ++range_end)
+  // the prims below primPath occupy a contiguous range of the table, in which parents precede their children
+  SdfPathVector subtreePaths;
+  auto range = m_primMapping.FindSubtreeRange(primPath);
+  for(auto it = range.first; it != range.second; ++it)
   {
-    // due to the joys of sorting, any child prims of this prim being destroyed should appear next to each
-    // other (one would assume); So if compare does not find a match (the value is something other than zero),
-    // we are no longer in the same prim root
-    const SdfPath& childPath = range_end->path();
-
-    if(!childPath.HasPrefix(primPath))
+    if(it->second.isValid())
     {
-      break;
+      subtreePaths.push_back(it->first);
     }
   }
 
   auto stage = m_proxyShape->usdStage();
 
+  // preRemoveEntry is often called several times before the items are removed, so skip the paths that are already
+  // queued up for removal.
+  TfHashSet<SdfPath, SdfPath::Hash> queuedPaths(itemsToRemove.begin(), itemsToRemove.end());
+
   // run the preTearDown stage on each prim. We will walk over the prims in the reverse order here (which will guarentee
   // the the itemsToRemove will be ordered such that the child prims will be destroyed before their parents).
-  auto iter = range_end;
-  itemsToRemove.reserve(itemsToRemove.size() + range_end - range_begin);
-  while(iter != range_begin)
+  itemsToRemove.reserve(itemsToRemove.size() + subtreePaths.size());
+  for(auto iter = subtreePaths.rbegin(); iter != subtreePaths.rend(); ++iter)
   {
-    --iter;
-    PrimLookup& node = *iter;
+    const SdfPath& path = *iter;
 
-    if(std::find(itemsToRemove.begin(), itemsToRemove.end(), node.path()) != itemsToRemove.end())
+    if(!queuedPaths.insert(path).second)
     {
       // Same exact path has already been processed and added to the list of itemsToRemove.
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry skipping path thats already in "
@@ -435,16 +764,14 @@ void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& i
     }
     else
     {
-      itemsToRemove.push_back(node.path());
-      auto prim = stage->GetPrimAtPath(node.path());
+      itemsToRemove.push_back(path);
+      auto prim = stage->GetPrimAtPath(path);
       if (prim && callPreUnload)
       {
-        preUnloadPrim(prim, node.object());
+        preUnloadPrim(prim, find(path)->object());
       }
     }
   }
-
-
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -461,20 +788,20 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
   while(iter != itemsToRemove.end())
   {
     auto path = *iter;
-    auto node = std::lower_bound(m_primMapping.begin(), m_primMapping.end(), path, value_compare());
+    PrimLookup* node = find(path);
     bool isInTransformChain = isPrimInTransformChain(path);
 
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeEntries removing: %s\n", iter->GetText());
-    if(node->objectHandle().isValid() && node->objectHandle().isAlive())
+    if(node && node->objectHandle().isValid() && node->objectHandle().isAlive())
     {
       unloadPrim(path, node->object());
     }
 
     // The item might already have been removed by a translator...
-    if(node != m_primMapping.end() && node->path() == path)
+    if(find(path))
     {
       // remove nodes from map
-      m_primMapping.erase(node);
+      erase(path);
     }
 
     if(isInTransformChain)
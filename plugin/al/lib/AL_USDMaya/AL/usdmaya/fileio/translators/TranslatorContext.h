@@ -27,6 +27,7 @@
 #include "pxr/pxr.h"
 #include "pxr/base/tf/refPtr.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/sdf/pathTable.h"
 #include "pxr/base/tf/debug.h"
 #include "AL/usdmaya/DebugCodes.h"
 
@@ -203,10 +204,10 @@ public:
   /// \return the type name for that prim
   TfToken getTypeForPath(SdfPath path) const
   {
-    const auto it = find(path);
-    if(it != m_primMapping.end())
+    const PrimLookup* lookup = find(path);
+    if(lookup)
     {
-      return it->type();
+      return lookup->type();
     }
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTypeForPath did not find item in mapping.%s\n", path.GetText());
     return TfToken();
@@ -217,6 +218,36 @@ public:
   AL_USDMAYA_PUBLIC
   void updatePrimTypes();
 
+  /// \brief  computes a hash of the composition of a prim, i.e. of the layers and paths of the specs that contribute
+  ///         opinions to it. Switching a variant changes the specs that contribute to the prims inside of the variant,
+  ///         but leaves the hash of the other prims unchanged.
+  /// \param  prim the prim to compute the hash of
+  /// \return the hash of the composition of the prim. This is never zero.
+  AL_USDMAYA_PUBLIC
+  static size_t computeCompositionHash(const UsdPrim& prim);
+
+  /// \brief  given a path to a prim, return the hash of its composition at the time it was last translated
+  /// \param  path the prim path of a prim that was imported via a custom translator plug-in
+  /// \return the composition hash recorded for the prim, or zero if it is unknown
+  size_t getCompositionHashForPath(const SdfPath& path) const
+  {
+    const PrimLookup* lookup = find(path);
+    return lookup ? lookup->compositionHash() : 0;
+  }
+
+  /// \brief  records the hash of the composition of a prim that has been translated, so that it is possible to
+  ///         find out whether it has been affected by a later variant switch
+  /// \param  path the prim path of a prim that was imported via a custom translator plug-in
+  /// \param  hash the composition hash of the prim, as returned by computeCompositionHash
+  void setCompositionHashForPath(const SdfPath& path, size_t hash)
+  {
+    PrimLookup* lookup = find(path);
+    if(lookup)
+    {
+      lookup->setCompositionHash(hash);
+    }
+  }
+
   /// \brief  Internal method.
   ///         If within your custom translator plug-in you need to create any maya nodes, associate that maya
   ///         node with the prim path by calling this method
@@ -225,16 +256,27 @@ public:
   AL_USDMAYA_PUBLIC
   void registerItem(const UsdPrim& prim, MObjectHandle object);
    
-  /// \brief  serialises the content of the translator context to a text string.
+  /// \brief  serialises the content of the translator context to a string. The prim mappings are written in a compact,
+  ///         versioned binary format (stored as base64 text so that it can live in a string attribute), in which every
+  ///         maya node name and prim type is only written once.
   /// \return the translator context serialised into a string
   AL_USDMAYA_PUBLIC
   MString serialise() const;
 
-  /// \brief  deserialises the string back into the translator context
+  /// \brief  deserialises the string back into the translator context. Both the binary format written by serialise,
+  ///         and the older text format, are accepted. Binary data that is corrupt, or written by an unknown version,
+  ///         is reported as an error and leaves the prim mappings untouched. Each unique maya node name is only
+  ///         resolved once.
   /// \param  string the string to deserialised
   AL_USDMAYA_PUBLIC
   void deserialise(const MString& string);
 
+  /// \brief  debugging utility that lists the prim mappings in a readable form, one prim per line. Unlike serialise,
+  ///         this leaves the proxy shape untouched.
+  /// \return the prim path, type, maya node and created nodes of every prim in the translator context
+  AL_USDMAYA_PUBLIC
+  std::string describe() const;
+
   /// \brief  debugging utility to help keep track of prims during a variant switch
   AL_USDMAYA_PUBLIC
   void validatePrims();
@@ -246,10 +288,10 @@ public:
   /// \return true if an entry is found that matches, false otherwise
   bool hasEntry(const SdfPath& path, const TfToken& type)
   {
-    auto it = find(path);
-    if(it != m_primMapping.end())
+    const PrimLookup* lookup = find(path);
+    if(lookup)
     {
-      return type == it->type();
+      return type == lookup->type();
     }
     return false;
   }
@@ -280,6 +322,10 @@ public:
     PrimLookup(const SdfPath& path, const TfToken& type, MObject mayaObj)
       : m_path(path), m_type(type), m_object(mayaObj), m_createdNodes() {}
 
+    /// \brief  default ctor, used for the entries of the ancestors of the tracked prims in the prim mapping.
+    PrimLookup()
+      : m_path(), m_type(), m_object(), m_createdNodes() {}
+
     /// \brief  dtor
     ~PrimLookup() {}
 
@@ -288,6 +334,11 @@ public:
     const SdfPath& path() const
       { return m_path; }
 
+    /// \brief  returns true if this lookup tracks a prim, false if it is a placeholder for the ancestor of one
+    /// \return true if this lookup tracks a prim
+    bool isValid() const
+      { return !m_path.IsEmpty(); }
+
     /// \brief  get the maya object of the node
     /// \return the maya node for this reference
     MObjectHandle objectHandle() const
@@ -313,15 +364,27 @@ public:
     const MObjectHandleArray& createdNodes() const
       { return m_createdNodes; }
 
+    /// \brief  get the hash of the composition of the prim when it was last translated
+    /// \return the composition hash, or zero if it is unknown
+    size_t compositionHash() const
+      { return m_compositionHash; }
+
+    /// \brief  set the hash of the composition of the prim
+    /// \param  hash the composition hash
+    void setCompositionHash(size_t hash)
+      { m_compositionHash = hash; }
+
   private:
     SdfPath m_path;
     TfToken m_type;
     MObjectHandle m_object;
     MObjectHandleArray m_createdNodes;
+    size_t m_compositionHash = 0;
   };
 
-  /// a sorted array of prim mappings
-  typedef std::vector<PrimLookup> PrimLookups;
+  /// a hashed table of prim mappings. The table also holds entries for the ancestors of the tracked prims (for which
+  /// PrimLookup::isValid returns false), which keeps the prims below a given path in a contiguous range.
+  typedef SdfPathTable<PrimLookup> PrimLookups;
 
   /// comparison utility (for sorting array of pointers to node references based on their path)
   struct value_compare
@@ -412,37 +475,34 @@ private:
   /// \return true if the prim maps to a MObject inside the Maya Dag tree.
   bool isPrimInTransformChain(const SdfPath& path);
 
-  inline PrimLookups::iterator find(const SdfPath& path)
+  inline PrimLookup* find(const SdfPath& path)
   {
-    PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    if(it != end)
+    PrimLookups::iterator it = m_primMapping.find(path);
+    if(it != m_primMapping.end() && it->second.isValid())
     {
-      if(it->path() == path)
-        return it;
+      return &it->second;
     }
-    return end;
+    return nullptr;
   }
 
-  inline PrimLookups::const_iterator find(const SdfPath& path) const
+  inline const PrimLookup* find(const SdfPath& path) const
   {
-    PrimLookups::const_iterator end = m_primMapping.end();
-    PrimLookups::const_iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    if(it != end)
+    PrimLookups::const_iterator it = m_primMapping.find(path);
+    if(it != m_primMapping.end() && it->second.isValid())
     {
-      if(it->path() == path)
-        return it;
+      return &it->second;
     }
-    return end;
+    return nullptr;
   }
 
-  inline PrimLookups::iterator findLocation(const SdfPath& path)
-  {
-    PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    return it;
-  }
+  /// \brief  returns the lookup for the path, creating it if it does not exist yet.
+  PrimLookup& findOrInsert(const SdfPath& path, const TfToken& type, const MObject& object);
+
+  /// \brief  removes the lookup for the path, leaving the lookups of its descendants untouched.
+  void erase(const SdfPath& path);
 
+  bool deserialiseBinary(const std::string& data);
+  void deserialiseText(const MString& string);
 
   TranslatorContext(nodes::ProxyShape* proxyShape)
     : m_proxyShape(proxyShape), m_primMapping()
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include "AL/usdmaya/Base64.h"
 #include "AL/usdmaya/TypeIDs.h"
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
@@ -20,6 +21,10 @@
 #include "AL/maya/utils/Utils.h"
 #include "AL/maya/utils/MayaHelperMacros.h"
 
+#include "pxr/base/arch/fileSystem.h"
+#include "pxr/base/tf/iterator.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/sdf/fileFormat.h"
 #include "pxr/usd/sdf/textFileFormat.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
@@ -39,6 +44,9 @@
 #include <boost/thread.hpp>
 #include <boost/thread/shared_lock_guard.hpp>
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <mutex>
 
 namespace {
@@ -108,6 +116,71 @@ namespace {
     }
     return dgmod.doIt();
   }
+
+  // Serialised layers in the binary format start with this line, followed by the base64 encoded usdc data. Text layers
+  // always start with a '#usda' or '#sdf' header, so the two cannot be confused.
+  const char* const g_binaryLayerTag = "#usdc-base64\n";
+
+  // Reads the whole of a (binary) file into a string
+  bool readFile(const std::string& path, std::string& data)
+  {
+    std::ifstream ifs(path, std::ios::binary);
+    if(!ifs)
+    {
+      return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    return true;
+  }
+
+  // Serialises a layer into a string that can be stored in a maya string attribute. The usdc file format can only be
+  // written to disk, so in the binary case the layer is exported to a temporary file which is then encoded.
+  bool serialiseLayer(const SdfLayerRefPtr& layer, bool binary, std::string& serialised)
+  {
+    if(binary && layer->IsAnonymous())
+    {
+      const std::string tempPath = ArchMakeTmpFileName("AL_USDMaya_layer", ".usdc");
+      std::string data;
+      const bool exported = layer->Export(tempPath) && readFile(tempPath, data);
+      ArchUnlinkFile(tempPath.c_str());
+      if(exported)
+      {
+        serialised = g_binaryLayerTag + AL::usdmaya::encodeBase64(data);
+        return true;
+      }
+      TF_DEBUG(ALUSDMAYA_LAYERS).Msg("failed to export layer '%s' as usdc, falling back to text\n",
+                                     layer->GetIdentifier().c_str());
+    }
+    return layer->ExportToString(&serialised);
+  }
+
+  // Replaces the contents of a layer with the base64 encoded usdc data written by serialiseLayer
+  bool deserialiseBinaryLayer(const SdfLayerRefPtr& layer, const std::string& serialised)
+  {
+    const size_t tagLength = std::strlen(g_binaryLayerTag);
+    std::string data;
+    if(!AL::usdmaya::decodeBase64(serialised.c_str() + tagLength, serialised.size() - tagLength, data))
+    {
+      return false;
+    }
+
+    const std::string tempPath = ArchMakeTmpFileName("AL_USDMaya_layer", ".usdc");
+    bool imported = false;
+    {
+      std::ofstream ofs(tempPath, std::ios::binary);
+      ofs.write(data.data(), data.size());
+    }
+    {
+      SdfLayerRefPtr binaryLayer = SdfLayer::OpenAsAnonymous(tempPath);
+      if(binaryLayer)
+      {
+        layer->TransferContent(binaryLayer);
+        imported = true;
+      }
+    }
+    ArchUnlinkFile(tempPath.c_str());
+    return imported;
+  }
 }
 
 namespace AL {
@@ -116,6 +189,43 @@ namespace nodes {
 
 LayerManager::~LayerManager()
 {
+  TfNotice::Revoke(m_layersChangedNoticeKey);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::postConstructor()
+{
+  TfWeakPtr<LayerManager> me(this);
+  m_layersChangedNoticeKey = TfNotice::Register(me, &LayerManager::onLayersChanged);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::onLayersChanged(SdfNotice::LayersDidChange const& notice)
+{
+  // Any edit to a layer invalidates its serialised contents. Notices can be sent from any thread that edits a layer.
+  std::lock_guard<std::mutex> lock(m_serialisedLayersMutex);
+  if(m_serialisedLayers.empty())
+  {
+    return;
+  }
+  TF_FOR_ALL(itr, notice.GetChangeListMap())
+  {
+    m_serialisedLayers.erase(itr->first);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::clearSerialisationCache()
+{
+  std::lock_guard<std::mutex> lock(m_serialisedLayersMutex);
+  m_serialisedLayers.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t LayerManager::serialisationCacheSize()
+{
+  std::lock_guard<std::mutex> lock(m_serialisedLayersMutex);
+  return m_serialisedLayers.size();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -258,6 +368,7 @@ MObject LayerManager::m_layers = MObject::kNullObj;
 MObject LayerManager::m_identifier = MObject::kNullObj;
 MObject LayerManager::m_serialized = MObject::kNullObj;
 MObject LayerManager::m_anonymous = MObject::kNullObj;
+MObject LayerManager::m_binarySerialisation = MObject::kNullObj;
 
 //----------------------------------------------------------------------------------------------------------------------
 void* LayerManager::conditionalCreator()
@@ -282,6 +393,8 @@ MStatus LayerManager::initialise()
   {
     setNodeType(kTypeName);
     addFrame("USD Layer Manager Node");
+    m_binarySerialisation = addBoolAttr("binarySerialisation", "bsz", false,
+        kCached | kReadable | kWritable | kStorable);
 
     addFrame("Serialization infos");
 
@@ -395,6 +508,10 @@ bool LayerManager::removeLayer(SdfLayerHandle layer)
     MGlobal::displayError("LayerManager::removeLayer - given layer is no longer valid");
     return false;
   }
+  {
+    std::lock_guard<std::mutex> lock(m_serialisedLayersMutex);
+    m_serialisedLayers.erase(layer);
+  }
   boost::unique_lock<boost::shared_mutex> lock(m_layersMutex);
   return m_layerDatabase.removeLayer(layerRef);
 }
@@ -433,24 +550,78 @@ MStatus LayerManager::populateSerialisationAttributes()
 
   MArrayDataHandle layersArrayHandle = dataBlock.outputArrayValue(m_layers, &status);
   AL_MAYA_CHECK_ERROR(status, errorString);
+  const bool binary = inputBoolValue(dataBlock, m_binarySerialisation);
   {
     boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
-    MArrayDataBuilder builder(&dataBlock, layers(), m_layerDatabase.max_size(), &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
-    std::string temp;
+
+    // The cache stays locked until the new serialisations have been stored, so that an edit made while the layers
+    // are being exported waits for them to be stored, and then discards the serialisation of the edited layer.
+    std::lock_guard<std::mutex> serialisedLock(m_serialisedLayersMutex);
+
+    // The cached serialisations are in the format of the last save, so none of them can be reused once it changes
+    if(binary != m_serialisedLayersBinary)
+    {
+      m_serialisedLayers.clear();
+      m_serialisedLayersBinary = binary;
+    }
+
+    std::vector<SdfLayerRefPtr> layersToSave;
+    layersToSave.reserve(m_layerDatabase.max_size());
     for (const auto& layerAndIds : m_layerDatabase)
     {
-      auto& layer = layerAndIds.first;
+      layersToSave.push_back(layerAndIds.first);
+    }
+
+    // Pick up the layers that have not changed since they were last serialised. The cache is rebuilt from the layers
+    // being saved, so that layers which are no longer tracked (or no longer dirty) are dropped from it.
+    std::vector<std::string> serialised(layersToSave.size());
+    std::vector<size_t> layersToExport;
+    for(size_t i = 0, n = layersToSave.size(); i < n; ++i)
+    {
+      auto it = m_serialisedLayers.find(layersToSave[i]);
+      if(it != m_serialisedLayers.end())
+      {
+        serialised[i].swap(it->second);
+      }
+      else
+      {
+        layersToExport.push_back(i);
+      }
+    }
+    m_serialisedLayers.clear();
+
+    TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerManager::populateSerialisationAttributes exporting %zu of %zu layers\n",
+                                   layersToExport.size(), layersToSave.size());
+
+    // Exporting is read only, and each task works on a different layer, so the exports can run in parallel
+    WorkParallelForN(layersToExport.size(), [&](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const size_t index = layersToExport[i];
+        serialiseLayer(layersToSave[index], binary, serialised[index]);
+      }
+    });
+
+    MArrayDataBuilder builder(&dataBlock, layers(), layersToSave.size(), &status);
+    AL_MAYA_CHECK_ERROR(status, errorString);
+    for(size_t i = 0, n = layersToSave.size(); i < n; ++i)
+    {
+      auto& layer = layersToSave[i];
       MDataHandle layersElemHandle = builder.addLast(&status);
       AL_MAYA_CHECK_ERROR(status, errorString);
       MDataHandle idHandle = layersElemHandle.child(m_identifier);
       idHandle.setString(AL::maya::utils::convert(layer->GetIdentifier()));
       MDataHandle serializedHandle = layersElemHandle.child(m_serialized);
-      layer->ExportToString(&temp);
-      serializedHandle.setString(AL::maya::utils::convert(temp));
+      serializedHandle.setString(AL::maya::utils::convert(serialised[i]));
       MDataHandle anonHandle = layersElemHandle.child(m_anonymous);
       anonHandle.setBool(layer->IsAnonymous());
     }
+
+    for(size_t i = 0, n = layersToSave.size(); i < n; ++i)
+    {
+      m_serialisedLayers[layersToSave[i]].swap(serialised[i]);
+    }
     AL_MAYA_CHECK_ERROR(layersArrayHandle.set(builder), errorString);
   }
   AL_MAYA_CHECK_ERROR(layersArrayHandle.setAllClean(), errorString);
@@ -525,6 +696,7 @@ void LayerManager::loadAllLayers()
       continue;
     }
 
+    const bool isBinary = TfStringStartsWith(serializedVal, g_binaryLayerTag);
     bool isAnon = anonymousPlug.asBool(MDGContext::fsNormal, &status);
     AL_MAYA_CHECK_ERROR_CONTINUE(status, errorString);
     if(isAnon)
@@ -546,7 +718,7 @@ void LayerManager::loadAllLayers()
         // an error. This seems unlikely, but we have a discussion with Pixar to find a way to avoid this.
 
         SdfFileFormatConstPtr fileFormat;
-        if(TfStringStartsWith(serializedVal, "#usda "))
+        if(TfStringStartsWith(serializedVal, "#usda ") || isBinary)
         {
           fileFormat = SdfFileFormat::FindById(UsdUsdaFileFormatTokens->Id);
         }
@@ -564,8 +736,10 @@ void LayerManager::loadAllLayers()
       }
     }
 
-    // Don't print the entirety of layers > ~1MB
+    // Don't print the entirety of layers > ~1MB, and only print the size of binary layers
     constexpr int MAX_LAYER_CHARS=1000000;
+    const std::string binarySize = isBinary ?
+        TfStringPrintf("<%zu bytes of base64 encoded usdc data>\n", serializedVal.size()) : std::string();
 
     TF_DEBUG(ALUSDMAYA_LAYERS).Msg(
         "################################################\n"
@@ -574,16 +748,20 @@ void LayerManager::loadAllLayers()
         "new identifier: %s\n"
         "format: %s\n"
         "################################################\n"
-        "%.*s\n%s"
+        "%.*s\n%s%s"
         "################################################\n",
         identifierVal.c_str(),
         layer->GetIdentifier().c_str(),
         layer->GetFileFormat()->GetFormatId().GetText(),
-        MAX_LAYER_CHARS,
+        isBinary ? 0 : MAX_LAYER_CHARS,
         serializedVal.c_str(),
-        serializedVal.length() > MAX_LAYER_CHARS ? "<truncated>\n" : ""
+        !isBinary && serializedVal.length() > MAX_LAYER_CHARS ? "<truncated>\n" : "",
+        binarySize.c_str()
         );
-    if(!layer->ImportFromString(serializedVal))
+    const bool imported = isBinary ?
+        deserialiseBinaryLayer(layer, serializedVal) :
+        layer->ImportFromString(serializedVal);
+    if(!imported)
     {
       TF_DEBUG(ALUSDMAYA_LAYERS).Msg("...layer import failed!\n");
       MGlobal::displayError(MString("Failed to import serialized layer: ") + serializedVal.c_str());
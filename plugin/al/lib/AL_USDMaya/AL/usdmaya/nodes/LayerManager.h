@@ -19,6 +19,9 @@
 
 #include "AL/maya/utils/NodeHelper.h"
 #include "pxr/pxr.h"
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/sdf/notice.h"
 #include "pxr/usd/usd/stage.h"
 
 #include "maya/MPxLocatorNode.h"
@@ -27,7 +30,9 @@
 
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
+#include <string>
 #include <boost/thread.hpp>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -227,11 +232,17 @@ private:
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  The layer manager node handles serialization and deserialization of all layers used by all ProxyShapes
 ///         It may temporarily contain non-dirty layers, but those will be filtered out by query operations.
+///
+///         The serialised text of each layer is cached between saves, and only the layers that have been edited since
+///         the last save are exported again (in parallel). If the binarySerialisation attribute is enabled, anonymous
+///         layers are serialised in the usdc format (base64 encoded) rather than as usda text, which is smaller and much
+///         quicker to write and read for large layers.
 /// \ingroup nodes
 //----------------------------------------------------------------------------------------------------------------------
 class LayerManager
   : public MPxNode,
-    public AL::maya::utils::NodeHelper
+    public AL::maya::utils::NodeHelper,
+    public TfWeakBase
 {
 public:
 
@@ -306,9 +317,19 @@ public:
   void getLayerIdentifiers(MStringArray& outputNames);
 
   /// \brief  Ensures that the layers attribute will be filled out with serialized versions of all tracked layers.
+  ///         Layers that have not changed since the last time they were serialised are not exported again.
   AL_USDMAYA_PUBLIC
   MStatus populateSerialisationAttributes();
 
+  /// \brief  Discards the cached serialisations of the layers, so that they are all exported on the next call to
+  ///         populateSerialisationAttributes.
+  AL_USDMAYA_PUBLIC
+  void clearSerialisationCache();
+
+  /// \brief  returns the number of layers whose serialisation is currently cached
+  AL_USDMAYA_PUBLIC
+  size_t serialisationCacheSize();
+
   /// \brief  Clears the layers attribute.
   AL_USDMAYA_PUBLIC
   MStatus clearSerialisationAttributes();
@@ -330,6 +351,9 @@ public:
   /// Type Info & Registration
   //--------------------------------------------------------------------------------------------------------------------
 
+  /// if enabled, anonymous layers are stored as base64 encoded usdc data rather than usda text
+  AL_DECL_ATTRIBUTE(binarySerialisation);
+
   // attributes to store the serialised layers (used for file IO only)
 
   // Note that the layers attribute should ONLY used during serialization, as this is the ONLY
@@ -350,8 +374,18 @@ public:
 private:
   static MObject _findNode();
 
+  void postConstructor() override;
+  void onLayersChanged(SdfNotice::LayersDidChange const& notice);
+
   LayerDatabase m_layerDatabase;
 
+  // The serialised contents of the layers, as of the last time they were exported. Entries are removed whenever the
+  // layer is edited, so any layer present in the map can be written out without exporting it again.
+  std::map<SdfLayerHandle, std::string> m_serialisedLayers;
+  bool m_serialisedLayersBinary = false; ///< true if the anonymous layers in m_serialisedLayers are stored as usdc
+  std::mutex m_serialisedLayersMutex;
+  TfNotice::Key m_layersChangedNoticeKey;
+
   // Note on layerManager / multithreading:
   // I don't know that layerManager will be used in a multihreaded manenr... but I also don't know it COULDN'T be.
   // (I haven't really looked into the way maya's new multi-threaded node evaluation works, for instance.) This is
@@ -20,9 +20,13 @@
 #include "AL/usdmaya/StageData.h"
 #include "AL/usdmaya/utils/Utils.h"
 
+#include "maya/MAnimControl.h"
 #include "maya/MFnMesh.h"
 #include "pxr/usd/usdGeom/mesh.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -36,6 +40,7 @@ MObject MeshAnimDeformer::m_inTime = MObject::kNullObj;
 MObject MeshAnimDeformer::m_inStageData = MObject::kNullObj;
 MObject MeshAnimDeformer::m_outMesh = MObject::kNullObj;
 MObject MeshAnimDeformer::m_inMesh = MObject::kNullObj;
+MObject MeshAnimDeformer::m_readAheadFrames = MObject::kNullObj;
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimDeformer::initialise()
@@ -51,6 +56,7 @@ MStatus MeshAnimDeformer::initialise()
     m_inStageData = addDataAttr("inStageData", "isd", StageData::kTypeId, kWritable | kStorable | kConnectable);
     m_outMesh = addMeshAttr("outMesh", "out", kReadable | kStorable | kConnectable);
     m_inMesh = addMeshAttr("inMesh", "in", kWritable | kStorable | kConnectable);
+    m_readAheadFrames = addInt32Attr("readAheadFrames", "raf", 0, kReadable | kWritable | kStorable);
     attributeAffects(m_primPath, m_outMesh);
     attributeAffects(m_inTime, m_outMesh);
     attributeAffects(m_inStageData, m_outMesh);
@@ -86,38 +92,239 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
   UsdStageRefPtr stage = getStage();
   if(stage)
   {
-    UsdPrim prim = stage->GetPrimAtPath(m_cachePath);
-    UsdGeomMesh mesh(prim);
+    if(resolveAttributes(stage))
+    {
+      const Frame& frame = fetchFrame(usdTime, inputInt32Value(data, m_readAheadFrames));
+
+      MFnMesh fnMesh(obj);
+      float* const ptr = (float*)fnMesh.getRawPoints(&status);
+      if(ptr && !frame.points.empty())
+      {
+        const size_t numPoints = std::min(frame.points.size(), size_t(fnMesh.numVertices()));
+        std::memcpy(ptr, frame.points.cdata(), sizeof(float) * 3 * numPoints);
+      }
+
+      float* const nptr = (float*)fnMesh.getRawNormals(&status);
+      if(nptr && !frame.normals.empty())
+      {
+        const size_t numNormals = std::min(frame.normals.size(), size_t(fnMesh.numNormals()));
+        std::memcpy(nptr, frame.normals.cdata(), sizeof(float) * 3 * numNormals);
+      }
+
+      // During playback, the next frames carry on being read until they are requested. USD doesn't allow reads that
+      // overlap edits to the stage, so outside of playback (when the stage is much more likely to be edited between
+      // evaluations) the frames ahead are only read while the mesh is updated.
+      if(!MAnimControl::isPlaying())
+      {
+        waitForReads();
+      }
+    }
+    outputHandle.set(obj);
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshAnimDeformer::resolveAttributes(const UsdStageRefPtr& stage)
+{
+  if(m_resolved && m_stage == stage)
+  {
+    return true;
+  }
+
+  invalidateAttributes();
+  UsdGeomMesh mesh(stage->GetPrimAtPath(m_cachePath));
+  if(!mesh)
+  {
+    return false;
+  }
+
+  TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::resolveAttributes %s\n", m_cachePath.GetText());
+
+  // only the animated attributes are read, the others are left as they were imported
+  UsdAttribute points = mesh.GetPointsAttr();
+  if(points.GetNumTimeSamples() > 1)
+  {
+    m_points = UsdAttributeQuery(points);
+  }
+  UsdAttribute normals = mesh.GetNormalsAttr();
+  if(normals.GetNumTimeSamples() > 1)
+  {
+    m_normals = UsdAttributeQuery(normals);
+  }
+  m_stage = stage;
+  m_resolved = true;
+  m_objectsChanged = TfNotice::Register(TfCreateWeakPtr(this), &MeshAnimDeformer::onObjectsChanged, m_stage);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::invalidateAttributes()
+{
+  waitForReads();
+  TfNotice::Revoke(m_objectsChanged);
+  m_stage = UsdStageWeakPtr();
+  m_points = UsdAttributeQuery();
+  m_normals = UsdAttributeQuery();
+  m_resolved = false;
+  m_frames.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::waitForRead(Frame& frame)
+{
+  if(frame.reading)
+  {
+    frame.reader->Wait();
+    frame.reading = false;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::waitForReads()
+{
+  for(Frame& frame : m_frames)
+  {
+    waitForRead(frame);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender)
+{
+  if(!m_resolved || sender != m_stage)
+  {
+    return;
+  }
 
-    MFnMesh fnMesh(obj);
-    float* const ptr = (float*)fnMesh.getRawPoints(&status);
-    if(ptr)
+  // the frames read from the prim, and the attribute queries, may be stale once the prim has been edited
+  bool affected = false;
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    if(m_cachePath.HasPrefix(path))
+    {
+      affected = true;
+      break;
+    }
+  }
+  if(!affected)
+  {
+    for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
     {
-      UsdAttribute points = mesh.GetPointsAttr();
-      if(points.GetNumTimeSamples() > 1)
+      if(path.GetPrimPath() == m_cachePath)
       {
-        VtArray<GfVec3f> pointData;
-        points.Get(&pointData, usdTime);
-        const size_t numPoints = pointData.size();
-        std::memcpy(ptr, pointData.cdata(), sizeof(float) * 3 * numPoints);
+        affected = true;
+        break;
       }
     }
+  }
+
+  if(affected)
+  {
+    TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::onObjectsChanged %s\n", m_cachePath.GetText());
+    invalidateAttributes();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::readFrame(Frame& frame) const
+{
+  if(m_points.IsValid())
+  {
+    m_points.Get(&frame.points, frame.time);
+  }
+  if(m_normals.IsValid())
+  {
+    m_normals.Get(&frame.normals, frame.time);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const MeshAnimDeformer::Frame& MeshAnimDeformer::fetchFrame(UsdTimeCode time, int32_t readAheadFrames)
+{
+  const size_t numFrames = size_t(std::max(readAheadFrames, 0)) + 1;
+  if(m_frames.size() != numFrames)
+  {
+    waitForReads();
+    m_frames.clear();
+    m_frames.resize(numFrames);
+  }
 
-    float* const nptr = (float*)fnMesh.getRawNormals(&status);
-    if(nptr)
+  const double currentTime = time.GetValue();
+  if(currentTime != m_lastTime)
+  {
+    m_direction = currentTime < m_lastTime ? -1.0 : 1.0;
+    m_lastTime = currentTime;
+  }
+
+  // keep the frames that are still wanted, i.e. the current one and the next ones along the playback direction
+  std::vector<bool> used(numFrames, false);
+  std::vector<UsdTimeCode> missing;
+  size_t current = 0;
+  for(size_t i = 0; i < numFrames; ++i)
+  {
+    const UsdTimeCode wanted(currentTime + m_direction * double(i));
+    auto it = std::find_if(m_frames.begin(), m_frames.end(), [wanted](const Frame& frame) { return frame.time == wanted; });
+    if(it != m_frames.end())
     {
-      UsdAttribute normals = mesh.GetNormalsAttr();
-      if(normals.GetNumTimeSamples() > 1)
+      used[it - m_frames.begin()] = true;
+      if(!i)
       {
-        VtArray<GfVec3f> normalData;
-        normals.Get(&normalData, usdTime);
-        const size_t numNormals = normalData.size();
-        std::memcpy(nptr, normalData.cdata(), sizeof(float) * 3 * numNormals);
+        // the requested frame may still be in flight from an earlier evaluation
+        current = it - m_frames.begin();
+        waitForRead(*it);
       }
     }
-    outputHandle.set(obj);
+    else
+    {
+      missing.push_back(wanted);
+    }
   }
-  return status;
+
+  // and recycle the buffers of the other ones for the frames that are missing
+  std::vector<size_t> readAhead;
+  bool readCurrent = false;
+  size_t slot = 0;
+  for(const UsdTimeCode& wanted : missing)
+  {
+    while(used[slot])
+    {
+      ++slot;
+    }
+    used[slot] = true;
+    waitForRead(m_frames[slot]);
+    m_frames[slot].time = wanted;
+    if(wanted == time)
+    {
+      current = slot;
+      readCurrent = true;
+    }
+    else
+    {
+      readAhead.push_back(slot);
+    }
+  }
+
+  // the frames ahead are each read by their own task, while the current frame is read on this thread
+  if(!readAhead.empty())
+  {
+    TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::fetchFrame reading %zu frames ahead of %f\n",
+                                              readAhead.size(), currentTime);
+    for(size_t slot : readAhead)
+    {
+      Frame* const frame = &m_frames[slot];
+      frame->reading = true;
+      frame->reader->Run([this, frame]()
+      {
+        readFrame(*frame);
+      });
+    }
+  }
+  if(readCurrent)
+  {
+    readFrame(m_frames[current]);
+  }
+  return m_frames[current];
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -130,6 +337,7 @@ MStatus MeshAnimDeformer::connectionMade(const MPlug& plug, const MPlug& otherPl
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
       proxyShapeHandle = otherPlug.node();
+      invalidateAttributes();
     }
   }
   return MPxNode::connectionMade(plug, otherPlug, asSrc);
@@ -145,6 +353,7 @@ MStatus MeshAnimDeformer::connectionBroken(const MPlug& plug, const MPlug& other
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
       proxyShapeHandle = MObject();
+      invalidateAttributes();
     }
   }
   return MPxNode::connectionBroken(plug, otherPlug, asSrc);
@@ -189,6 +398,7 @@ void MeshAnimDeformer::onAttributeChanged(MNodeMessage::AttributeMessage msg, MP
       if (primPathStr.length())
       {
         deformer->m_cachePath = SdfPath(AL::maya::utils::convert(primPathStr));
+        deformer->invalidateAttributes();
       }
     }
   }
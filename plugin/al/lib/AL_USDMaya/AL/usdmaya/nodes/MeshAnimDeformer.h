@@ -19,11 +19,21 @@
 #include "AL/maya/utils/MayaHelperMacros.h"
 #include "AL/usdmaya/utils/ForwardDeclares.h"
 #include "pxr/pxr.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/work/dispatcher.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/stage.h"
 #include "maya/MPxNode.h"
 #include "maya/MObjectHandle.h"
 #include "maya/MNodeMessage.h"
 
+#include <memory>
+#include <vector>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -36,7 +46,8 @@ namespace nodes {
 //----------------------------------------------------------------------------------------------------------------------
 class MeshAnimDeformer
   : public MPxNode,
-    public AL::maya::utils::NodeHelper
+    public AL::maya::utils::NodeHelper,
+    public TfWeakBase
 {
 public:
 
@@ -46,7 +57,11 @@ public:
      {}
 
   inline ~MeshAnimDeformer()
-    { MNodeMessage::removeCallback(m_attributeChanged); }
+    {
+      MNodeMessage::removeCallback(m_attributeChanged);
+      TfNotice::Revoke(m_objectsChanged);
+      waitForReads();
+    }
 
   //--------------------------------------------------------------------------------------------------------------------
   /// Type Info & Registration
@@ -62,18 +77,60 @@ public:
   AL_DECL_ATTRIBUTE(inStageData);
   AL_DECL_ATTRIBUTE(inMesh);
   AL_DECL_ATTRIBUTE(outMesh);
+  AL_DECL_ATTRIBUTE(readAheadFrames);
 
 private:
   void postConstructor() override;
   MStatus connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
   MStatus connectionBroken(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
   static void onAttributeChanged(MNodeMessage::AttributeMessage, MPlug&, MPlug&, void*);
+  void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender);
   MStatus compute(const MPlug& plug, MDataBlock& data) override;
   UsdStageRefPtr getStage();
+
+  /// the points and normals of the mesh at a single time
+  struct Frame
+  {
+    UsdTimeCode time = UsdTimeCode::Default();
+    VtArray<GfVec3f> points;
+    VtArray<GfVec3f> normals;
+    std::unique_ptr<WorkDispatcher> reader { new WorkDispatcher }; ///< reads the frame ahead of the current time
+    bool reading = false; ///< true while the frame may still be being read by the reader (only used on the main thread)
+  };
+
+  /// resolves the animated points and normals attributes of the cached prim, if the stage or prim path has changed,
+  /// or the prim has been edited since they were resolved
+  bool resolveAttributes(const UsdStageRefPtr& stage);
+
+  /// discards the resolved attributes and the frames read from them
+  void invalidateAttributes();
+
+  /// waits for the frame to be read, if it is being read ahead
+  static void waitForRead(Frame& frame);
+
+  /// waits for all of the frames that are being read ahead
+  void waitForReads();
+
+  /// reads the points and normals of the frame at its time
+  void readFrame(Frame& frame) const;
+
+  /// returns the frame at the requested time, and starts reading the following frames along the playback direction
+  /// into the ring buffer on other threads. Those reads carry on after compute returns, and are only waited for when
+  /// their frame is requested, when their buffer is recycled, or when the frames are discarded.
+  const Frame& fetchFrame(UsdTimeCode time, int32_t readAheadFrames);
+
 private:
   SdfPath m_cachePath;
   MObjectHandle proxyShapeHandle;
   MCallbackId m_attributeChanged = 0;
+  TfNotice::Key m_objectsChanged;
+  UsdStageWeakPtr m_stage;
+  UsdAttributeQuery m_points;
+  UsdAttributeQuery m_normals;
+  bool m_resolved = false;
+  std::vector<Frame> m_frames;
+  double m_lastTime = 0;
+  double m_direction = 1.0;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
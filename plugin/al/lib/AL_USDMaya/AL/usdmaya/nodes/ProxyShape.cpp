@@ -69,7 +69,12 @@ typedef boost::filesystem::path path;
 
 #include "pxr/base/arch/systemInfo.h"
 #include "pxr/base/tf/fileUtils.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/base/work/threadLimits.h"
+#include "pxr/usd/sdf/changeBlock.h"
 #include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/usd/primRange.h"
 #include "pxr/usd/usd/stageCacheContext.h"
 #include "pxr/usdImaging/usdImaging/primAdapter.h"
 #include "pxr/usdImaging/usdImaging/meshAdapter.h"
@@ -85,6 +90,7 @@ typedef boost::filesystem::path path;
 namespace AL {
 namespace usdmaya {
 namespace nodes {
+
 typedef void (*proxy_function_prototype)(void* userData, AL::usdmaya::nodes::ProxyShape* proxyInstance);
 
 const char* ProxyShape::s_selectionMaskName = "al_ProxyShape";
@@ -214,6 +220,7 @@ MObject ProxyShape::m_time = MObject::kNullObj;
 MObject ProxyShape::m_timeOffset = MObject::kNullObj;
 MObject ProxyShape::m_timeScalar = MObject::kNullObj;
 MObject ProxyShape::m_outTime = MObject::kNullObj;
+MObject ProxyShape::m_transformPrefetchFrames = MObject::kNullObj;
 MObject ProxyShape::m_complexity = MObject::kNullObj;
 MObject ProxyShape::m_outStageData = MObject::kNullObj;
 MObject ProxyShape::m_displayGuides = MObject::kNullObj;
@@ -326,7 +333,22 @@ void ProxyShape::translatePrimsIntoMaya(
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape:translatePrimsIntoMaya ImportSize='%zd' TearDownSize='%zd' \n", importPrims.size(), teardownPrims.size());
 
-  proxy::PrimFilter filter(teardownPrims, importPrims, this);
+  // Reading the prim stacks is the only part of the diff that touches the composed stage, and it is safe to do
+  // from several threads, so it is done up front before any of the Maya work.
+  std::vector<size_t> compositionHashes(importPrims.size());
+  WorkParallelForN(importPrims.size(), [&importPrims, &compositionHashes](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      compositionHashes[i] = fileio::translators::TranslatorContext::computeCompositionHash(importPrims[i]);
+    }
+  });
+
+  // The hashes only identify the specs that contribute to a prim, not their contents. A variant switch leaves the
+  // contents alone, so the prims whose hash is unchanged can be skipped, but any other edit (or an explicit resync)
+  // may have changed them, in which case every prim is updated.
+  proxy::PrimFilter filter(teardownPrims, importPrims, this,
+                           m_compositionChangeIsVariantSwitch ? compositionHashes : std::vector<size_t>());
 
   if(TfDebug::IsEnabled(ALUSDMAYA_TRANSLATORS))
   {
@@ -345,6 +367,11 @@ void ProxyShape::translatePrimsIntoMaya(
     {
       std::cout << it.GetPath().GetText() << std::endl;
     }
+    std::cout << "unchanged prims" << std::endl;
+    for(auto it : filter.unchangedPrimSet())
+    {
+      std::cout << it.GetPath().GetText() << std::endl;
+    }
     std::cout << "removed prims" << std::endl;
     for(auto it : filter.removedPrimSet())
     {
@@ -378,6 +405,12 @@ void ProxyShape::translatePrimsIntoMaya(
 
   context()->updatePrimTypes();
 
+  // record the composition of the translated prims, so that the next variant switch can skip them if unaffected
+  for(size_t i = 0, n = importPrims.size(); i < n; ++i)
+  {
+    context()->setCompositionHashForPath(importPrims[i].GetPath(), compositionHashes[i]);
+  }
+
   // now perform any post-creation fix up
   if(!filter.newPrimSet().empty())
   {
@@ -612,37 +645,63 @@ ProxyShape::ProxyShape()
 
   registerEvents();
 
-  m_findExcludedPrims.preIteration = [this]() {
-    m_excludedTaggedGeometry.clear();
+  m_findExcludedPrims.preIteration = [this](size_t numSlots) {
+    m_findExcludedPrims.excludedPrims.assign(numSlots, SdfPathVector());
   };
-  m_findExcludedPrims.iteration = [this]( const fileio::TransformIterator& transformIterator,
-                                          const UsdPrim& prim) {
+  m_findExcludedPrims.iteration = [this](const UsdPrim& prim, size_t slot) {
 
     bool excludeGeo = false;
     if(prim.GetMetadata(Metadata::excludeFromProxyShape, &excludeGeo))
     {
       if (excludeGeo)
       {
-        m_excludedTaggedGeometry.push_back(prim.GetPrimPath());
+        m_findExcludedPrims.excludedPrims[slot].push_back(prim.GetPrimPath());
       }
     }
-
-    // If prim has exclusion tag or is a descendent of a prim with it, create as Maya geo
-    if (excludeGeo || primHasExcludedParent(prim))
-    {
-      VtValue schemaName(fileio::ALExcludedPrimSchema.GetString());
-      prim.SetCustomDataByKey(fileio::ALSchemaType, schemaName);
-    }
   };
   m_findExcludedPrims.postIteration = [this]() {
+    m_excludedTaggedGeometry.clear();
+    for(const auto& excludedPrims : m_findExcludedPrims.excludedPrims)
+    {
+      m_excludedTaggedGeometry.insert(m_excludedTaggedGeometry.end(), excludedPrims.begin(), excludedPrims.end());
+    }
+    m_findExcludedPrims.excludedPrims.clear();
+    std::sort(m_excludedTaggedGeometry.begin(), m_excludedTaggedGeometry.end());
+
+    // Authoring isn't thread safe, so the excluded prims (and their descendants) are only tagged to be created as
+    // Maya geometry once the traversal is done. Descendants of an excluded prim that is itself excluded are skipped,
+    // they have already been tagged along with their ancestor.
+    VtValue schemaName(fileio::ALExcludedPrimSchema.GetString());
+    SdfChangeBlock changeBlock;
+    const SdfPath* lastTaggedPath = nullptr;
+    for(const SdfPath& excludedPath : m_excludedTaggedGeometry)
+    {
+      if(lastTaggedPath && excludedPath.HasPrefix(*lastTaggedPath))
+      {
+        continue;
+      }
+      lastTaggedPath = &excludedPath;
+
+      // prims in instance masters can't be edited, they stay in the excluded list untagged
+      UsdPrim excludedPrim = m_stage->GetPrimAtPath(excludedPath);
+      if(!excludedPrim || excludedPrim.IsInMaster())
+      {
+        continue;
+      }
+      for(const UsdPrim& prim : UsdPrimRange(excludedPrim))
+      {
+        prim.SetCustomDataByKey(fileio::ALSchemaType, schemaName);
+      }
+    }
+
     constructExcludedPrims();
   };
 
-  m_findUnselectablePrims.preIteration = [this]() {
-
+  m_findUnselectablePrims.preIteration = [this](size_t numSlots) {
+    m_findUnselectablePrims.newUnselectables.assign(numSlots, SdfPathVector());
+    m_findUnselectablePrims.removeUnselectables.assign(numSlots, SdfPathVector());
   };
-  m_findUnselectablePrims.iteration = [this]
-                                    (const fileio::TransformIterator& transformIterator, const UsdPrim& prim) {
+  m_findUnselectablePrims.iteration = [this](const UsdPrim& prim, size_t slot) {
 
     TfToken selectabilityPropertyToken;
     if(prim.GetMetadata<TfToken>(Metadata::selectability, &selectabilityPropertyToken))
@@ -651,61 +710,80 @@ ProxyShape::ProxyShape()
       //Check if this prim is unselectable
       if(selectabilityPropertyToken == Metadata::unselectable)
       {
-        m_findUnselectablePrims.newUnselectables.push_back(prim.GetPath());
+        m_findUnselectablePrims.newUnselectables[slot].push_back(prim.GetPath());
       }
       else if(m_selectabilityDB.isPathUnselectable(prim.GetPath()) && selectabilityPropertyToken != Metadata::unselectable)
       {
-        m_findUnselectablePrims.removeUnselectables.push_back(prim.GetPath());
+        m_findUnselectablePrims.removeUnselectables[slot].push_back(prim.GetPath());
       }
     }
   };
   m_findUnselectablePrims.postIteration = [this]() {
-    if(m_findUnselectablePrims.removeUnselectables.size() > 0)
+    SdfPathVector removeUnselectables;
+    for(const auto& paths : m_findUnselectablePrims.removeUnselectables)
+    {
+      removeUnselectables.insert(removeUnselectables.end(), paths.begin(), paths.end());
+    }
+    if(removeUnselectables.size() > 0)
     {
-      m_selectabilityDB.removePathsAsUnselectable(m_findUnselectablePrims.removeUnselectables);
+      m_selectabilityDB.removePathsAsUnselectable(removeUnselectables);
     }
 
-    if(m_findUnselectablePrims.newUnselectables.size() > 0)
+    SdfPathVector newUnselectables;
+    for(const auto& paths : m_findUnselectablePrims.newUnselectables)
+    {
+      newUnselectables.insert(newUnselectables.end(), paths.begin(), paths.end());
+    }
+    if(newUnselectables.size() > 0)
     {
-      m_selectabilityDB.addPathsAsUnselectable(m_findUnselectablePrims.newUnselectables);
+      m_selectabilityDB.addPathsAsUnselectable(newUnselectables);
     }
 
     m_findUnselectablePrims.newUnselectables.clear();
     m_findUnselectablePrims.removeUnselectables.clear();
   };
 
-  m_findLockedPrims.preIteration = [this]() {
-    this->m_lockTransformPrims.clear();
-    this->m_lockInheritedPrims.clear();
+  m_findLockedPrims.preIteration = [this](size_t numSlots) {
+    m_findLockedPrims.lockTransformPrims.assign(numSlots, SdfPathVector());
+    m_findLockedPrims.lockInheritedPrims.assign(numSlots, SdfPathVector());
   };
-  m_findLockedPrims.iteration = [this] ( const fileio::TransformIterator& transformIterator,
-                                         const UsdPrim& prim)
+  m_findLockedPrims.iteration = [this](const UsdPrim& prim, size_t slot)
   {
     TfToken lockPropertyToken;
     if (prim.GetMetadata<TfToken>(Metadata::locked, & lockPropertyToken))
     {
       if (lockPropertyToken == Metadata::lockTransform)
       {
-        this->m_lockTransformPrims.insert(prim.GetPath());
+        m_findLockedPrims.lockTransformPrims[slot].push_back(prim.GetPath());
       }
       else if (lockPropertyToken == Metadata::lockInherited)
       {
-        this->m_lockInheritedPrims.insert(prim.GetPath());
+        m_findLockedPrims.lockInheritedPrims[slot].push_back(prim.GetPath());
       }
     }
     else
     {
-      this->m_lockInheritedPrims.insert(prim.GetPath());
+      m_findLockedPrims.lockInheritedPrims[slot].push_back(prim.GetPath());
     }
 
   };
   m_findLockedPrims.postIteration = [this]() {
+    m_lockTransformPrims.clear();
+    m_lockInheritedPrims.clear();
+    for(const auto& paths : m_findLockedPrims.lockTransformPrims)
+    {
+      m_lockTransformPrims.insert(paths.begin(), paths.end());
+    }
+    for(const auto& paths : m_findLockedPrims.lockInheritedPrims)
+    {
+      m_lockInheritedPrims.insert(paths.begin(), paths.end());
+    }
+    m_findLockedPrims.lockTransformPrims.clear();
+    m_findLockedPrims.lockInheritedPrims.clear();
     constructLockPrims();
   };
 
-  m_hierarchyIterationLogics[0] = &m_findExcludedPrims;
-  m_hierarchyIterationLogics[1] = &m_findUnselectablePrims;
-  m_hierarchyIterationLogics[2] = &m_findLockedPrims;
+  m_hierarchyIterationLogics = { &m_findExcludedPrims, &m_findUnselectablePrims, &m_findLockedPrims };
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -786,6 +864,7 @@ MStatus ProxyShape::initialise()
     m_timeOffset = addTimeAttr("timeOffset", "tmo", MTime(0.0), kCached | kConnectable | kReadable | kWritable | kStorable | kAffectsAppearance);
     m_timeScalar = addDoubleAttr("timeScalar", "tms", 1.0, kCached | kConnectable | kReadable | kWritable | kStorable | kAffectsAppearance);
     m_outTime = addTimeAttr("outTime", "otm", MTime(0.0), kCached | kConnectable | kReadable | kAffectsAppearance);
+    m_transformPrefetchFrames = addInt32Attr("transformPrefetchFrames", "tpf", 0, kCached | kReadable | kWritable | kStorable);
     m_layers = addMessageAttr("layers", "lys", kWritable | kReadable | kConnectable | kHidden);
 
     addFrame("USD Driven Transforms");
@@ -902,7 +981,7 @@ void ProxyShape::onPrimResync(SdfPath primPath, SdfPathVector& previousPrims)
     return;
   }
 
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::onPrimResync begin:\n%s\n", context()->serialise().asChar());
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::onPrimResync begin: %s", context()->describe().c_str());
 
   AL_BEGIN_PROFILE_SECTION(ObjectChanged);
   MFnDagNode fn(thisMObject());
@@ -918,7 +997,7 @@ void ProxyShape::onPrimResync(SdfPath primPath, SdfPathVector& previousPrims)
 
   previousPrims.clear();
 
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::onPrimResync end:\n%s\n", context()->serialise().asChar());
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::onPrimResync end: %s", context()->describe().c_str());
 
   AL_END_PROFILE_SECTION();
 
@@ -1033,6 +1112,13 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
 
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::onObjectsChanged called m_compositionHasChanged=%i\n", m_compositionHasChanged);
 
+  // discard the pre-sampled transforms if the animation of any of them may have been modified, and let the transforms
+  // know that their attribute queries need rebuilding
+  m_transformSampleCache.invalidate(notice);
+
+  // discard the cached bounds that the edit may have changed
+  m_boundingBoxCache.invalidate(notice);
+
   // These paths are subtree-roots representing entire subtrees that may have
   // changed. In this case, we must dump all cached data below these points
   // and repopulate those trees.
@@ -1043,10 +1129,20 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
     onPrimResync(m_changedPath, m_variantSwitchedPrims);
     m_variantSwitchedPrims.clear();
     m_changedPath = SdfPath();
+    m_compositionChangeIsVariantSwitch = false;
 
-    std::stringstream strstr;
-    strstr << "Breakdown for Variant Switch:\n";
-    AL::usdmaya::Profiler::printReport(strstr);
+    // formatting the report is only worth doing if someone is going to read it
+    if(TfDebug::IsEnabled(ALUSDMAYA_EVALUATION))
+    {
+      std::stringstream strstr;
+      strstr << "Breakdown for Variant Switch:\n";
+      AL::usdmaya::Profiler::printReport(strstr);
+      TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("%s", strstr.str().c_str());
+    }
+    else
+    {
+      AL::usdmaya::Profiler::clearAll();
+    }
   }
 
   SdfPathVector newUnselectables;
@@ -1139,7 +1235,12 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
   bool lockChanged = updateLockPrims(lockTransformPrims, lockInheritedPrims, unlockedPrims);
   if (lockChanged)
   {
-    constructLockPrims();
+    // only the subtrees below the prims whose lock state was recorded can have changed.
+    SdfPathSet changedPaths;
+    changedPaths.insert(lockTransformPrims.begin(), lockTransformPrims.end());
+    changedPaths.insert(lockInheritedPrims.begin(), lockInheritedPrims.end());
+    changedPaths.insert(unlockedPrims.begin(), unlockedPrims.end());
+    constructLockPrims(changedPaths);
   }
 }
 
@@ -1231,6 +1332,23 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
     return;
   }
 
+  // if anything other than variant selections or active states are modified by the same change, then the contents of
+  // the specs may have changed as well
+  bool onlySelectionsChanged = true;
+  TF_FOR_ALL(itr, notice.GetChangeListMap())
+  {
+    TF_FOR_ALL(entryIter, itr->second.GetEntryList())
+    {
+      const SdfChangeList::Entry &entry = entryIter->second;
+      onlySelectionsChanged = onlySelectionsChanged && !entry.infoChanged.empty();
+      TF_FOR_ALL(it, entry.infoChanged)
+      {
+        onlySelectionsChanged = onlySelectionsChanged &&
+            (it->first == SdfFieldKeys->VariantSelection || it->first == SdfFieldKeys->Active);
+      }
+    }
+  }
+
   TF_FOR_ALL(itr, notice.GetChangeListMap())
   {
     TF_FOR_ALL(entryIter, itr->second.GetEntryList())
@@ -1254,6 +1372,11 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
           {
             TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::Not yet in a composition change state. Recording path. \n");
             m_changedPath = path;
+            m_compositionChangeIsVariantSwitch = onlySelectionsChanged;
+          }
+          else
+          {
+            m_compositionChangeIsVariantSwitch = m_compositionChangeIsVariantSwitch && onlySelectionsChanged;
           }
           m_compositionHasChanged = true;
           onPrePrimChanged(path, m_variantSwitchedPrims);
@@ -1266,13 +1389,8 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void ProxyShape::loadStage()
+void ProxyShape::beginLoadStage(StageLoadRequest& request)
 {
-  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::loadStage\n");
-
-  triggerEvent("PreStageLoaded");
-
-  AL_BEGIN_PROFILE_SECTION(LoadStage);
   MDataBlock dataBlock = forceCache();
   // in case there was already a stage in m_stage, check to see if it's edit target has been altered
   if (m_stage)
@@ -1280,6 +1398,8 @@ void ProxyShape::loadStage()
     trackEditTargetLayer();
   }
   m_stage = UsdStageRefPtr();
+  m_boundingBoxCache.clear();
+  m_transformSampleCache.clear();
 
   // Get input attr values
   const MString file = inputStringValue(dataBlock, m_filePath);
@@ -1287,7 +1407,7 @@ void ProxyShape::loadStage()
   const MString serializedArCtx = inputStringValue(dataBlock, m_serializedArCtx);
 
   const MString populationMaskIncludePaths = inputStringValue(dataBlock, m_populationMaskIncludePaths);
-  UsdStagePopulationMask mask = constructStagePopulationMask(populationMaskIncludePaths);
+  request.mask = constructStagePopulationMask(populationMaskIncludePaths);
 
   // TODO initialise the context using the serialised attribute
 
@@ -1315,110 +1435,161 @@ void ProxyShape::loadStage()
   }
 
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage called for the usd file: %s\n", fileString.c_str());
+  request.filePath = fileString;
 
-  // Only try to create a stage for layers that can be opened.
-  if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(fileString))
-  {
-    MStatus status;
-    SdfLayerRefPtr sessionLayer;
-
-    AL_BEGIN_PROFILE_SECTION(OpeningUsdStage);
-      AL_BEGIN_PROFILE_SECTION(OpeningSessionLayer);
+  AL_BEGIN_PROFILE_SECTION(OpeningSessionLayer);
+    // Grab the session layer from the layer manager
+    if(sessionLayerName.length() > 0)
+    {
+      auto layerManager = LayerManager::findManager();
+      if(layerManager)
+      {
+        request.sessionLayer = layerManager->findLayer(AL::maya::utils::convert(sessionLayerName));
+        if(!request.sessionLayer)
         {
-          // Grab the session layer from the layer manager
-          if(sessionLayerName.length() > 0)
-          {
-            auto layerManager = LayerManager::findManager();
-            if(layerManager)
-            {
-              sessionLayer = layerManager->findLayer(AL::maya::utils::convert(sessionLayerName));
-              if(!sessionLayer)
-              {
-                MGlobal::displayError(MString("ProxyShape \"") + name() + "\" had a serialized session layer"
-                    " named \"" + sessionLayerName + "\", but no matching layer could be found in the layerManager");
-              }
-            }
-            else
-            {
-              MGlobal::displayError(MString("ProxyShape \"") + name() + "\" had a serialized session layer,"
-                  " but no layerManager node was found");
-            }
-          }
-
-          // If we still have no sessionLayer, but there's data in serializedSessionLayer, then
-          // assume we're reading an "old" file, and read it for backwards compatibility.
-          if(!sessionLayer)
-          {
-            const MString serializedSessionLayer = inputStringValue(dataBlock, m_serializedSessionLayer);
-            if(serializedSessionLayer.length() != 0)
-            {
-              sessionLayer = SdfLayer::CreateAnonymous();
-              sessionLayer->ImportFromString(AL::maya::utils::convert(serializedSessionLayer));
-            }
-          }
+          MGlobal::displayError(MString("ProxyShape \"") + name() + "\" had a serialized session layer"
+              " named \"" + sessionLayerName + "\", but no matching layer could be found in the layerManager");
         }
-      AL_END_PROFILE_SECTION();
-
-      AL_BEGIN_PROFILE_SECTION(OpenRootLayer);
-
-      const MString assetResolverConfig = inputStringValue(dataBlock, m_assetResolverConfig);
-
-      if (assetResolverConfig.length()==0)
-      {
-        // Initialise the asset resolver with the filepath
-        PXR_NS::ArGetResolver().ConfigureResolverForAsset(fileString);
       }
       else
       {
-        // Initialise the asset resolver with the resolverConfig string
-        PXR_NS::ArGetResolver().ConfigureResolverForAsset(assetResolverConfig.asChar());
+        MGlobal::displayError(MString("ProxyShape \"") + name() + "\" had a serialized session layer,"
+            " but no layerManager node was found");
       }
-      AL_END_PROFILE_SECTION();
+    }
 
-      AL_BEGIN_PROFILE_SECTION(UsdStageOpen);
+    // If we still have no sessionLayer, but there's data in serializedSessionLayer, then
+    // assume we're reading an "old" file, and read it for backwards compatibility.
+    if(!request.sessionLayer)
+    {
+      const MString serializedSessionLayer = inputStringValue(dataBlock, m_serializedSessionLayer);
+      if(serializedSessionLayer.length() != 0)
       {
-        UsdStageCacheContext ctx(StageCache::Get());
+        request.sessionLayer = SdfLayer::CreateAnonymous();
+        request.sessionLayer->ImportFromString(AL::maya::utils::convert(serializedSessionLayer));
+      }
+    }
+  AL_END_PROFILE_SECTION();
 
-        bool unloadedFlag = inputBoolValue(dataBlock, m_unloaded);
-        UsdStage::InitialLoadSet loadOperation = unloadedFlag ? UsdStage::LoadNone : UsdStage::LoadAll;
+  // Build the resolver context of the stage from the resolverConfig string if there is one, or else from the filepath.
+  // Each stage gets its own context, so stages can be opened concurrently without reconfiguring the resolver. With the
+  // AL_usdmaya_parallelStageLoad optionVar turned off, the resolver is configured with the same string instead, right
+  // before the stage is opened.
+  const MString assetResolverConfig = inputStringValue(dataBlock, m_assetResolverConfig);
+  request.resolverConfig = assetResolverConfig.length() == 0 ? fileString : std::string(assetResolverConfig.asChar());
+  request.configureResolver = MGlobal::optionVarExists("AL_usdmaya_parallelStageLoad") &&
+                              !MGlobal::optionVarIntValue("AL_usdmaya_parallelStageLoad");
+  if (!fileString.empty() && !request.configureResolver)
+  {
+    request.resolverContext = PXR_NS::ArGetResolver().CreateDefaultContextForAsset(request.resolverConfig);
+  }
 
-        if (sessionLayer)
-        {
-          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called with extra session layer.\n");
-          m_stage = UsdStage::OpenMasked(rootLayer, sessionLayer, mask, loadOperation);
-        }
-        else
-        {
-          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called without any session layer.\n");
-          m_stage = UsdStage::OpenMasked(rootLayer, mask, loadOperation);
-        }
+  bool unloadedFlag = inputBoolValue(dataBlock, m_unloaded);
+  request.loadSet = unloadedFlag ? UsdStage::LoadNone : UsdStage::LoadAll;
+}
 
-        // Expand the mask, since we do not really want to mask the possible relation targets.
-        m_stage->ExpandPopulationMask();
+//----------------------------------------------------------------------------------------------------------------------
+UsdStageRefPtr ProxyShape::openStage(const StageLoadRequest& request)
+{
+  if (request.configureResolver)
+  {
+    return openStageWithConfiguredResolver(request);
+  }
 
-        UsdStageCache::Id stageId = StageCache::Get().Insert(m_stage);
-        outputInt32Value(dataBlock, m_stageCacheId, stageId.ToLongInt());
+  // Only try to create a stage for layers that can be opened. The root layer is resolved with the context of the stage.
+  SdfLayerRefPtr rootLayer;
+  {
+    ArResolverContextBinder binder(request.resolverContext);
+    rootLayer = SdfLayer::FindOrOpen(request.filePath);
+  }
+  if (!rootLayer)
+  {
+    return UsdStageRefPtr();
+  }
 
-        // Set the edit target to the session layer so any user interaction will wind up there
-        m_stage->SetEditTarget(m_stage->GetSessionLayer());
-        // Save the initial edit target
-        trackEditTargetLayer();
-      }
-      AL_END_PROFILE_SECTION();
-    AL_END_PROFILE_SECTION();
+  // OpenMasked does not consult the stage cache, so no cache context is needed here, which keeps this safe to call
+  // from worker threads. The stage is added to the cache by endLoadStage.
+  UsdStageRefPtr stage;
+  if (request.sessionLayer)
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called with extra session layer.\n");
+    stage = UsdStage::OpenMasked(rootLayer, request.sessionLayer, request.resolverContext, request.mask, request.loadSet);
+  }
+  else
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called without any session layer.\n");
+    stage = UsdStage::OpenMasked(rootLayer, request.resolverContext, request.mask, request.loadSet);
+  }
+
+  // Expand the mask, since we do not really want to mask the possible relation targets.
+  if (stage)
+  {
+    stage->ExpandPopulationMask();
+  }
+  return stage;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+UsdStageRefPtr ProxyShape::openStageWithConfiguredResolver(const StageLoadRequest& request)
+{
+  // Initialise the asset resolver with the resolverConfig string (or the filepath), and let the stage build its
+  // context from the configured resolver. This changes global state, so it must only be called on the main thread.
+  PXR_NS::ArGetResolver().ConfigureResolverForAsset(request.resolverConfig);
+
+  SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(request.filePath);
+  if (!rootLayer)
+  {
+    return UsdStageRefPtr();
+  }
+
+  UsdStageRefPtr stage;
+  if (request.sessionLayer)
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called with extra session layer.\n");
+    stage = UsdStage::OpenMasked(rootLayer, request.sessionLayer, request.mask, request.loadSet);
   }
   else
-  if(!fileString.empty())
   {
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage failed to open the usd file: %s.\n", file.asChar());
-    MGlobal::displayWarning(MString("Failed to open usd file \"") + file + "\"");
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called without any session layer.\n");
+    stage = UsdStage::OpenMasked(rootLayer, request.mask, request.loadSet);
+  }
+
+  // Expand the mask, since we do not really want to mask the possible relation targets.
+  if (stage)
+  {
+    stage->ExpandPopulationMask();
+  }
+  return stage;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::endLoadStage(const StageLoadRequest& request, const UsdStageRefPtr& stage)
+{
+  MDataBlock dataBlock = forceCache();
+
+  m_stage = stage;
+  if (m_stage)
+  {
+    UsdStageCache::Id stageId = StageCache::Get().Insert(m_stage);
+    outputInt32Value(dataBlock, m_stageCacheId, stageId.ToLongInt());
+
+    // Set the edit target to the session layer so any user interaction will wind up there
+    m_stage->SetEditTarget(m_stage->GetSessionLayer());
+    // Save the initial edit target
+    trackEditTargetLayer();
+  }
+  else
+  if(!request.filePath.empty())
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage failed to open the usd file: %s.\n", request.filePath.c_str());
+    MGlobal::displayWarning(MString("Failed to open usd file \"") + request.filePath.c_str() + "\"");
   }
 
   // Get the prim
   // If no primPath string specified, then use the pseudo-root.
   const SdfPath rootPath(std::string("/"));
   MString primPathStr = inputStringValue(dataBlock, m_primPath);
-  if (primPathStr.length())
+  if (primPathStr.length() && m_stage)
   {
     m_path = SdfPath(AL::maya::utils::convert(primPathStr));
     UsdPrim prim = m_stage->GetPrimAtPath(m_path);
@@ -1440,13 +1611,31 @@ void ProxyShape::loadStage()
       findTaggedPrims();
     AL_END_PROFILE_SECTION();
   }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::loadStage()
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::loadStage\n");
+
+  triggerEvent("PreStageLoaded");
+
+  StageLoadRequest request;
+  AL_BEGIN_PROFILE_SECTION(LoadStage);
+    beginLoadStage(request);
+
+    UsdStageRefPtr stage;
+    AL_BEGIN_PROFILE_SECTION(OpeningUsdStage);
+      stage = openStage(request);
+    AL_END_PROFILE_SECTION();
 
+    endLoadStage(request, stage);
   AL_END_PROFILE_SECTION();
 
   if(MGlobal::kInteractive == MGlobal::mayaState())
   {
     std::stringstream strstr;
-    strstr << "Breakdown for file: " << file << std::endl;
+    strstr << "Breakdown for file: " << request.filePath << std::endl;
     AL::usdmaya::Profiler::printReport(strstr);
     MGlobal::displayInfo(AL::maya::utils::convert(strstr.str()));
   }
@@ -1456,6 +1645,57 @@ void ProxyShape::loadStage()
   triggerEvent("PostStageLoaded");
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::loadStages(const std::vector<ProxyShape*>& proxies)
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::loadStages %zu proxy shapes\n", proxies.size());
+
+  AL_BEGIN_PROFILE_SECTION(LoadStages);
+    std::vector<StageLoadRequest> requests(proxies.size());
+    for(size_t i = 0, n = proxies.size(); i < n; ++i)
+    {
+      proxies[i]->triggerEvent("PreStageLoaded");
+      AL_BEGIN_PROFILE_SECTION(LoadStage);
+        proxies[i]->beginLoadStage(requests[i]);
+      AL_END_PROFILE_SECTION();
+    }
+
+    // Each request carries its own resolver context, so the stages can all be opened at once. Requests that configure
+    // the resolver instead have to be opened one at a time, since the configuration is global.
+    const bool configureResolver = std::any_of(requests.begin(), requests.end(),
+        [](const StageLoadRequest& request) { return request.configureResolver; });
+    std::vector<UsdStageRefPtr> stages(proxies.size());
+    AL_BEGIN_PROFILE_SECTION(OpeningUsdStages);
+      if(configureResolver)
+      {
+        for(size_t i = 0, n = requests.size(); i < n; ++i)
+        {
+          stages[i] = openStage(requests[i]);
+        }
+      }
+      else
+      {
+        WorkParallelForN(requests.size(), [&requests, &stages](size_t begin, size_t end)
+        {
+          for(size_t i = begin; i < end; ++i)
+          {
+            stages[i] = openStage(requests[i]);
+          }
+        });
+      }
+    AL_END_PROFILE_SECTION();
+
+    for(size_t i = 0, n = proxies.size(); i < n; ++i)
+    {
+      AL_BEGIN_PROFILE_SECTION(LoadStage);
+        proxies[i]->endLoadStage(requests[i], stages[i]);
+      AL_END_PROFILE_SECTION();
+      proxies[i]->stageDataDirtyPlug().setValue(true);
+      proxies[i]->triggerEvent("PostStageLoaded");
+    }
+  AL_END_PROFILE_SECTION();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool ProxyShape::updateLockPrims(const SdfPathSet& lockTransformPrims, const SdfPathSet& lockInheritedPrims,
                                  const SdfPathSet& unlockedPrims)
@@ -1561,30 +1801,84 @@ bool ProxyShape::lockTransformAttribute(const SdfPath& path, const bool lock)
 void ProxyShape::constructLockPrims()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::constructLockPrims\n");
-  SdfPathSet primsNeedLock = m_lockTransformPrims;
+  constructLockPrimsInSubtree(SdfPath::AbsoluteRootPath());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::constructLockPrims(const SdfPathSet& changedPaths)
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::constructLockPrims(%zu changed paths)\n", changedPaths.size());
+
+  // Prims that could not be locked or unlocked by a previous pass (usually because their maya transform did not exist
+  // yet) are retried along with the changed subtrees.
+  SdfPathSet rootPaths(changedPaths);
+  rootPaths.insert(m_failedLockPrims.begin(), m_failedLockPrims.end());
+
+  // The set is sorted so that descendants directly follow their ancestors, which lets us skip over any path that is
+  // already covered by the subtree of the previous root.
+  const SdfPath* lastRootPath = nullptr;
+  for (const SdfPath& path : rootPaths)
+  {
+    if (lastRootPath && path.HasPrefix(*lastRootPath))
+      continue;
+    lastRootPath = &path;
+    constructLockPrimsInSubtree(path);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+namespace {
+
+/// \brief  returns the end of the range of paths, starting at \p begin, that are descendants of \p rootPath.
+///         Relies on the sort order of SdfPath, which keeps every subtree contiguous.
+SdfPathSet::iterator subtreeEnd(SdfPathSet::iterator begin, SdfPathSet::iterator end, const SdfPath& rootPath)
+{
+  while (begin != end && begin->HasPrefix(rootPath))
+  {
+    ++begin;
+  }
+  return begin;
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::constructLockPrimsInSubtree(const SdfPath& rootPath)
+{
+  // forget the previous lock state of the subtree, including the prims that failed to lock, they are retried below.
+  auto needLockBegin = m_primsNeedLock.lower_bound(rootPath);
+  m_primsNeedLock.erase(needLockBegin, subtreeEnd(needLockBegin, m_primsNeedLock.end(), rootPath));
+  auto failedLockBegin = m_failedLockPrims.lower_bound(rootPath);
+  m_failedLockPrims.erase(failedLockBegin, subtreeEnd(failedLockBegin, m_failedLockPrims.end(), rootPath));
+
+  // all prims with a locked transform need locking.
+  auto lockTransformBegin = m_lockTransformPrims.lower_bound(rootPath);
+  m_primsNeedLock.insert(lockTransformBegin, subtreeEnd(lockTransformBegin, m_lockTransformPrims.end(), rootPath));
 
-  // add inherited lock prims if their parents are already in.
-  for (auto inherited : m_lockInheritedPrims)
+  // add inherited lock prims if their parents are already in. Parents are visited before their children, so the lock
+  // state is propagated all the way down the subtree.
+  auto lockInheritedBegin = m_lockInheritedPrims.lower_bound(rootPath);
+  auto lockInheritedEnd = subtreeEnd(lockInheritedBegin, m_lockInheritedPrims.end(), rootPath);
+  for (auto inherited = lockInheritedBegin; inherited != lockInheritedEnd; ++inherited)
   {
-    const SdfPath parentPath = inherited.GetParentPath();
+    const SdfPath parentPath = inherited->GetParentPath();
     if (parentPath.IsEmpty())
       continue;
-    auto parentIter = primsNeedLock.find(parentPath);
-    if (parentIter != primsNeedLock.end())
+    if (m_primsNeedLock.count(parentPath))
     {
-      auto lowerIter = std::lower_bound(parentIter, primsNeedLock.end(), inherited);
-      primsNeedLock.insert(lowerIter, inherited);
+      m_primsNeedLock.insert(*inherited);
     }
   }
 
+  needLockBegin = m_primsNeedLock.lower_bound(rootPath);
+  auto needLockEnd = subtreeEnd(needLockBegin, m_primsNeedLock.end(), rootPath);
+  auto currentLockedBegin = m_currentLockedPrims.lower_bound(rootPath);
+  auto currentLockedEnd = subtreeEnd(currentLockedBegin, m_currentLockedPrims.end(), rootPath);
+
   SdfPathVector primsToLock;
-  primsToLock.reserve(primsNeedLock.size());
   SdfPathVector primsToUnlock;
-  primsToUnlock.reserve(m_currentLockedPrims.size());
-  std::set_difference(primsNeedLock.begin(), primsNeedLock.end(), m_currentLockedPrims.begin(),
-                      m_currentLockedPrims.end(), std::back_inserter(primsToLock));
-  std::set_difference(m_currentLockedPrims.begin(), m_currentLockedPrims.end(), primsNeedLock.begin(),
-                      primsNeedLock.end(), std::back_inserter(primsToUnlock));
+  std::set_difference(needLockBegin, needLockEnd, currentLockedBegin, currentLockedEnd, std::back_inserter(primsToLock));
+  std::set_difference(currentLockedBegin, currentLockedEnd, needLockBegin, needLockEnd, std::back_inserter(primsToUnlock));
 
   for (auto lock : primsToLock)
   {
@@ -1592,6 +1886,10 @@ void ProxyShape::constructLockPrims()
     {
       m_currentLockedPrims.insert(lock);
     }
+    else
+    {
+      m_failedLockPrims.insert(lock);
+    }
   }
   for (auto unlock : primsToUnlock)
   {
@@ -1599,6 +1897,10 @@ void ProxyShape::constructLockPrims()
     {
       m_currentLockedPrims.erase(unlock);
     }
+    else
+    {
+      m_failedLockPrims.insert(unlock);
+    }
   }
 }
 
@@ -1644,6 +1946,8 @@ void ProxyShape::onAttributeChanged(MNodeMessage::AttributeMessage msg, MPlug& p
         {
           proxy->m_path = rootPath;
         }
+        // the cached bounds are those of the previous prim
+        proxy->m_boundingBoxCache.clear();
         proxy->constructGLImagingEngine();
       }
     }
@@ -1744,77 +2048,126 @@ void ProxyShape::findTaggedPrims()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void ProxyShape::findTaggedPrims(const HierarchyIterationLogics& iterationLogics)
+namespace {
+
+/// \brief  Splits the hierarchy below the pseudo root into subtrees that can be visited concurrently. Prims are expanded
+///         breadth first until there are enough subtrees to keep all worker threads busy. The instance masters of the
+///         stage are not children of the pseudo root, so each of them is added as a subtree of its own, which visits
+///         the prims below an instance once per master rather than once per instance.
+/// \param  stage the stage to partition
+/// \param  upperPrims receives the prims above the subtrees, which are not covered by any of them
+/// \param  subtreeRoots receives the roots of the subtrees
+void partitionHierarchy(const UsdStageRefPtr& stage, std::vector<UsdPrim>& upperPrims, std::vector<UsdPrim>& subtreeRoots)
 {
-  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::iteratePrimHierarchy\n");
-  if(!m_stage)
-    return;
+  const size_t minSubtrees = WorkGetConcurrencyLimit() * 8;
+  const uint32_t maxDepth = 4;
 
-  for(auto hl : iterationLogics)
+  for(const UsdPrim& child : stage->GetPseudoRoot().GetChildren())
   {
-    hl->preIteration();
+    subtreeRoots.push_back(child);
   }
-
-  MDagPath m_parentPath;
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
+  for(const UsdPrim& master : stage->GetMasters())
   {
-    const UsdPrim& prim = it.prim();
-    if(!prim.IsValid())
-      continue;
+    subtreeRoots.push_back(master);
+  }
 
-    for(auto hl : iterationLogics)
+  std::vector<UsdPrim> nextSubtreeRoots;
+  for(uint32_t depth = 0; depth < maxDepth && subtreeRoots.size() < minSubtrees; ++depth)
+  {
+    bool expanded = false;
+    nextSubtreeRoots.clear();
+    for(const UsdPrim& prim : subtreeRoots)
     {
-      hl->iteration(it, prim);
+      auto children = prim.GetChildren();
+      if(children.empty())
+      {
+        nextSubtreeRoots.push_back(prim);
+        continue;
+      }
+      upperPrims.push_back(prim);
+      nextSubtreeRoots.insert(nextSubtreeRoots.end(), children.begin(), children.end());
+      expanded = true;
     }
+    if(!expanded)
+    {
+      break;
+    }
+    std::swap(subtreeRoots, nextSubtreeRoots);
   }
+}
 
-  for(auto hl : iterationLogics)
-  {
-    hl->postIteration();
-  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void ProxyShape::findExcludedGeometry()
+void ProxyShape::findTaggedPrims(const HierarchyIterationLogics& iterationLogics)
 {
-  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::findExcludedGeometry\n");
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::iteratePrimHierarchy\n");
   if(!m_stage)
     return;
 
-  m_findExcludedPrims.preIteration();
-  MDagPath m_parentPath;
+  AL_BEGIN_PROFILE_SECTION(FindTaggedPrims);
+
+  std::vector<UsdPrim> upperPrims;
+  std::vector<UsdPrim> subtreeRoots;
+  AL_BEGIN_PROFILE_SECTION(PartitionHierarchy);
+    partitionHierarchy(m_stage, upperPrims, subtreeRoots);
+  AL_END_PROFILE_SECTION();
+
+  // each subtree writes into the slot matching its index, the prims above them use the last slot.
+  const size_t numSlots = subtreeRoots.size() + 1;
+  const size_t upperSlot = subtreeRoots.size();
 
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
+  for(auto hl : iterationLogics)
   {
-    const UsdPrim& prim = it.prim();
-    if(!prim.IsValid())
-      continue;
-    m_findExcludedPrims.iteration(it, prim);
+    hl->preIteration(numSlots);
   }
 
-  m_findExcludedPrims.postIteration();
+  AL_BEGIN_PROFILE_SECTION(IteratePrims);
+    for(const UsdPrim& prim : upperPrims)
+    {
+      for(auto hl : iterationLogics)
+      {
+        hl->iteration(prim, upperSlot);
+      }
+    }
+
+    WorkParallelForN(subtreeRoots.size(), [&subtreeRoots, &iterationLogics](size_t begin, size_t end)
+    {
+      for(size_t slot = begin; slot < end; ++slot)
+      {
+        for(const UsdPrim& prim : UsdPrimRange(subtreeRoots[slot]))
+        {
+          for(auto hl : iterationLogics)
+          {
+            hl->iteration(prim, slot);
+          }
+        }
+      }
+    });
+  AL_END_PROFILE_SECTION();
+
+  AL_BEGIN_PROFILE_SECTION(PostIteration);
+    for(auto hl : iterationLogics)
+    {
+      hl->postIteration();
+    }
+  AL_END_PROFILE_SECTION();
+
+  AL_END_PROFILE_SECTION();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::findExcludedGeometry()
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::findExcludedGeometry\n");
+  findTaggedPrims({ &m_findExcludedPrims });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::findSelectablePrims()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::findSelectablePrims\n");
-  if(!m_stage)
-    return;
-
-  m_findUnselectablePrims.preIteration();
-
-  MDagPath m_parentPath;
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
-  {
-    const UsdPrim& prim = it.prim();
-    if(!prim.IsValid())
-      continue;
-
-    m_findUnselectablePrims.iteration(it, prim);
-  }
-
-  m_findUnselectablePrims.postIteration();
+  findTaggedPrims({ &m_findUnselectablePrims });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1883,9 +2236,42 @@ MStatus ProxyShape::computeOutputTime(const MPlug& plug, MDataBlock& dataBlock,
   MTime inTimeOffset = inputTimeValue(dataBlock, m_timeOffset);
   double inTimeScalar = inputDoubleValue(dataBlock, m_timeScalar);
   currentTime.setValue((inTime.as(MTime::uiUnit()) - inTimeOffset.as(MTime::uiUnit())) * inTimeScalar);
+
+  // the transforms are connected to the output time, so sampling them here guarantees the cache is filled before any
+  // of them evaluate
+  prefetchTransformSamples(currentTime, inputInt32Value(dataBlock, m_transformPrefetchFrames));
   return outputTimeValue(dataBlock, m_outTime, currentTime);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::prefetchTransformSamples(const MTime& currentTime, int32_t prefetchFrames)
+{
+  if(prefetchFrames <= 0 || !m_stage || m_requiredPaths.empty())
+  {
+    return;
+  }
+
+  const double startTime = currentTime.as(MTime::uiUnit());
+  if(m_transformSampleCache.contains(UsdTimeCode(startTime)))
+  {
+    return;
+  }
+
+  double endTime = startTime + prefetchFrames;
+  if(m_stage->HasAuthoredTimeCodeRange())
+  {
+    endTime = std::min(endTime, m_stage->GetEndTimeCode());
+  }
+
+  SdfPathVector paths;
+  paths.reserve(m_requiredPaths.size());
+  for(const auto& it : m_requiredPaths)
+  {
+    paths.push_back(it.first);
+  }
+  m_transformSampleCache.prefetch(m_stage, paths, startTime, endTime);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus ProxyShape::compute(const MPlug& plug, MDataBlock& dataBlock)
 {
@@ -1928,71 +2314,28 @@ MBoundingBox ProxyShape::boundingBox() const
   (void)outDataHandle;
   CHECK_MSTATUS_AND_RETURN(status, MBoundingBox() );
 
-  // XXX:aluk
-  // If we could cheaply determine whether a stage only has static geometry,
-  // we could make this value a constant one for that case, avoiding the
-  // memory overhead of a cache entry per frame
   UsdTimeCode currTime = UsdTimeCode(inputDoubleValue(dataBlock, m_outTime));
 
-  // RB: There must be a nicer way of doing this that avoids the map?
-  // The time codes are likely to be ranged, so an ordered array + binary search would surely work?
-  std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup = m_boundingBoxCache.find(currTime);
-  if (cacheLookup != m_boundingBoxCache.end())
+  UsdPrim prim = getUsdPrim(dataBlock);
+  if (!prim)
   {
-    return cacheLookup->second;
+    return MBoundingBox();
   }
 
-  GfBBox3d allBox;
-  UsdPrim prim = getUsdPrim(dataBlock);
-  if (prim)
+  TfTokenVector purposes = { UsdGeomTokens->default_, UsdGeomTokens->proxy };
+  if (inputBoolValue(dataBlock, m_displayGuides))
   {
-    UsdGeomImageable imageablePrim(prim);
-    bool showGuides = inputBoolValue(dataBlock, m_displayGuides);
-    bool showRenderGuides = inputBoolValue(dataBlock, m_displayRenderGuides);
-    if (showGuides && showRenderGuides)
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy,
-            UsdGeomTokens->guide,
-            UsdGeomTokens->render);
-    }
-    else
-    if (showGuides && !showRenderGuides)
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy,
-            UsdGeomTokens->guide);
-    }
-    else if (!showGuides && showRenderGuides)
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy,
-            UsdGeomTokens->render);
-    }
-    else
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy);
-    }
+    purposes.push_back(UsdGeomTokens->guide);
   }
-  else
+  if (inputBoolValue(dataBlock, m_displayRenderGuides))
   {
-    return MBoundingBox();
+    purposes.push_back(UsdGeomTokens->render);
   }
 
-  // insert new cache entry
-  MBoundingBox& retval = m_boundingBoxCache[currTime];
+  MBoundingBox retval;
 
   // Convert to GfRange3d to MBoundingBox
-  GfRange3d boxRange = allBox.ComputeAlignedBox();
+  GfRange3d boxRange = m_boundingBoxCache.bound(prim, currTime, purposes);
   if (!boxRange.IsEmpty())
   {
     retval = MBoundingBox(MPoint(boxRange.GetMin()[0],
@@ -24,7 +24,9 @@
 #include "AL/event/EventHandler.h"
 #include "AL/maya/event/MayaEventManager.h"
 #include <AL/usdmaya/SelectabilityDB.h>
+#include "AL/usdmaya/BoundingBoxCache.h"
 #include "AL/usdmaya/DrivenTransformsData.h"
+#include "AL/usdmaya/TransformSampleCache.h"
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/fileio/translators/TransformTranslator.h"
@@ -38,8 +40,12 @@
 #include "maya/MObjectArray.h"
 #include "maya/MSelectionList.h"
 #include "pxr/pxr.h"
+#include "pxr/usd/ar/resolverContext.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/stagePopulationMask.h"
 #include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/base/tf/weakBase.h"
 #include "pxr/usd/usd/notice.h"
@@ -47,6 +53,7 @@
 #include "pxr/usdImaging/usdImagingGL/renderParams.h"
 #include <stack>
 #include <functional>
+#include <vector>
 #include "AL/usd/utils/ForwardDeclares.h"
 
 #if defined(WANT_UFE_BUILD)
@@ -198,7 +205,10 @@ private:
 };
 
 //----------------------------------------------------------------------------------------------------------------------
-/// \brief  A class that provides the logic behind a hierarchy traversal through a UsdStage
+/// \brief  A class that provides the logic behind a hierarchy traversal through a UsdStage.
+///         The stage hierarchy is split into subtrees that are visited concurrently. Each subtree (plus one extra for
+///         the prims above the subtrees) is given its own result slot, so the iteration method only ever needs to
+///         write into the results of the slot it has been given, and merge all of them in the postIteration method.
 //----------------------------------------------------------------------------------------------------------------------
 struct  HierarchyIterationLogic
 {
@@ -209,16 +219,27 @@ struct  HierarchyIterationLogic
       postIteration(nullptr)
   {}
 
-  /// \brief  provide a method to be called prior to iteration of the UsdStage hierarchy
-  std::function<void()> preIteration;
+  /// \brief  provide a method to be called on the main thread prior to iteration of the UsdStage hierarchy. It is
+  ///         passed the number of result slots the iteration method will be called with.
+  std::function<void(size_t numSlots)> preIteration;
 
-  /// \brief  a visitor method that is called on each of the UsdPrims in the stage hierarchy
-  std::function<void(const fileio::TransformIterator& transformIterator,const UsdPrim& prim)> iteration;
+  /// \brief  a visitor method that is called on each of the UsdPrims in the stage hierarchy. It may be called from
+  ///         several worker threads at once, but never concurrently for the same slot. It must not modify the stage.
+  std::function<void(const UsdPrim& prim, size_t slot)> iteration;
 
-  /// \brief  provide a method to be called after iteration of the UsdStage hierarchy
+  /// \brief  provide a method to be called on the main thread after iteration of the UsdStage hierarchy
   std::function<void()> postIteration;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  implements the logic required when searching for prims that are excluded from the proxy shape
+//----------------------------------------------------------------------------------------------------------------------
+struct FindExcludedPrimsLogic
+  : public HierarchyIterationLogic
+{
+  std::vector<SdfPathVector> excludedPrims; ///< per slot, the prims tagged as excluded
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  implements the logic that constructs a list of objects that need to be added or removed from the selectable
 ///         list of prims within a UsdStage
@@ -226,8 +247,8 @@ struct  HierarchyIterationLogic
 struct FindUnselectablePrimsLogic
   : public HierarchyIterationLogic
 {
-  SdfPathVector newUnselectables; ///< items that need to be made unselectable
-  SdfPathVector removeUnselectables; ///< items that are unselectable, but need to be made selectable
+  std::vector<SdfPathVector> newUnselectables; ///< per slot, items that need to be made unselectable
+  std::vector<SdfPathVector> removeUnselectables; ///< per slot, items that are unselectable, but need to be made selectable
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -236,9 +257,11 @@ struct FindUnselectablePrimsLogic
 struct FindLockedPrimsLogic
   : public HierarchyIterationLogic
 {
+  std::vector<SdfPathVector> lockTransformPrims; ///< per slot, prims whose transform is locked
+  std::vector<SdfPathVector> lockInheritedPrims; ///< per slot, prims that inherit the lock state of their parent
 };
 
-typedef const HierarchyIterationLogic*  HierarchyIterationLogics[3];
+typedef std::vector<const HierarchyIterationLogic*> HierarchyIterationLogics;
 typedef std::unordered_map<SdfPath, MString, SdfPath::Hash > PrimPathToDagPath;
 
 extern AL::event::EventId kPreClearStageCache;
@@ -314,6 +337,10 @@ public:
   /// values) the playback of the animation.
   AL_DECL_ATTRIBUTE(timeScalar);
 
+  /// the number of frames past the current time for which the animated transforms are sampled in parallel when the
+  /// current time is not already cached. Zero (the default) disables the prefetch.
+  AL_DECL_ATTRIBUTE(transformPrefetchFrames);
+
   /// the subdiv complexity used
   AL_DECL_ATTRIBUTE(complexity);
 
@@ -640,6 +667,9 @@ public:
   AL_USDMAYA_PUBLIC
   void findTaggedPrims();
 
+  /// \brief runs all of the specified iteration logics in a single pass over the stage hierarchy, with the subtrees of
+  ///        the hierarchy visited in parallel
+  /// \param iterationLogics the logics to run
   AL_USDMAYA_PUBLIC
   void findTaggedPrims(const HierarchyIterationLogics& iterationLogics);
 
@@ -783,6 +813,7 @@ public:
       return;
     }
     m_compositionHasChanged = true;
+    m_compositionChangeIsVariantSwitch = false;
     m_changedPath = changePath;
     onPrePrimChanged(m_changedPath, m_variantSwitchedPrims);
   }
@@ -790,7 +821,7 @@ public:
   /// \brief  change the status of the composition changed status
   /// \param  hasObjectsChanged
   inline void setHaveObjectsChangedAtPath(bool hasObjectsChanged)
-    { m_compositionHasChanged = hasObjectsChanged; }
+    { m_compositionHasChanged = hasObjectsChanged; m_compositionChangeIsVariantSwitch = false; }
 
   /// \brief  provides access to the selection list on this proxy shape
   /// \return the internal selection list
@@ -816,6 +847,21 @@ public:
   AL_USDMAYA_PUBLIC
   void loadStage();
 
+  /// \brief  reloads the stages of the specified proxy shapes, as loadStage does for each of them, but opens the
+  ///         stages concurrently. The inputs of each proxy shape are read, and the opened stages are handed back to
+  ///         the proxy shapes, one at a time on the calling thread, so only the opening of the layers and the
+  ///         composition of the stages happen in parallel. Each stage is opened with its own asset resolver context,
+  ///         built from the assetResolverConfig (or the file path) of its proxy shape.
+  ///         Every proxy shape still receives one PreStageLoaded and one PostStageLoaded event, but they are no longer
+  ///         adjacent: the PreStageLoaded events of all of the proxy shapes are triggered before any stage is opened,
+  ///         and each PostStageLoaded event is triggered once the stage has been handed back to its proxy shape.
+  ///         If the AL_usdmaya_parallelStageLoad optionVar is 0, the stages are opened one at a time instead, and
+  ///         ArResolver::ConfigureResolverForAsset is called right before each one is opened, as loadStage does. This
+  ///         is for asset resolvers that rely on being configured rather than on the context of each stage.
+  /// \param  proxies the proxy shapes to reload
+  AL_USDMAYA_PUBLIC
+  static void loadStages(const std::vector<ProxyShape*>& proxies);
+
   /// \brief  adds the attribute changed callback to the proxy shape
   AL_USDMAYA_PUBLIC
   void addAttributeChangedCallback();
@@ -824,6 +870,8 @@ public:
   AL_USDMAYA_PUBLIC
   void removeAttributeChangedCallback();
 
+  /// \brief  recomputes which prims need their transform locked across the whole stage, and locks or unlocks the
+  ///         corresponding maya transforms
   AL_USDMAYA_PUBLIC
   void constructLockPrims();
 
@@ -870,6 +918,10 @@ public:
   inline void clearBoundingBoxCache()
     { m_boundingBoxCache.clear(); }
 
+  /// \brief  Returns the cache of the animated transform values shared by the transforms of the shape
+  inline const TransformSampleCache& transformSampleCache() const
+    { return m_transformSampleCache; }
+
 private:
 
   static void onSelectionChanged(void* ptr);
@@ -880,6 +932,8 @@ private:
   void constructExcludedPrims();
   bool updateLockPrims(const SdfPathSet& lockTransformPrims, const SdfPathSet& lockInheritedPrims,
                        const SdfPathSet& unlockedPrims);
+  void constructLockPrims(const SdfPathSet& changedPaths);
+  void constructLockPrimsInSubtree(const SdfPath& rootPath);
   bool lockTransformAttribute(const SdfPath& path, bool lock);
 
   MObject makeUsdTransformChain_internal(
@@ -998,6 +1052,7 @@ private:
   MStatus computeInStageDataCached(const MPlug& plug, MDataBlock& dataBlock);
   MStatus computeOutStageData(const MPlug& plug, MDataBlock& dataBlock);
   MStatus computeOutputTime(const MPlug& plug, MDataBlock& dataBlock, MTime&);
+  void prefetchTransformSamples(const MTime& currentTime, int32_t prefetchFrames);
   MStatus computeDrivenAttributes(const MPlug& plug, MDataBlock& dataBlock, const MTime&);
 
   //--------------------------------------------------------------------------------------------------------------------
@@ -1008,6 +1063,22 @@ private:
   SdfPathVector getExcludePrimPaths() const;
   UsdStagePopulationMask constructStagePopulationMask(const MString &paths) const;
 
+  /// the inputs needed to open the stage of the proxy shape, which are read on the main thread
+  struct StageLoadRequest
+  {
+    std::string filePath;
+    std::string resolverConfig; ///< the assetResolverConfig of the proxy shape, or the file path if that is empty
+    ArResolverContext resolverContext; ///< the context built from resolverConfig, unless configureResolver is set
+    bool configureResolver = false; ///< configure the resolver with resolverConfig, rather than building a context
+    SdfLayerRefPtr sessionLayer;
+    UsdStagePopulationMask mask;
+    UsdStage::InitialLoadSet loadSet = UsdStage::LoadAll;
+  };
+  void beginLoadStage(StageLoadRequest& request);
+  static UsdStageRefPtr openStage(const StageLoadRequest& request);
+  static UsdStageRefPtr openStageWithConfiguredResolver(const StageLoadRequest& request);
+  void endLoadStage(const StageLoadRequest& request, const UsdStageRefPtr& stage);
+
   bool isStageValid() const;
   bool primHasExcludedParent(UsdPrim prim);
   bool initPrim(const uint32_t index, MDGContext& ctx);
@@ -1035,13 +1106,16 @@ private:
       return translator != 0;
     }
 
+  size_t getCompositionHashForPath(const SdfPath& path) override
+    { return m_context->getCompositionHashForPath(path); }
+
 private:
   SdfPathVector m_pathsOrdered;
   static std::vector<MObjectHandle> m_unloadedProxyShapes;
 
   AL::usdmaya::SelectabilityDB m_selectabilityDB;
   HierarchyIterationLogics m_hierarchyIterationLogics;
-  HierarchyIterationLogic m_findExcludedPrims;
+  FindExcludedPrimsLogic m_findExcludedPrims;
   SelectionList m_selectionList;
   FindUnselectablePrimsLogic m_findUnselectablePrims;
   SdfPathHashSet m_selectedPaths;
@@ -1053,7 +1127,8 @@ private:
   TfNotice::Key m_variantChangedNoticeKey;
   TfNotice::Key m_editTargetChanged;
 
-  mutable std::map<UsdTimeCode, MBoundingBox> m_boundingBoxCache;
+  mutable BoundingBoxCache m_boundingBoxCache;
+  TransformSampleCache m_transformSampleCache;
   AL::event::CallbackId m_beforeSaveSceneId = -1;
   MCallbackId m_attributeChanged = 0;
   MCallbackId m_onSelectionChanged = 0;
@@ -1061,6 +1136,8 @@ private:
   SdfPathVector m_excludedTaggedGeometry;
   SdfPathSet m_lockTransformPrims;
   SdfPathSet m_lockInheritedPrims;
+  SdfPathSet m_primsNeedLock;
+  SdfPathSet m_failedLockPrims;
   SdfPathSet m_currentLockedPrims;
   static MObject m_transformTranslate;
   static MObject m_transformRotate;
@@ -1076,6 +1153,9 @@ private:
 
   uint32_t m_engineRefCount = 0;
   bool m_compositionHasChanged = false;
+  // true if the pending composition change only switched variants or toggled prims active, which leaves the contents
+  // of the specs alone, so that the prims whose composition hash is unchanged don't need translating again
+  bool m_compositionChangeIsVariantSwitch = false;
   bool m_drivenTransformsDirty = false;
   bool m_pleaseIgnoreSelection = false;
   bool m_hasChangedSelection = false;
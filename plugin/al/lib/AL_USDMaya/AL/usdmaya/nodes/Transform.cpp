@@ -23,6 +23,7 @@
 #include "maya/MBoundingBox.h"
 #include "maya/MDataBlock.h"
 #include "maya/MEvaluationNodeIterator.h"
+#include "maya/MFnDependencyNode.h"
 #include "maya/MGlobal.h"
 #include "maya/MNodeMessage.h"
 #include "maya/MPlugArray.h"
@@ -247,9 +248,22 @@ void Transform::updateTransform(MDataBlock& dataBlock)
 
   UsdTimeCode usdTime(theTime.as(MTime::uiUnit()));
 
+  // the proxy shape may have pre-sampled the animated transforms for a window of frames around this time
+  const AL::usdmaya::TransformSampleCache* sampleCache = 0;
+  MObject proxyShapeNode = getProxyShape();
+  if(!proxyShapeNode.isNull())
+  {
+    MFnDependencyNode fn(proxyShapeNode);
+    ProxyShape* proxyShape = (ProxyShape*)fn.userNode();
+    if(proxyShape)
+    {
+      sampleCache = &proxyShape->transformSampleCache();
+    }
+  }
+
   // update the transformation matrix to the values at the specified time
   TransformationMatrix* m = transform();
-  m->updateToTime(usdTime);
+  m->updateToTime(usdTime, sampleCache);
 
   // if translation animation is present, update the translate attribute (or just flag it as clean if no animation exists)
   if(m->hasAnimatedTranslation())
@@ -33,6 +33,11 @@ namespace nodes {
 
 using AL::usdmaya::utils::UsdDataType;
 
+namespace {
+// the edit count of a transformation matrix whose sampler hasn't been built yet
+const size_t kSamplerNotBuilt = ~size_t(0);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 const MTypeId TransformationMatrix::kTypeId(AL_USDMAYA_TRANSFORMATION_MATRIX);
 
@@ -48,6 +53,7 @@ TransformationMatrix::TransformationMatrix()
     m_prim(),
     m_xform(),
     m_time(UsdTimeCode::Default()),
+    m_samplerEditCount(kSamplerNotBuilt),
     m_scaleTweak(0, 0, 0),
     m_rotationTweak(0, 0, 0),
     m_translationTweak(0, 0, 0),
@@ -79,6 +85,7 @@ TransformationMatrix::TransformationMatrix(const UsdPrim& prim)
     m_prim(prim),
     m_xform(prim),
     m_time(UsdTimeCode::Default()),
+    m_samplerEditCount(kSamplerNotBuilt),
     m_scaleTweak(0, 0, 0),
     m_rotationTweak(0, 0, 0),
     m_translationTweak(0, 0, 0),
@@ -119,6 +126,7 @@ void TransformationMatrix::setPrim(const UsdPrim& prim, Transform* transformNode
     TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::setPrim null\n");
     m_prim = UsdPrim();
     m_xform = UsdGeomXform();
+    m_sampler.clear();
   }
   // Most of these flags are calculated based on reading the usd prim; however, a few are driven
   // "externally" (ie, from attributes on the controlling transform node), and should NOT be reset
@@ -163,70 +171,10 @@ void TransformationMatrix::setPrim(const UsdPrim& prim, Transform* transformNode
 bool TransformationMatrix::readVector(MVector& result, const UsdGeomXformOp& op, UsdTimeCode timeCode)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readVector\n");
-  const SdfValueTypeName vtn = op.GetTypeName();
-  UsdDataType attr_type = AL::usdmaya::utils::getAttributeType(vtn);
-  switch(attr_type)
+  if(!xformop::readVector(result, op, AL::usdmaya::utils::getAttributeType(op.GetTypeName()), timeCode))
   {
-  case UsdDataType::kVec3d:
-    {
-      GfVec3d value;
-      const bool retValue = op.GetAs<GfVec3d>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = value[0];
-      result.y = value[1];
-      result.z = value[2];
-    }
-    break;
-
-  case UsdDataType::kVec3f:
-    {
-      GfVec3f value;
-      const bool retValue = op.GetAs<GfVec3f>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = double(value[0]);
-      result.y = double(value[1]);
-      result.z = double(value[2]);
-    }
-    break;
-
-  case UsdDataType::kVec3h:
-    {
-      GfVec3h value;
-      const bool retValue = op.GetAs<GfVec3h>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = double(value[0]);
-      result.y = double(value[1]);
-      result.z = double(value[2]);
-    }
-    break;
-
-  case UsdDataType::kVec3i:
-    {
-      GfVec3i value;
-      const bool retValue = op.GetAs<GfVec3i>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = double(value[0]);
-      result.y = double(value[1]);
-      result.z = double(value[2]);
-    }
-    break;
-
-  default:
     return false;
   }
-
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readVector %f %f %f\n%s\n", result.x, result.y, result.z, op.GetOpName().GetText());
   return true;
 }
@@ -319,27 +267,14 @@ bool TransformationMatrix::pushShear(const MVector& result, UsdGeomXformOp& op,
 bool TransformationMatrix::readShear(MVector& result, const UsdGeomXformOp& op, UsdTimeCode timeCode)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readShear\n");
-  const SdfValueTypeName vtn = op.GetTypeName();
-  UsdDataType attr_type = AL::usdmaya::utils::getAttributeType(vtn);
-  switch(attr_type)
+  GfMatrix4d value;
+  if(!xformop::readMatrix(value, op, AL::usdmaya::utils::getAttributeType(op.GetTypeName()), timeCode))
   {
-  case UsdDataType::kMatrix4d:
-    {
-      GfMatrix4d value;
-      const bool retValue = op.GetAs<GfMatrix4d>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = value[1][0];
-      result.y = value[2][0];
-      result.z = value[2][1];
-    }
-    break;
-
-  default:
     return false;
   }
+  result.x = value[1][0];
+  result.y = value[2][0];
+  result.z = value[2][1];
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readShear %f %f %f\n%s\n", result.x, result.y, result.z, op.GetOpName().GetText());
   return true;
 }
@@ -348,69 +283,14 @@ bool TransformationMatrix::readShear(MVector& result, const UsdGeomXformOp& op,
 bool TransformationMatrix::readPoint(MPoint& result, const UsdGeomXformOp& op, UsdTimeCode timeCode)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readPoint\n");
-  const SdfValueTypeName vtn = op.GetTypeName();
-  UsdDataType attr_type = AL::usdmaya::utils::getAttributeType(vtn);
-  switch(attr_type)
+  MVector value;
+  if(!xformop::readVector(value, op, AL::usdmaya::utils::getAttributeType(op.GetTypeName()), timeCode))
   {
-  case UsdDataType::kVec3d:
-    {
-      GfVec3d value;
-      const bool retValue = op.GetAs<GfVec3d>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = value[0];
-      result.y = value[1];
-      result.z = value[2];
-    }
-    break;
-
-  case UsdDataType::kVec3f:
-    {
-      GfVec3f value;
-      const bool retValue = op.GetAs<GfVec3f>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = double(value[0]);
-      result.y = double(value[1]);
-      result.z = double(value[2]);
-    }
-    break;
-
-  case UsdDataType::kVec3h:
-    {
-      GfVec3h value;
-      const bool retValue = op.GetAs<GfVec3h>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = double(value[0]);
-      result.y = double(value[1]);
-      result.z = double(value[2]);
-    }
-    break;
-
-  case UsdDataType::kVec3i:
-    {
-      GfVec3i value;
-      const bool retValue = op.GetAs<GfVec3i>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      result.x = double(value[0]);
-      result.y = double(value[1]);
-      result.z = double(value[2]);
-    }
-    break;
-
-  default:
     return false;
   }
+  result.x = value.x;
+  result.y = value.y;
+  result.z = value.z;
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readPoint %f %f %f\n%s\n", result.x, result.y, result.z, op.GetOpName().GetText());
 
   return true;
@@ -420,28 +300,14 @@ bool TransformationMatrix::readPoint(MPoint& result, const UsdGeomXformOp& op, U
 bool TransformationMatrix::readMatrix(MMatrix& result, const UsdGeomXformOp& op, UsdTimeCode timeCode)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readMatrix\n");
-  const SdfValueTypeName vtn = op.GetTypeName();
-  UsdDataType attr_type = AL::usdmaya::utils::getAttributeType(vtn);
-  switch(attr_type)
+  GfMatrix4d value;
+  if(!xformop::readMatrix(value, op, AL::usdmaya::utils::getAttributeType(op.GetTypeName()), timeCode))
   {
-  case UsdDataType::kMatrix4d:
-    {
-      GfMatrix4d value;
-      const bool retValue = op.GetAs<GfMatrix4d>(&value, timeCode);
-      if (!retValue)
-      {
-        return false;
-      }
-      auto vtemp = (const void*)&value;
-      auto mtemp = (const MMatrix*)vtemp;
-      result = *mtemp;
-    }
-    break;
-
-  default:
     return false;
   }
-
+  auto vtemp = (const void*)&value;
+  auto mtemp = (const MMatrix*)vtemp;
+  result = *mtemp;
   return true;
 }
 
@@ -536,56 +402,7 @@ double TransformationMatrix::readDouble(const UsdGeomXformOp& op, UsdTimeCode ti
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readDouble\n");
   double result = 0;
-  UsdDataType attr_type = AL::usdmaya::utils::getAttributeType(op.GetTypeName());
-  switch(attr_type)
-  {
-  case UsdDataType::kHalf:
-    {
-      GfHalf value;
-      const bool retValue = op.Get<GfHalf>(&value, timeCode);
-      if (retValue)
-      {
-        result = float(value);
-      }
-    }
-    break;
-
-  case UsdDataType::kFloat:
-    {
-      float value;
-      const bool retValue = op.Get<float>(&value, timeCode);
-      if (retValue)
-      {
-        result = double(value);
-      }
-    }
-    break;
-
-  case UsdDataType::kDouble:
-    {
-      double value;
-      const bool retValue = op.Get<double>(&value, timeCode);
-      if (retValue)
-      {
-        result = value;
-      }
-    }
-    break;
-
-  case UsdDataType::kInt:
-    {
-      int32_t value;
-      const bool retValue = op.Get<int32_t>(&value, timeCode);
-      if (retValue)
-      {
-        result = double(value);
-      }
-    }
-    break;
-
-  default:
-    break;
-  }
+  xformop::readDouble(result, op, AL::usdmaya::utils::getAttributeType(op.GetTypeName()), timeCode);
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readDouble %f\n%s\n", result, op.GetOpName().GetText());
   return result;
 }
@@ -642,130 +459,7 @@ void TransformationMatrix::pushDouble(const double value, UsdGeomXformOp& op, Us
 bool TransformationMatrix::readRotation(MEulerRotation& result, const UsdGeomXformOp& op, UsdTimeCode timeCode)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::readRotation %f %f %f\n%s\n", result.x, result.y, result.z, op.GetOpName().GetText());
-  const double degToRad = 3.141592654 / 180.0;
-  switch(op.GetOpType())
-  {
-  case UsdGeomXformOp::TypeRotateX:
-    {
-      result.x = readDouble(op, timeCode) * degToRad;
-      result.y = 0.0;
-      result.z = 0.0;
-      result.order = MEulerRotation::kXYZ;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateY:
-    {
-      result.x = 0.0;
-      result.y = readDouble(op, timeCode) * degToRad;
-      result.z = 0.0;
-      result.order = MEulerRotation::kXYZ;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateZ:
-    {
-      result.x = 0.0;
-      result.y = 0.0;
-      result.z = readDouble(op, timeCode) * degToRad;
-      result.order = MEulerRotation::kXYZ;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateXYZ:
-    {
-      MVector v;
-      if(readVector(v, op, timeCode))
-      {
-        result.x = v.x * degToRad;
-        result.y = v.y * degToRad;
-        result.z = v.z * degToRad;
-        result.order = MEulerRotation::kXYZ;
-      }
-      else
-        return false;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateXZY:
-    {
-      MVector v;
-      if(readVector(v, op, timeCode))
-      {
-        result.x = v.x * degToRad;
-        result.y = v.y * degToRad;
-        result.z = v.z * degToRad;
-        result.order = MEulerRotation::kXZY;
-      }
-      else
-        return false;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateYXZ:
-    {
-      MVector v;
-      if(readVector(v, op, timeCode))
-      {
-        result.x = v.x * degToRad;
-        result.y = v.y * degToRad;
-        result.z = v.z * degToRad;
-        result.order = MEulerRotation::kYXZ;
-      }
-      else
-        return false;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateYZX:
-    {
-      MVector v;
-      if(readVector(v, op, timeCode))
-      {
-        result.x = v.x * degToRad;
-        result.y = v.y * degToRad;
-        result.z = v.z * degToRad;
-        result.order = MEulerRotation::kYZX;
-      }
-      else
-        return false;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateZXY:
-    {
-      MVector v;
-      if(readVector(v, op, timeCode))
-      {
-        result.x = v.x * degToRad;
-        result.y = v.y * degToRad;
-        result.z = v.z * degToRad;
-        result.order = MEulerRotation::kZXY;
-      }
-      else
-        return false;
-    }
-    break;
-
-  case UsdGeomXformOp::TypeRotateZYX:
-    {
-      MVector v;
-      if(readVector(v, op, timeCode))
-      {
-        result.x = v.x * degToRad;
-        result.y = v.y * degToRad;
-        result.z = v.z * degToRad;
-        result.order = MEulerRotation::kZYX;
-      }
-      else
-        return false;
-    }
-    break;
-
-  default:
-    return false;
-  }
-  return true;
+  return xformop::readRotation(result, op, op.GetOpType(), AL::usdmaya::utils::getAttributeType(op.GetTypeName()), timeCode);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1074,6 +768,10 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Transform* transf
     }
   }
 
+  // the value resolution of the animated ops is cached the next time the prim is sampled
+  m_sampler.clear();
+  m_samplerEditCount = kSamplerNotBuilt;
+
   // if some animation keys are found on the transform ops, assume we have a read only viewer of the transform data.
   if(m_flags & kAnimationMask)
   {
@@ -1083,7 +781,7 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Transform* transf
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void TransformationMatrix::updateToTime(const UsdTimeCode& time)
+void TransformationMatrix::updateToTime(const UsdTimeCode& time, const TransformSampleCache* sampleCache)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::updateToTime %f\n", time.GetValue());
   // if not yet initialized, do not execute this code! (It will crash!).
@@ -1092,86 +790,58 @@ void TransformationMatrix::updateToTime(const UsdTimeCode& time)
     return;
   }
 
-  if(m_time != time)
+  const size_t editCount = sampleCache ? sampleCache->editCount(m_prim.GetPath()) : 0;
+  const bool samplerStale = hasAnimation() && editCount != m_samplerEditCount;
+  if(m_time != time || samplerStale)
   {
     m_time = time;
     if(hasAnimation())
     {
-      auto opIt = m_orderedOps.begin();
-      for(std::vector<UsdGeomXformOp>::const_iterator it = m_xformops.begin(), e = m_xformops.end(); it != e; ++it, ++opIt)
+      // cache the value resolution of the animated ops, so that it isn't repeated every time the time changes. The
+      // attribute queries are rebuilt once the transform ops of the prim have been edited.
+      if(samplerStale)
       {
-        const UsdGeomXformOp& op = *it;
-        switch(*opIt)
-        {
-        case kTranslate:
-          {
-            if(hasAnimatedTranslation())
-            {
-              internal_readVector(m_translationFromUsd, op);
-              MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
-            }
-          }
-          break;
+        m_sampler.init(m_xformops, m_orderedOps);
+        m_samplerEditCount = editCount;
+      }
 
-        case kRotate:
-          {
-            if(hasAnimatedRotation())
-            {
-              internal_readRotation(m_rotationFromUsd, op);
-              MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
-              MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
-              MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
-              MPxTransformationMatrix::rotationValue.z += m_rotationTweak.z;
-            }
-          }
-          break;
+      TransformSample sample;
+      sample.translation = m_translationFromUsd;
+      sample.rotation = m_rotationFromUsd;
+      sample.scale = m_scaleFromUsd;
+      sample.shear = m_shearFromUsd;
 
-        case kScale:
-          {
-            if(hasAnimatedScale())
-            {
-              internal_readVector(m_scaleFromUsd, op);
-              MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
-            }
-          }
-          break;
+      // when scrubbing within the window of the shared cache, the values have already been read
+      if(!sampleCache || !sampleCache->lookup(m_prim.GetPath(), getTimeCode(), sample))
+      {
+        m_sampler.sample(sample, getTimeCode());
+      }
 
-        case kShear:
-          {
-            if(hasAnimatedShear())
-            {
-              internal_readShear(m_shearFromUsd, op);
-              MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
-            }
-          }
-          break;
+      if(hasAnimatedTranslation() || hasAnimatedMatrix())
+      {
+        m_translationFromUsd = sample.translation;
+        MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
+      }
 
-        case kTransform:
-          {
-            if(hasAnimatedMatrix())
-            {
-              GfMatrix4d matrix;
-              op.Get<GfMatrix4d>(&matrix, getTimeCode());
-              double T[3], S[3];
-              AL::usdmaya::utils::matrixToSRT(matrix, S, m_rotationFromUsd, T);
-              m_scaleFromUsd.x = S[0];
-              m_scaleFromUsd.y = S[1];
-              m_scaleFromUsd.z = S[2];
-              m_translationFromUsd.x = T[0];
-              m_translationFromUsd.y = T[1];
-              m_translationFromUsd.z = T[2];
-              MPxTransformationMatrix::rotationValue.x = m_rotationFromUsd.x + m_rotationTweak.x;
-              MPxTransformationMatrix::rotationValue.y = m_rotationFromUsd.y + m_rotationTweak.y;
-              MPxTransformationMatrix::rotationValue.z = m_rotationFromUsd.z + m_rotationTweak.z;
-              MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
-              MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
-            }
-          }
-          break;
+      if(hasAnimatedRotation() || hasAnimatedMatrix())
+      {
+        m_rotationFromUsd = sample.rotation;
+        MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
+        MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
+        MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
+        MPxTransformationMatrix::rotationValue.z += m_rotationTweak.z;
+      }
 
-        default:
-          break;
-        }
+      if(hasAnimatedScale() || hasAnimatedMatrix())
+      {
+        m_scaleFromUsd = sample.scale;
+        MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
+      }
+
+      if(hasAnimatedShear())
+      {
+        m_shearFromUsd = sample.shear;
+        MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
       }
     }
   }
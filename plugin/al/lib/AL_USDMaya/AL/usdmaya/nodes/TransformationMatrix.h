@@ -18,6 +18,7 @@
 #include "../Api.h"
 
 #include "AL/usdmaya/TransformOperation.h"
+#include "AL/usdmaya/TransformSampleCache.h"
 
 #include "maya/MPxTransformationMatrix.h"
 #include "maya/MPxTransform.h"
@@ -46,6 +47,9 @@ class TransformationMatrix
   UsdTimeCode m_time;
   std::vector<UsdGeomXformOp> m_xformops;
   std::vector<TransformOperation> m_orderedOps;
+  TransformSampler m_sampler;
+  // the edit count of the prim (see TransformSampleCache::editCount) when the queries of m_sampler were built
+  size_t m_samplerEditCount;
   MObject m_transformNode;
 
   // tweak values. These are applied on top of the USD transform values to produce the final result.
@@ -415,7 +419,10 @@ public:
   /// \brief  this method updates the internal transformation components to the given time. Only the Transform node
   ///         should need to call this method
   /// \param  time the new timecode
-  void updateToTime(const UsdTimeCode& time);
+  /// \param  sampleCache an optional cache of pre-sampled transform values shared by the transforms of a proxy shape.
+  ///         If it holds the values of the prim at the new time, they are used rather than reading the prim. It also
+  ///         tracks the edits of the prim, after which the values are read again even if the time hasn't changed.
+  void updateToTime(const UsdTimeCode& time, const TransformSampleCache* sampleCache = nullptr);
 
   /// \brief  pushes any modifications on the matrix back onto the UsdPrim
   void pushToPrim();
@@ -3,98 +3,254 @@
 #include "AL/usdmaya/nodes/proxy/DrivenTransforms.h"
 #include "AL/usdmaya/DebugCodes.h"
 
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/tokens.h"
+
+#include <algorithm>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
 namespace proxy {
 
+//----------------------------------------------------------------------------------------------------------------------
+DrivenTransforms& DrivenTransforms::operator = (const DrivenTransforms& other)
+{
+  if (this != &other)
+  {
+    m_drivenPrimPaths = other.m_drivenPrimPaths;
+    m_drivenMatrix = other.m_drivenMatrix;
+    m_drivenVisibility = other.m_drivenVisibility;
+    m_dirtyMatrices = other.m_dirtyMatrices;
+    m_dirtyVisibilities = other.m_dirtyVisibilities;
+    clearResolvedPrims();
+  }
+  return *this;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void DrivenTransforms::resizeDrivenTransforms(const size_t primPathCount)
 {
   m_drivenPrimPaths.resize(primPathCount);
   m_drivenMatrix.resize(primPathCount, MMatrix::identity);
   m_drivenVisibility.resize(primPathCount, true);
+  clearResolvedPrims();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void DrivenTransforms::updateDrivenTransforms(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime)
+void DrivenTransforms::clearResolvedPrims()
 {
-  for (uint32_t i = 0, cnt = m_dirtyMatrices.size(); i < cnt; ++i)
+  TfNotice::Revoke(m_objectsChangedNoticeKey);
+  m_stage = UsdStageWeakPtr();
+  m_drivenPrims.clear();
+  m_drivenXformOps.clear();
+  m_drivenVisibilityAttrs.clear();
+  m_drivenPrimIndices.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DrivenTransforms::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
+{
+  // drop the cached transform ops of the prims whose op order has been edited (or that have been resynced). Driving
+  // the transforms only authors time samples on the ops themselves, so this doesn't happen during playback.
+  auto dropChangedXformOps = [this] (const UsdNotice::ObjectsChanged::PathRange& paths)
   {
-    uint32_t idx = uint32_t(m_dirtyMatrices[i]);
-    // [RB] This seems redundant? Why not just prevent invalid data from entering the structure?
-    if (idx >= drivenPrims.size())
+    for (const SdfPath& path : paths)
+    {
+      if (path.IsPrimPropertyPath())
+      {
+        if (path.GetNameToken() == UsdGeomTokens->xformOpOrder)
+        {
+          auto range = m_drivenPrimIndices.equal_range(path.GetPrimPath());
+          for (auto it = range.first; it != range.second; ++it)
+          {
+            m_drivenXformOps[it->second] = UsdGeomXformOp();
+          }
+        }
+      }
+      else if (path.IsAbsoluteRootOrPrimPath())
+      {
+        for (const auto& it : m_drivenPrimIndices)
+        {
+          if (it.first.HasPrefix(path))
+          {
+            m_drivenXformOps[it.second] = UsdGeomXformOp();
+          }
+        }
+      }
+    }
+  };
+  dropChangedXformOps(notice.GetResyncedPaths());
+  dropChangedXformOps(notice.GetChangedInfoOnlyPaths());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DrivenTransforms::resolvePrims(UsdStageRefPtr stage)
+{
+  if (m_stage != stage || m_drivenPrims.size() != m_drivenPrimPaths.size())
+  {
+    clearResolvedPrims();
+    m_stage = stage;
+    m_drivenPrims.resize(m_drivenPrimPaths.size());
+    m_drivenXformOps.resize(m_drivenPrimPaths.size());
+    m_drivenVisibilityAttrs.resize(m_drivenPrimPaths.size());
+    m_drivenPrimIndices.reserve(m_drivenPrimPaths.size());
+    for (uint32_t idx = 0, cnt = m_drivenPrimPaths.size(); idx < cnt; ++idx)
+    {
+      m_drivenPrimIndices.emplace(m_drivenPrimPaths[idx], idx);
+    }
+    m_objectsChangedNoticeKey = TfNotice::Register(TfCreateWeakPtr(this), &DrivenTransforms::onObjectsChanged, m_stage);
+  }
+
+  // only the prims that have expired (e.g. after a variant switch) need to be looked up again
+  bool result = true;
+  for (uint32_t idx = 0, cnt = m_drivenPrimPaths.size(); idx < cnt; ++idx)
+  {
+    if (m_drivenPrims[idx].IsValid())
     {
       continue;
     }
-    UsdPrim& usdPrim = drivenPrims[idx];
-    if (!usdPrim.IsValid())
+    m_drivenPrims[idx] = stage->GetPrimAtPath(m_drivenPrimPaths[idx]);
+    m_drivenXformOps[idx] = UsdGeomXformOp();
+    m_drivenVisibilityAttrs[idx] = UsdAttribute();
+    if (!m_drivenPrims[idx].IsValid())
+    {
+      MString warningMsg;
+      warningMsg.format("Driven Prim [^1s] is not valid.", MString("") + idx);
+      MGlobal::displayWarning(warningMsg);
+      result = false;
+    }
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DrivenTransforms::updateDrivenTransforms(const UsdTimeCode& timeCode)
+{
+  // a prim may have been dirtied several times since the last update, only its latest value needs writing
+  std::sort(m_dirtyMatrices.begin(), m_dirtyMatrices.end());
+  m_dirtyMatrices.erase(std::unique(m_dirtyMatrices.begin(), m_dirtyMatrices.end()), m_dirtyMatrices.end());
+
+  // resolve the transform ops of the prims that haven't been written to before, or whose op order has been edited
+  // since. This may author a new transform op, so it can't happen in parallel, or within the change block.
+  std::vector<uint32_t> indices;
+  indices.reserve(m_dirtyMatrices.size());
+  for (int32_t dirty : m_dirtyMatrices)
+  {
+    uint32_t idx = uint32_t(dirty);
+    // [RB] This seems redundant? Why not just prevent invalid data from entering the structure?
+    if (idx >= m_drivenPrims.size() || !m_drivenPrims[idx].IsValid())
     {
       continue;
     }
-    UsdGeomXform xform(usdPrim);
-    bool resetsXformStack = false;
-    std::vector<UsdGeomXformOp> xformops = xform.GetOrderedXformOps(&resetsXformStack);
-    bool pushed = false;
-    for (auto& it : xformops)
+    UsdGeomXformOp& xformOp = m_drivenXformOps[idx];
+    if (!xformOp)
     {
-      if (it.GetOpType() == UsdGeomXformOp::TypeTransform)
+      UsdGeomXform xform(m_drivenPrims[idx]);
+      bool resetsXformStack = false;
+      std::vector<UsdGeomXformOp> xformops = xform.GetOrderedXformOps(&resetsXformStack);
+      for (auto& it : xformops)
       {
-        nodes::TransformationMatrix::pushMatrix(m_drivenMatrix[idx], it, currentTime.as(MTime::uiUnit()));
-        pushed = true;
-        break;
+        if (it.GetOpType() == UsdGeomXformOp::TypeTransform)
+        {
+          xformOp = it;
+          break;
+        }
+      }
+      if (!xformOp)
+      {
+        xformOp = xform.AddTransformOp();
       }
     }
-    if (!pushed)
+    if (xformOp.GetTypeName() == SdfValueTypeNames->Matrix4d)
     {
-      UsdGeomXformOp xformop = xform.AddTransformOp();
-      nodes::TransformationMatrix::pushMatrix(m_drivenMatrix[idx], xformop, currentTime.as(MTime::uiUnit()));
+      indices.push_back(idx);
     }
+  }
+
+  // convert the matrices, and skip the ones that haven't changed. Nothing is authored until all of them are done, so
+  // the ops can be read from several threads at once.
+  std::vector<GfMatrix4d> values(indices.size());
+  std::vector<char> changed(indices.size(), 0);
+  WorkParallelForN(indices.size(), [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const uint32_t idx = indices[i];
+      values[i] = *(const GfMatrix4d*)(&m_drivenMatrix[idx]);
+      GfMatrix4d oldValue;
+      changed[i] = !m_drivenXformOps[idx].Get(&oldValue, timeCode) || values[i] != oldValue;
+    }
+  });
+
+  {
+    SdfChangeBlock changeBlock;
+    for (size_t i = 0, n = indices.size(); i < n; ++i)
+    {
+      if (!changed[i])
+      {
+        continue;
+      }
+      const uint32_t idx = indices[i];
+      m_drivenXformOps[idx].Set(values[i], timeCode);
 
-    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::updateDrivenTransforms %lf %lf %lf %lf  %lf %lf %lf %lf  %lf %lf %lf %lf  %lf %lf %lf %lf\n",
-        m_drivenMatrix[idx][0][0],
-        m_drivenMatrix[idx][0][1],
-        m_drivenMatrix[idx][0][2],
-        m_drivenMatrix[idx][0][3],
-        m_drivenMatrix[idx][1][0],
-        m_drivenMatrix[idx][1][1],
-        m_drivenMatrix[idx][1][2],
-        m_drivenMatrix[idx][1][3],
-        m_drivenMatrix[idx][2][0],
-        m_drivenMatrix[idx][2][1],
-        m_drivenMatrix[idx][2][2],
-        m_drivenMatrix[idx][2][3],
-        m_drivenMatrix[idx][3][0],
-        m_drivenMatrix[idx][3][1],
-        m_drivenMatrix[idx][3][2],
-        m_drivenMatrix[idx][3][3]);
+      TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::updateDrivenTransforms %lf %lf %lf %lf  %lf %lf %lf %lf  %lf %lf %lf %lf  %lf %lf %lf %lf\n",
+          m_drivenMatrix[idx][0][0],
+          m_drivenMatrix[idx][0][1],
+          m_drivenMatrix[idx][0][2],
+          m_drivenMatrix[idx][0][3],
+          m_drivenMatrix[idx][1][0],
+          m_drivenMatrix[idx][1][1],
+          m_drivenMatrix[idx][1][2],
+          m_drivenMatrix[idx][1][3],
+          m_drivenMatrix[idx][2][0],
+          m_drivenMatrix[idx][2][1],
+          m_drivenMatrix[idx][2][2],
+          m_drivenMatrix[idx][2][3],
+          m_drivenMatrix[idx][3][0],
+          m_drivenMatrix[idx][3][1],
+          m_drivenMatrix[idx][3][2],
+          m_drivenMatrix[idx][3][3]);
+    }
   }
   m_dirtyMatrices.clear();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void DrivenTransforms::updateDrivenVisibility(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime)
+void DrivenTransforms::updateDrivenVisibility(const UsdTimeCode& timeCode)
 {
-  for (uint32_t i = 0, cnt = m_dirtyVisibilities.size(); i < cnt; ++i)
+  std::sort(m_dirtyVisibilities.begin(), m_dirtyVisibilities.end());
+  m_dirtyVisibilities.erase(std::unique(m_dirtyVisibilities.begin(), m_dirtyVisibilities.end()), m_dirtyVisibilities.end());
+
+  std::vector<uint32_t> indices;
+  indices.reserve(m_dirtyVisibilities.size());
+  for (int32_t dirty : m_dirtyVisibilities)
   {
-    uint32_t idx = uint32_t(m_dirtyVisibilities[i]);
+    uint32_t idx = uint32_t(dirty);
     // [RB] This seems redundant? Why not just prevent invalid data from entering the structure?
-    if (idx >= drivenPrims.size())
-    {
-      continue;
-    }
-    UsdPrim& usdPrim = drivenPrims[idx];
-    if (!usdPrim)
+    if (idx >= m_drivenPrims.size() || !m_drivenPrims[idx])
     {
       continue;
     }
-    UsdGeomXform xform(usdPrim);
-    UsdAttribute attr = xform.GetVisibilityAttr();
-    if(!attr)
+    UsdAttribute& attr = m_drivenVisibilityAttrs[idx];
+    if (!attr)
     {
-      attr = xform.CreateVisibilityAttr();
+      UsdGeomXform xform(m_drivenPrims[idx]);
+      attr = xform.GetVisibilityAttr();
+      if(!attr)
+      {
+        attr = xform.CreateVisibilityAttr();
+      }
     }
-    attr.Set(m_drivenVisibility[idx] ? UsdGeomTokens->inherited : UsdGeomTokens->invisible, currentTime.as(MTime::uiUnit()));
+    indices.push_back(idx);
+  }
+
+  SdfChangeBlock changeBlock;
+  for (uint32_t idx : indices)
+  {
+    m_drivenVisibilityAttrs[idx].Set(m_drivenVisibility[idx] ? UsdGeomTokens->inherited : UsdGeomTokens->invisible, timeCode);
   }
   m_dirtyVisibilities.clear();
 }
@@ -102,30 +258,16 @@ void DrivenTransforms::updateDrivenVisibility(std::vector<UsdPrim>& drivenPrims,
 //----------------------------------------------------------------------------------------------------------------------
 bool DrivenTransforms::update(UsdStageRefPtr stage, const MTime& currentTime)
 {
-  std::vector<UsdPrim> drivenPrims;
-  drivenPrims.resize(transformCount());
-  bool result = true;
-  uint32_t cnt = m_drivenPrimPaths.size();
-  for (uint32_t idx = 0; idx < cnt; ++idx)
-  {
-    auto path = m_drivenPrimPaths[idx];
-    drivenPrims[idx] = stage->GetPrimAtPath(path);
-    if (!drivenPrims[idx].IsValid())
-    {
-      MString warningMsg;
-      warningMsg.format("Driven Prim [^1s] is not valid.", MString("") + idx);
-      MGlobal::displayWarning(warningMsg);
-      result = false;
-    }
-  }
+  bool result = resolvePrims(stage);
 
+  const UsdTimeCode timeCode(currentTime.as(MTime::uiUnit()));
   if (!dirtyMatrices().empty())
   {
-    updateDrivenTransforms(drivenPrims, currentTime);
+    updateDrivenTransforms(timeCode);
   }
   if (!dirtyVisibilities().empty())
   {
-    updateDrivenVisibility(drivenPrims, currentTime);
+    updateDrivenVisibility(timeCode);
   }
   return result;
 }
@@ -17,8 +17,14 @@
 
 #include "../../Api.h"
 
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
 #include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/common.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usdGeom/xformOp.h"
 
 #include "maya/MPxData.h"
 #include "maya/MVector.h"
@@ -26,6 +32,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "AL/maya/utils/ForwardDeclares.h"
 #include "AL/usd/utils/ForwardDeclares.h"
 
@@ -43,17 +50,37 @@ namespace proxy {
 ///         memory storage. setDrivenPrimPaths should be called to specify the prim paths. Whenever you need to specify
 ///         a change to the matrix or visibility values, call either dirtyVisibility or dirtyMatrix, and specify the
 ///         index of the prim to modify.
-///         Within the compute method of the node, constructDrivenPrimsArray should be called to construct the array
-///         of prims to update, which can then be passed to the update method to set the dirty values on the prim
-///         attributes.
+///         Within the compute method of the node, the update method should be called to set the dirty values on the
+///         prim attributes. The prims, their transform ops and visibility attributes are resolved the first time they
+///         are needed, and cached until the prim paths or the stage change (transform ops are also resolved again when
+///         the op order of their prim changes). The matrices are converted and compared against the values already on
+///         the stage in parallel, and the ones that have changed are then written in a single change block.
 //----------------------------------------------------------------------------------------------------------------------
 class DrivenTransforms
+  : public TfWeakBase
 {
 public:
 
   /// \brief  ctor
   inline DrivenTransforms()
-    : m_drivenPrimPaths(), m_drivenMatrix(), m_drivenVisibility(), m_dirtyMatrices(), m_dirtyVisibilities() {}
+    : m_drivenPrimPaths(), m_drivenMatrix(), m_drivenVisibility(), m_dirtyMatrices(), m_dirtyVisibilities(),
+      m_stage(), m_drivenPrims(), m_drivenXformOps(), m_drivenVisibilityAttrs(), m_drivenPrimIndices() {}
+
+  /// \brief  copy ctor. The resolved prims are tied to the stage listener of the source, so they are not copied, and
+  ///         will be resolved again on the next update.
+  inline DrivenTransforms(const DrivenTransforms& other)
+    : TfWeakBase(), m_drivenPrimPaths(other.m_drivenPrimPaths), m_drivenMatrix(other.m_drivenMatrix),
+      m_drivenVisibility(other.m_drivenVisibility), m_dirtyMatrices(other.m_dirtyMatrices),
+      m_dirtyVisibilities(other.m_dirtyVisibilities), m_stage(), m_drivenPrims(), m_drivenXformOps(),
+      m_drivenVisibilityAttrs(), m_drivenPrimIndices() {}
+
+  /// \brief  assignment. As with the copy ctor, the resolved prims are not copied.
+  AL_USDMAYA_PUBLIC
+  DrivenTransforms& operator = (const DrivenTransforms& other);
+
+  /// \brief  dtor
+  inline ~DrivenTransforms()
+    { TfNotice::Revoke(m_objectsChangedNoticeKey); }
 
   /// \brief  returns the number of transforms
   inline size_t transformCount() const
@@ -67,7 +94,7 @@ public:
   /// \brief  set the driven prim paths on the host driven transforms
   /// \param  primPaths the prim paths to set on the proxy
   inline void setDrivenPrimPaths(const SdfPathVector& primPaths)
-    { m_drivenPrimPaths = primPaths; }
+    { m_drivenPrimPaths = primPaths; clearResolvedPrims(); }
 
   /// \brief  update the driven transforms
   /// \param  stage the stage to extract the prims from
@@ -120,14 +147,27 @@ public:
     { return m_drivenVisibility; }
 
 private:
-  void updateDrivenVisibility(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime);
-  void updateDrivenTransforms(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime);
+  void clearResolvedPrims();
+  bool resolvePrims(UsdStageRefPtr stage);
+  void onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender);
+  void updateDrivenVisibility(const UsdTimeCode& timeCode);
+  void updateDrivenTransforms(const UsdTimeCode& timeCode);
 private:
   SdfPathVector m_drivenPrimPaths;
   std::vector<MMatrix> m_drivenMatrix;
   std::vector<bool> m_drivenVisibility;
   std::vector<int32_t> m_dirtyMatrices;
   std::vector<int32_t> m_dirtyVisibilities;
+
+  // the prims, transform ops and visibility attributes resolved from the driven prim paths on m_stage. The ops and
+  // attributes are resolved the first time a value is written to them. A transform op is dropped by onObjectsChanged
+  // when the op order of its prim is edited, so that it gets resolved again.
+  UsdStageWeakPtr m_stage;
+  std::vector<UsdPrim> m_drivenPrims;
+  std::vector<UsdGeomXformOp> m_drivenXformOps;
+  std::vector<UsdAttribute> m_drivenVisibilityAttrs;
+  std::unordered_multimap<SdfPath, uint32_t, SdfPath::Hash> m_drivenPrimIndices;
+  TfNotice::Key m_objectsChangedNoticeKey;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
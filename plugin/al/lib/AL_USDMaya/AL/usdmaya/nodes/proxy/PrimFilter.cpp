@@ -2,25 +2,31 @@
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
 #include "AL/usdmaya/fileio/SchemaPrims.h"
 
+#include "pxr/base/tf/hashset.h"
+
+#include <algorithm>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
 namespace proxy {
 
 //----------------------------------------------------------------------------------------------------------------------
-PrimFilter::PrimFilter(const SdfPathVector& previousPrims, const std::vector<UsdPrim>& newPrimSet, PrimFilterInterface* proxy)
-        : m_newPrimSet(newPrimSet), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
+PrimFilter::PrimFilter(const SdfPathVector& previousPrims, const std::vector<UsdPrim>& newPrimSet, PrimFilterInterface* proxy,
+                       const std::vector<size_t>& compositionHashes)
+        : m_newPrimSet(), m_transformsToCreate(), m_updatablePrimSet(), m_unchangedPrimSet(), m_removedPrimSet()
 {
-  // copy over original prims
-  m_removedPrimSet.assign(previousPrims.begin(), previousPrims.end());
-  std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
+  const bool hasHashes = compositionHashes.size() == newPrimSet.size();
 
-  for(auto it = m_newPrimSet.begin(); it != m_newPrimSet.end(); )
-  {
-    UsdPrim prim = *it;
-    auto lastIt = it;
-    ++it;
+  // the prims that were previously translated, and the ones that we want to keep hold of. Lookups into these sets
+  // replace the erasures from sorted vectors, which were quadratic in the number of prims being switched.
+  TfHashSet<SdfPath, SdfPath::Hash> previous(previousPrims.begin(), previousPrims.end());
+  TfHashSet<SdfPath, SdfPath::Hash> kept;
 
+  m_newPrimSet.reserve(newPrimSet.size());
+  for(size_t i = 0, n = newPrimSet.size(); i < n; ++i)
+  {
+    const UsdPrim& prim = newPrimSet[i];
     SdfPath path = prim.GetPath();
 
     // check previous prim type (if it exists at all?)
@@ -31,34 +37,67 @@ PrimFilter::PrimFilter(const SdfPathVector& previousPrims, const std::vector<Usd
     bool requiresParent = false;
     proxy->getTypeInfo(newType, supportsUpdate, requiresParent);
 
-    // if the type remains the same, and the type supports update
     if(type == newType)
     {
-      if(supportsUpdate)
+      const bool wasTranslated = previous.find(path) != previous.end();
+
+      // if the specs that contribute to the prim are the same as the last time it was translated, then nothing has
+      // been changed by the variant switch, so the maya nodes can be left as they are.
+      const size_t hash = hasHashes ? compositionHashes[i] : 0;
+      if(wasTranslated && hash && hash == proxy->getCompositionHashForPath(path))
+      {
+        TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                  "PrimFilter::PrimFilter %s prim has not changed type or composition.\n", path.GetText());
+        kept.insert(path);
+        m_unchangedPrimSet.push_back(prim);
+        continue;
+      }
+
+      // if the type remains the same, and the type supports update
+      if(wasTranslated && supportsUpdate)
       {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
                   "PrimFilter::PrimFilter %s prim has not changed type and supports updates or inactive.\n", path.GetText());
-        // locate the path and delete from the removed set (we do not want to delete this prim!
-        // Note that m_removedPrimSet is reverse sorted
-        auto iter = std::lower_bound(m_removedPrimSet.begin(), m_removedPrimSet.end(), path, [](const SdfPath& a, const SdfPath& b){ return b < a; } );
-        if(iter != removedPrimSet().end() && *iter == path)
+        kept.insert(path);
+        m_updatablePrimSet.push_back(prim);
+        // skip creating transforms in this case.
+        continue;
+      }
+
+      // If the prim has not been translated and has the same type, it isn't new.
+      if(!wasTranslated)
+      {
+        if(requiresParent)
         {
-          m_removedPrimSet.erase(iter);
-          m_updatablePrimSet.push_back(prim);
-          // skip creating transforms in this case.
-          requiresParent = false;
+          m_transformsToCreate.push_back(prim);
         }
+        continue;
       }
 
-      //If the prim is still already there with the same type, it isn't new.
-      it = m_newPrimSet.erase(lastIt);
+      // Otherwise the prim cannot be updated in place, so it is removed and created again.
+      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                "PrimFilter::PrimFilter %s prim does not support updates and will be re-created.\n", path.GetText());
     }
+
+    m_newPrimSet.push_back(prim);
+
     // if we need a transform, make a note of it now
     if(requiresParent)
     {
       m_transformsToCreate.push_back(prim);
     }
   }
+
+  // anything we are not keeping hold of gets removed (reverse sorted, so that children are removed before parents)
+  m_removedPrimSet.reserve(previousPrims.size() - std::min(previousPrims.size(), kept.size()));
+  for(const SdfPath& path : previousPrims)
+  {
+    if(kept.find(path) == kept.end())
+    {
+      m_removedPrimSet.push_back(path);
+    }
+  }
+  std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -52,6 +52,14 @@ struct PrimFilterInterface
   /// \param  requiresParent returned value that indicates whether the type in question needs a DAG path to be created
   /// \return returns false if the type is unknown, true otherwise
   virtual bool getTypeInfo(TfToken type, bool& supportsUpdate, bool& requiresParent) = 0;
+
+  /// \brief  Given a path to a prim, this method will return the hash of the composition of the prim at the time it
+  ///         was last translated (see TranslatorContext::computeCompositionHash).
+  /// \param  path the path to the prim we are querying
+  /// \return the composition hash of the prim, or zero if it is unknown (in which case the prim is never assumed to
+  ///         be unchanged)
+  virtual size_t getCompositionHashForPath(const SdfPath& path)
+    { return 0; }
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -65,8 +73,12 @@ public:
   /// \param  previousPrims the previous set of prims that existed in the stage
   /// \param  newPrimSet the new set of prims that have been created
   /// \param  proxy the proxy shape
+  /// \param  compositionHashes the composition hashes of the prims in newPrimSet (in the same order). Prims whose type
+  ///         and composition hash match those recorded by the proxy are left untouched. If empty, the prims are
+  ///         always updated or re-created.
   AL_USDMAYA_PUBLIC
-  PrimFilter(const SdfPathVector& previousPrims, const AL::usd::utils::UsdPrimVector& newPrimSet, PrimFilterInterface* proxy);
+  PrimFilter(const SdfPathVector& previousPrims, const AL::usd::utils::UsdPrimVector& newPrimSet, PrimFilterInterface* proxy,
+             const std::vector<size_t>& compositionHashes = std::vector<size_t>());
 
   /// \brief  returns the set of prims to create
   inline const std::vector<UsdPrim>& newPrimSet() const
@@ -80,6 +92,10 @@ public:
   inline const std::vector<UsdPrim>& updatablePrimSet() const
     { return m_updatablePrimSet; }
 
+  /// \brief  returns the list of prims whose composition has not changed, and so can be left as they are
+  inline const std::vector<UsdPrim>& unchangedPrimSet() const
+    { return m_unchangedPrimSet; }
+
   /// \brief  returns the list of prims that have been removed from the stage
   inline const SdfPathVector& removedPrimSet() const
     { return m_removedPrimSet; }
@@ -88,6 +104,7 @@ private:
   std::vector<UsdPrim> m_newPrimSet;
   std::vector<UsdPrim> m_transformsToCreate;
   std::vector<UsdPrim> m_updatablePrimSet;
+  std::vector<UsdPrim> m_unchangedPrimSet;
   SdfPathVector m_removedPrimSet;
 };
 
@@ -282,6 +282,100 @@ TEST(EventDispatcher, triggerEvent2)
   EXPECT_TRUE(info.unregisterCallback(id1));
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+class CountingEventSystemBinding
+  : public TestEventSystemBinding
+{
+public:
+  bool executePython(const char* const code) override
+  {
+    ++m_pythonCalls;
+    return TestEventSystemBinding::executePython(code);
+  }
+  int m_pythonCalls = 0;
+};
+
+TEST(EventDispatcher, triggerEventBatchesPython)
+{
+  g_userData = 0;
+  CountingEventSystemBinding system;
+  EventDispatcher info(&system, "eventName", 42, kUserSpecifiedEventType, nullptr, 23);
+
+  int value;
+  info.registerCallback("py1", "al_batch_test = ['a']", 1000, true);
+  info.registerCallback("py2", "raise RuntimeError('expected failure')", 1001, true);
+  info.registerCallback("py3", "al_batch_test.append('b')", 1002, true);
+  info.registerCallback("c", func_dispatch1, 1003, &value);
+  info.registerCallback("py4", "al_batch_test.append('c')", 1004, true);
+
+  // the first three python callbacks are executed in one go, the C callback and last python callback after them
+  info.triggerEvent();
+  EXPECT_EQ(2, system.m_pythonCalls);
+  EXPECT_EQ(g_userData, &value);
+
+  // a failing callback should not prevent the others in the batch from running, and the order should be preserved
+  EXPECT_EQ(MString("a,b,c"), MGlobal::executePythonCommandStringResult("','.join(al_batch_test)"));
+
+  // the bookkeeping of the batch does not leak into __main__
+  EXPECT_EQ(MString("False"), MGlobal::executePythonCommandStringResult("str('_al_event_failed' in globals())"));
+
+  EXPECT_EQ(1u, info.triggerCount());
+  EXPECT_LE(info.maxDispatchTime(), info.totalDispatchTime());
+  info.resetStatistics();
+  EXPECT_EQ(0u, info.triggerCount());
+  EXPECT_EQ(0.0, info.totalDispatchTime());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+struct UnregisterDuringDispatch
+{
+  EventDispatcher* dispatcher;
+  CallbackId self;
+  CallbackId other;
+  int calls;
+};
+
+static void func_unregister(void* userData)
+{
+  UnregisterDuringDispatch* data = (UnregisterDuringDispatch*)userData;
+  ++data->calls;
+  data->dispatcher->unregisterCallback(data->self);
+  data->dispatcher->unregisterCallback(data->other);
+}
+
+static void func_count(void* userData)
+{
+  ++*(int*)userData;
+}
+
+TEST(EventDispatcher, triggerEventUnregisterDuringDispatch)
+{
+  EventDispatcher info(&g_eventSystem, "eventName", 42, kUserSpecifiedEventType, nullptr, 23);
+
+  // a callback that unregisters itself, and a callback that has not been called yet
+  int firstCalls = 0, removedCalls = 0, lastCalls = 0;
+  UnregisterDuringDispatch data{ &info, 0, 0, 0 };
+  CallbackId id1 = info.registerCallback("first", func_count, 1000, &firstCalls);
+  data.self = info.registerCallback("unregister", func_unregister, 1001, &data);
+  data.other = info.registerCallback("removed", func_count, 1002, &removedCalls);
+  CallbackId id4 = info.registerCallback("last", func_count, 1003, &lastCalls);
+
+  info.triggerEvent();
+  EXPECT_EQ(1, firstCalls);
+  EXPECT_EQ(1, data.calls);
+  EXPECT_EQ(0, removedCalls);
+  EXPECT_EQ(1, lastCalls);
+
+  info.triggerEvent();
+  EXPECT_EQ(2, firstCalls);
+  EXPECT_EQ(1, data.calls);
+  EXPECT_EQ(0, removedCalls);
+  EXPECT_EQ(2, lastCalls);
+
+  EXPECT_TRUE(info.unregisterCallback(id1));
+  EXPECT_TRUE(info.unregisterCallback(id4));
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // EventId registerEvent(const char* eventName, const void* associatedData = 0, const CallbackId parentEvent = 0);
 // bool unregisterEvent(EventId eventId);
@@ -170,3 +170,62 @@ TEST(ExportCommands, extensiveAnimationCheck)
   MGlobal::executeCommand(exportCmd, true);
   expectAnimation(false);
 }
+
+TEST(ExportCommands, filterSample)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand(MString("createNode transform -n node;select node;"), false, true);
+  // translateX is held at 1 between frames 3 and 6, and at 4 from frame 8 onwards
+  MGlobal::executeCommand(MString("setKeyframe -t 1 -v 0 -at tx -itt linear -ott linear node;"
+                                  "setKeyframe -t 3 -v 1 -at tx -itt linear -ott linear node;"
+                                  "setKeyframe -t 6 -v 1 -at tx -itt linear -ott linear node;"
+                                  "setKeyframe -t 8 -v 4 -at tx -itt linear -ott linear node;"
+                                  "setKeyframe -t 10 -v 4 -at tx -itt linear -ott linear node;"), false, true);
+  // visibility (exported through TransformTranslator::copyAttributeValue) is on until frame 6
+  MGlobal::executeCommand(MString("setKeyframe -t 1 -v 1 -at v node;"
+                                  "setKeyframe -t 6 -v 0 -at v node;"), false, true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_filterSample.usda");
+  MString exportCmd;
+  exportCmd.format(MString("AL_usdmaya_ExportCommand -f \"^1s\" -sl 1 -fs 1 -frameRange 1 10"), AL::maya::utils::convert(temp_path));
+  MGlobal::executeCommand(exportCmd, true);
+
+  UsdStageRefPtr stage = UsdStage::Open(temp_path);
+  ASSERT_TRUE(stage);
+
+  UsdPrim prim = stage->GetPrimAtPath(SdfPath("/node"));
+  ASSERT_TRUE(prim.IsValid());
+
+  UsdGeomXform transform(prim);
+  bool resetsXformStack;
+  std::vector<UsdGeomXformOp> ops = transform.GetOrderedXformOps(&resetsXformStack);
+  ASSERT_FALSE(ops.empty());
+
+  UsdAttribute translate = ops[0].GetAttr();
+  std::vector<double> times;
+  EXPECT_TRUE(translate.GetTimeSamples(&times));
+
+  // the interior samples of the held run, and the trailing duplicates, are filtered out
+  const std::vector<double> expected = {1.0, 2.0, 3.0, 6.0, 7.0, 8.0};
+  EXPECT_EQ(expected, times);
+
+  // values are unchanged wherever the samples were removed
+  GfVec3f value;
+  EXPECT_TRUE(translate.Get(&value, UsdTimeCode(5.0)));
+  EXPECT_NEAR(1.0f, value[0], 1e-5f);
+  EXPECT_TRUE(translate.Get(&value, UsdTimeCode(10.0)));
+  EXPECT_NEAR(4.0f, value[0], 1e-5f);
+
+  // the visibility samples are filtered in the same way
+  UsdAttribute visibility = transform.GetVisibilityAttr();
+  times.clear();
+  EXPECT_TRUE(visibility.GetTimeSamples(&times));
+  const std::vector<double> expectedVisibility = {1.0, 5.0, 6.0};
+  EXPECT_EQ(expectedVisibility, times);
+
+  TfToken visibilityValue;
+  EXPECT_TRUE(visibility.Get(&visibilityValue, UsdTimeCode(3.0)));
+  EXPECT_EQ(UsdGeomTokens->inherited, visibilityValue);
+  EXPECT_TRUE(visibility.Get(&visibilityValue, UsdTimeCode(10.0)));
+  EXPECT_EQ(UsdGeomTokens->invisible, visibilityValue);
+}
@@ -216,6 +216,75 @@ TEST(ProxyShapeImport, lockMetaData)
   EXPECT_TRUE(status != MStatus::kSuccess);
 }
 
+TEST(ProxyShapeImport, lockMetaDataChanges)
+{
+  MFileIO::newFile(true);
+  const std::string temp_bootstrap_path = buildTempPath("AL_USDMayaTests_lockMetaDataChanges.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    stage->DefinePrim(SdfPath("/root/a"), TfToken("xform"));
+    stage->DefinePrim(SdfPath("/root/a/camA"), TfToken("Camera"));
+    stage->DefinePrim(SdfPath("/root/b"), TfToken("xform"));
+    stage->DefinePrim(SdfPath("/root/b/camB"), TfToken("Camera"));
+    stage->Export(temp_bootstrap_path, false);
+  }
+
+  MFileIO::newFile(true);
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+
+  // force the stage to load
+  proxy->filePathPlug().setString(temp_bootstrap_path.c_str());
+
+  auto stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+
+  auto isLocked = [] (const char* nodeName)
+  {
+    MSelectionList sl;
+    MObject obj;
+    if(sl.add(nodeName) != MS::kSuccess || sl.getDependNode(0, obj) != MS::kSuccess)
+    {
+      return false;
+    }
+    MFnDependencyNode fn(obj);
+    return fn.findPlug("t").isLocked() && fn.findPlug("r").isLocked() && fn.findPlug("s").isLocked();
+  };
+
+  const TfToken lockMetadata("al_usdmaya_lock");
+  EXPECT_FALSE(isLocked("camA"));
+  EXPECT_FALSE(isLocked("camB"));
+
+  // each edit only updates the locks in the subtree of the edited prim
+  stage->GetPrimAtPath(SdfPath("/root/a")).SetMetadata(lockMetadata, TfToken("transform"));
+  EXPECT_TRUE(isLocked("camA"));
+  EXPECT_FALSE(isLocked("camB"));
+
+  stage->GetPrimAtPath(SdfPath("/root/b")).SetMetadata(lockMetadata, TfToken("transform"));
+  EXPECT_TRUE(isLocked("camA"));
+  EXPECT_TRUE(isLocked("camB"));
+
+  stage->GetPrimAtPath(SdfPath("/root/a")).SetMetadata(lockMetadata, TfToken("unlocked"));
+  EXPECT_FALSE(isLocked("camA"));
+  EXPECT_TRUE(isLocked("camB"));
+
+  // A new prim may be locked before its maya transform has been created. A prim that fails to lock is retried by the
+  // next pass, even when that pass is for an unrelated subtree.
+  {
+    SdfChangeBlock changeBlock;
+    UsdPrim c = stage->DefinePrim(SdfPath("/root/c"), TfToken("xform"));
+    c.SetMetadata(lockMetadata, TfToken("transform"));
+    stage->DefinePrim(SdfPath("/root/c/camC"), TfToken("Camera"));
+  }
+  stage->GetPrimAtPath(SdfPath("/root/b")).SetMetadata(lockMetadata, TfToken("inherited"));
+  EXPECT_TRUE(isLocked("camC"));
+  EXPECT_FALSE(isLocked("camB"));
+}
+
 TEST(ProxyShapeImport, sessionLayer)
 {
   constexpr double EPSILON = 1e-5;
@@ -32,8 +32,11 @@
 #include "pxr/usd/usd/attribute.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/tf/stopwatch.h"
 
 #include <fstream>
+#include <iostream>
 
 using AL::maya::test::buildTempPath;
 
@@ -228,3 +231,130 @@ TEST(ProxyShape, DrivenTransforms)
 
   }
 }
+
+// bool update(UsdStageRefPtr stage, const MTime& currentTime);
+TEST(ProxyShape, DrivenTransformsBenchmark)
+{
+  const uint32_t numTransforms = 10000;
+  const uint32_t numFrames = 10;
+
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  SdfPathVector drivenPaths;
+  drivenPaths.reserve(numTransforms);
+  for(uint32_t i = 0; i < numTransforms; ++i)
+  {
+    drivenPaths.push_back(SdfPath(TfStringPrintf("/root/joint%u", i)));
+    UsdGeomXform::Define(stage, drivenPaths.back());
+  }
+
+  AL::usdmaya::nodes::proxy::DrivenTransforms dt;
+  dt.resizeDrivenTransforms(numTransforms);
+  dt.setDrivenPrimPaths(drivenPaths);
+
+  TfStopwatch stopwatch;
+  for(uint32_t frame = 0; frame < numFrames; ++frame)
+  {
+    for(uint32_t i = 0; i < numTransforms; ++i)
+    {
+      MMatrix matrixValue = MMatrix::identity;
+      matrixValue[3][0] = frame;
+      matrixValue[3][1] = i;
+      dt.dirtyMatrix(i, matrixValue);
+      dt.dirtyVisibility(i, (i + frame) % 2 == 0);
+    }
+
+    stopwatch.Start();
+    EXPECT_TRUE(dt.update(stage, MTime(frame, MTime::uiUnit())));
+    stopwatch.Stop();
+  }
+  std::cout << "DrivenTransforms: updated " << numTransforms << " transforms over " << numFrames << " frames in "
+            << stopwatch.GetSeconds() << " seconds" << std::endl;
+
+  // spot check the values written on the last frame
+  const double lastFrame = numFrames - 1;
+  for(uint32_t i : { 0u, 1u, numTransforms / 2, numTransforms - 1 })
+  {
+    UsdGeomXform xform(stage->GetPrimAtPath(drivenPaths[i]));
+    bool resetsXformStack;
+    std::vector<UsdGeomXformOp> ops = xform.GetOrderedXformOps(&resetsXformStack);
+    ASSERT_EQ(1u, ops.size());
+    GfMatrix4d matrix;
+    EXPECT_TRUE(ops[0].Get(&matrix, lastFrame));
+    EXPECT_EQ(GfVec3d(lastFrame, i, 0), matrix.ExtractTranslation());
+
+    TfToken visibility;
+    EXPECT_TRUE(xform.GetVisibilityAttr().Get(&visibility, lastFrame));
+    EXPECT_EQ((i + numFrames - 1) % 2 == 0 ? UsdGeomTokens->inherited : UsdGeomTokens->invisible, visibility);
+  }
+}
+
+// bool update(UsdStageRefPtr stage, const MTime& currentTime);
+TEST(ProxyShape, DrivenTransformsXformOpOrderChange)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath("/root"));
+
+  AL::usdmaya::nodes::proxy::DrivenTransforms dt;
+  dt.resizeDrivenTransforms(1);
+  dt.setDrivenPrimPaths({ SdfPath("/root") });
+
+  MMatrix matrixValue = MMatrix::identity;
+  matrixValue[3][0] = 1.0;
+  dt.dirtyMatrix(0, matrixValue);
+  EXPECT_TRUE(dt.update(stage, MTime(1.0, MTime::uiUnit())));
+
+  // replace the op the driven transforms resolved with a different transform op
+  UsdGeomXformOp resolvedOp = xform.GetTransformOp();
+  ASSERT_TRUE(resolvedOp);
+  xform.ClearXformOpOrder();
+  UsdGeomXformOp newOp = xform.AddTransformOp(UsdGeomXformOp::PrecisionDouble, TfToken("driven"));
+  ASSERT_TRUE(newOp);
+
+  // the next update writes to the op that is now in the op order
+  matrixValue[3][0] = 2.0;
+  dt.dirtyMatrix(0, matrixValue);
+  EXPECT_TRUE(dt.update(stage, MTime(2.0, MTime::uiUnit())));
+
+  bool resetsXformStack;
+  std::vector<UsdGeomXformOp> ops = xform.GetOrderedXformOps(&resetsXformStack);
+  ASSERT_EQ(1u, ops.size());
+  EXPECT_EQ(newOp.GetName(), ops[0].GetName());
+  GfMatrix4d matrix;
+  EXPECT_TRUE(ops[0].Get(&matrix, 2.0));
+  EXPECT_EQ(GfVec3d(2.0, 0, 0), matrix.ExtractTranslation());
+
+  // and the op that was removed from the op order is left alone
+  EXPECT_FALSE(resolvedOp.GetAttr().HasAuthoredValueOpinion() && resolvedOp.GetAttr().GetNumTimeSamples() > 1);
+}
+
+// DrivenTransforms& operator = (const DrivenTransforms& other);
+TEST(ProxyShape, DrivenTransformsCopy)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath("/root"));
+
+  AL::usdmaya::nodes::proxy::DrivenTransforms dt;
+  dt.resizeDrivenTransforms(1);
+  dt.setDrivenPrimPaths({ SdfPath("/root") });
+  MMatrix matrixValue = MMatrix::identity;
+  dt.dirtyMatrix(0, matrixValue);
+  EXPECT_TRUE(dt.update(stage, MTime(1.0, MTime::uiUnit())));
+
+  // the copy resolves its own transform ops, so it still picks up op order edits once the original has gone
+  AL::usdmaya::nodes::proxy::DrivenTransforms copied;
+  copied = dt;
+  dt = AL::usdmaya::nodes::proxy::DrivenTransforms();
+  EXPECT_EQ(1u, copied.transformCount());
+
+  xform.ClearXformOpOrder();
+  UsdGeomXformOp newOp = xform.AddTransformOp(UsdGeomXformOp::PrecisionDouble, TfToken("driven"));
+  ASSERT_TRUE(newOp);
+
+  matrixValue[3][0] = 3.0;
+  copied.dirtyMatrix(0, matrixValue);
+  EXPECT_TRUE(copied.update(stage, MTime(2.0, MTime::uiUnit())));
+
+  GfMatrix4d matrix;
+  EXPECT_TRUE(newOp.Get(&matrix, 2.0));
+  EXPECT_EQ(GfVec3d(3.0, 0, 0), matrix.ExtractTranslation());
+}
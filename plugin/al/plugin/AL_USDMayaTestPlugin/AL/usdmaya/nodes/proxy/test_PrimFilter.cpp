@@ -34,6 +34,7 @@
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
 
 #include <fstream>
+#include <map>
 
 using AL::maya::test::buildTempPath;
 
@@ -41,6 +42,8 @@ struct MockPrimFilterInterface : public AL::usdmaya::nodes::proxy::PrimFilterInt
 {
   SdfPathVector refPaths;
   SdfPathVector cameraPaths;
+  std::map<SdfPath, size_t> compositionHashes;
+  bool supportsUpdate = true;
 
   TfToken getTypeForPath(const SdfPath& path) override
   {
@@ -57,10 +60,16 @@ struct MockPrimFilterInterface : public AL::usdmaya::nodes::proxy::PrimFilterInt
 
   bool getTypeInfo(TfToken type, bool& supportsUpdate, bool& requiresParent) override
   {
-    supportsUpdate = true;
+    supportsUpdate = this->supportsUpdate;
     requiresParent = true;
     return true;
   }
+
+  size_t getCompositionHashForPath(const SdfPath& path) override
+  {
+    auto it = compositionHashes.find(path);
+    return it != compositionHashes.end() ? it->second : 0;
+  }
 };
 
 static const char* const g_removedPaths =
@@ -265,5 +274,61 @@ TEST(PrimFilter, removedPaths)
     EXPECT_TRUE(filter.updatablePrimSet().empty());
     EXPECT_TRUE(filter.transformsToCreate().size() == 1);
   }
+
+  /// prims whose composition has not changed should be left alone, the others should be updated
+  {
+    const SdfPathVector previous = {
+      SdfPath("/root"),
+      SdfPath("/root/hip1"),
+      SdfPath("/root/hip2"),
+    };
+    mockInterface.refPaths = previous;
+    mockInterface.compositionHashes = {
+      { SdfPath("/root"), 1 },
+      { SdfPath("/root/hip1"), 2 },
+      { SdfPath("/root/hip2"), 3 },
+    };
+    std::vector<UsdPrim> prims;
+    for(auto it : previous)
+    {
+      prims.emplace_back(stage->GetPrimAtPath(it));
+    }
+    const std::vector<size_t> hashes = { 1, 2, 4 };
+
+    AL::usdmaya::nodes::proxy::PrimFilter filter(previous, prims, &mockInterface, hashes);
+    EXPECT_TRUE(filter.removedPrimSet().empty());
+    EXPECT_TRUE(filter.newPrimSet().empty());
+    EXPECT_TRUE(filter.transformsToCreate().empty());
+    ASSERT_EQ(2u, filter.unchangedPrimSet().size());
+    EXPECT_TRUE(filter.unchangedPrimSet()[0].GetPath() == SdfPath("/root"));
+    EXPECT_TRUE(filter.unchangedPrimSet()[1].GetPath() == SdfPath("/root/hip1"));
+    ASSERT_EQ(1u, filter.updatablePrimSet().size());
+    EXPECT_TRUE(filter.updatablePrimSet()[0].GetPath() == SdfPath("/root/hip2"));
+    mockInterface.compositionHashes.clear();
+  }
+
+  /// prims that keep their type but cannot be updated should be removed and created again
+  {
+    const SdfPathVector previous = {
+      SdfPath("/root/hip1"),
+      SdfPath("/root/hip2"),
+    };
+    mockInterface.refPaths = previous;
+    mockInterface.supportsUpdate = false;
+    std::vector<UsdPrim> prims;
+    for(auto it : previous)
+    {
+      prims.emplace_back(stage->GetPrimAtPath(it));
+    }
+
+    AL::usdmaya::nodes::proxy::PrimFilter filter(previous, prims, &mockInterface);
+    ASSERT_EQ(2u, filter.removedPrimSet().size());
+    EXPECT_TRUE(filter.removedPrimSet()[0] == SdfPath("/root/hip2"));
+    EXPECT_TRUE(filter.removedPrimSet()[1] == SdfPath("/root/hip1"));
+    EXPECT_EQ(2u, filter.newPrimSet().size());
+    EXPECT_EQ(2u, filter.transformsToCreate().size());
+    EXPECT_TRUE(filter.updatablePrimSet().empty());
+    mockInterface.supportsUpdate = true;
+  }
 }
 
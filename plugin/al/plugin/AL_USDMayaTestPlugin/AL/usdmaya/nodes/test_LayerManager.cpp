@@ -24,6 +24,7 @@
 #include "maya/MGlobal.h"
 #include "maya/MItDependencyNodes.h"
 #include "maya/MSelectionList.h"
+#include "pxr/base/tf/stringUtils.h"
 #include "pxr/usd/sdf/attributeSpec.h"
 #include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
@@ -396,6 +397,142 @@ def Scope "blabla"
   { SCOPED_TRACE(""); assertLayersPopulated(); }
 }
 
+// MStatus populateSerialisationAttributes();
+// size_t serialisationCacheSize();
+TEST(LayerManager, serialisationCache)
+{
+  constexpr auto LAYER_CONTENTS = R"ESC(#usda 1.0
+
+def Scope "cached"
+{
+}
+
+)ESC";
+
+  constexpr auto EDITED_LAYER_CONTENTS = R"ESC(#usda 1.0
+
+def Scope "edited"
+{
+}
+
+)ESC";
+
+  MStatus status;
+
+  MFileIO::newFile(true);
+
+  auto *manager = AL::usdmaya::nodes::LayerManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+  manager->clearSerialisationCache();
+
+  auto realLayer = SdfLayer::New(
+      SdfFileFormat::FindById(UsdUsdaFileFormatTokens->Id),
+      "/my/cached/layer.usda");
+  realLayer->ImportFromString(LAYER_CONTENTS);
+  ASSERT_TRUE(manager->addLayer(realLayer));
+
+  auto serializedValue = [&] () {
+    MPlug layersPlug0 = manager->layersPlug().elementByPhysicalIndex(0, &status);
+    MObject tempNonConst = manager->serialized();
+    return layersPlug0.child(tempNonConst, &status).asString(MDGContext::fsNormal, &status);
+  };
+
+  // the first save exports the layer, and caches it
+  EXPECT_EQ(0u, manager->serialisationCacheSize());
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(1u, manager->serialisationCacheSize());
+  EXPECT_EQ(MString(LAYER_CONTENTS), serializedValue());
+
+  // saving again without any edits uses the cached text
+  manager->clearSerialisationAttributes();
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(1u, manager->serialisationCacheSize());
+  EXPECT_EQ(MString(LAYER_CONTENTS), serializedValue());
+
+  // editing the layer discards the cached text
+  realLayer->ImportFromString(EDITED_LAYER_CONTENTS);
+  EXPECT_EQ(0u, manager->serialisationCacheSize());
+  manager->clearSerialisationAttributes();
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(1u, manager->serialisationCacheSize());
+  EXPECT_EQ(MString(EDITED_LAYER_CONTENTS), serializedValue());
+
+  ASSERT_TRUE(manager->removeLayer(realLayer));
+  EXPECT_EQ(0u, manager->serialisationCacheSize());
+}
+
+// MStatus populateSerialisationAttributes();
+// void loadAllLayers();
+TEST(LayerManager, binarySerialisation)
+{
+  constexpr auto LAYER_CONTENTS = R"ESC(#usda 1.0
+
+def Scope "binary"
+{
+    float foo = 5.5
+}
+
+)ESC";
+
+  MStatus status;
+
+  MFileIO::newFile(true);
+
+  auto *manager = AL::usdmaya::nodes::LayerManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+  manager->binarySerialisationPlug().setBool(false);
+
+  auto anonLayer = SdfLayer::CreateAnonymous("binaryLayer");
+  ASSERT_TRUE(anonLayer->ImportFromString(LAYER_CONTENTS));
+  ASSERT_TRUE(manager->addLayer(anonLayer));
+
+  MObject tempNonConst = manager->serialized();
+  auto serializedLayer = [&] () {
+    MPlug layersPlug0 = manager->layersPlug().elementByPhysicalIndex(0, &status);
+    EXPECT_TRUE(status);
+    return std::string(layersPlug0.child(tempNonConst, &status).asString(MDGContext::fsNormal, &status).asChar());
+  };
+
+  // by default anonymous layers are stored as usda text, and the result is cached
+  manager->populateSerialisationAttributes();
+  EXPECT_TRUE(TfStringStartsWith(serializedLayer(), "#usda"));
+  EXPECT_EQ(1u, manager->serialisationCacheSize());
+
+  // switching the format must not reuse the cached text, even though the layer is unchanged
+  manager->binarySerialisationPlug().setBool(true);
+  manager->populateSerialisationAttributes();
+  EXPECT_TRUE(TfStringStartsWith(serializedLayer(), "#usdc-base64\n"));
+  EXPECT_EQ(1u, manager->serialisationCacheSize());
+
+  // and switching back again gives text once more
+  manager->binarySerialisationPlug().setBool(false);
+  manager->populateSerialisationAttributes();
+  EXPECT_TRUE(TfStringStartsWith(serializedLayer(), "#usda"));
+
+  // anonymous layers are stored as base64 encoded usdc data
+  manager->binarySerialisationPlug().setBool(true);
+  manager->populateSerialisationAttributes();
+  EXPECT_TRUE(TfStringStartsWith(serializedLayer(), "#usdc-base64\n"));
+
+  // and loading them back in creates a new anonymous layer with the same contents
+  manager->loadAllLayers();
+  MStringArray identifiers;
+  manager->getLayerIdentifiers(identifiers);
+  ASSERT_EQ(2u, identifiers.length());
+  const std::string loadedIdentifier = identifiers[0] == anonLayer->GetIdentifier().c_str() ?
+      identifiers[1].asChar() : identifiers[0].asChar();
+  SdfLayerHandle loadedLayer = manager->findLayer(loadedIdentifier);
+  ASSERT_TRUE(loadedLayer);
+  EXPECT_TRUE(loadedLayer->IsAnonymous());
+  EXPECT_TRUE(loadedLayer->GetPrimAtPath(SdfPath("/binary")));
+  auto fooAttr = loadedLayer->GetAttributeAtPath(SdfPath("/binary.foo"));
+  ASSERT_TRUE(fooAttr);
+  EXPECT_EQ(VtValue(5.5f), fooAttr->GetDefaultValue());
+
+  manager->clearSerialisationAttributes();
+  manager->binarySerialisationPlug().setBool(false);
+}
+
 TEST(LayerManager, simpleSaveRestore)
 {
   MFileIO::newFile(true);
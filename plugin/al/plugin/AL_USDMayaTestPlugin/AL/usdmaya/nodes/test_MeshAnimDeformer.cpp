@@ -0,0 +1,146 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/ProxyShape.h"
+
+#include "maya/MAnimControl.h"
+#include "maya/MDagPath.h"
+#include "maya/MFileIO.h"
+#include "maya/MFnDependencyNode.h"
+#include "maya/MFnMesh.h"
+#include "maya/MGlobal.h"
+#include "maya/MPoint.h"
+#include "maya/MSelectionList.h"
+
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/mesh.h"
+
+using AL::maya::test::buildTempPath;
+
+namespace {
+
+// a triangle that moves along the x axis by one unit per frame, from frame 1 to frame 10
+UsdStageRefPtr buildAnimatedTriangle()
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/triangle"));
+  mesh.GetFaceVertexCountsAttr().Set(VtIntArray{ 3 });
+  mesh.GetFaceVertexIndicesAttr().Set(VtIntArray{ 0, 1, 2 });
+  for(int frame = 1; frame <= 10; ++frame)
+  {
+    const float x = float(frame);
+    mesh.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(x, 0, 0), GfVec3f(x + 1.0f, 0, 0), GfVec3f(x, 1.0f, 0) },
+                             UsdTimeCode(frame));
+  }
+  return stage;
+}
+
+// creates a mesh that is deformed by a MeshAnimDeformer reading the triangle, and returns the mesh shape
+MDagPath createDeformedMesh(AL::usdmaya::nodes::ProxyShape* proxy, int32_t readAheadFrames)
+{
+  const MString proxyName = MFnDependencyNode(proxy->thisMObject()).name();
+  MString command;
+  command.format(
+      "createNode transform -n \"triangle\";"
+      "createNode mesh -n \"triangleShape\" -p \"triangle\";"
+      "createNode AL_usdmaya_MeshAnimCreator -n \"triangleCreator\";"
+      "createNode AL_usdmaya_MeshAnimDeformer -n \"triangleDeformer\";"
+      "setAttr -type \"string\" \"triangleCreator.primPath\" \"/triangle\";"
+      "setAttr -type \"string\" \"triangleDeformer.primPath\" \"/triangle\";"
+      "setAttr \"triangleDeformer.readAheadFrames\" ^2s;"
+      "connectAttr \"time1.outTime\" \"triangleDeformer.inTime\";"
+      "connectAttr \"^1s.outStageData\" \"triangleCreator.inStageData\";"
+      "connectAttr \"^1s.outStageData\" \"triangleDeformer.inStageData\";"
+      "connectAttr \"triangleCreator.outMesh\" \"triangleDeformer.inMesh\";"
+      "connectAttr \"triangleDeformer.outMesh\" \"triangleShape.inMesh\";",
+      proxyName, MString() + readAheadFrames);
+  MGlobal::executeCommand(command);
+
+  MSelectionList sl;
+  sl.add("triangleShape");
+  MDagPath path;
+  sl.getDagPath(0, path);
+  return path;
+}
+
+double firstPointX(const MDagPath& meshPath)
+{
+  MPoint point;
+  MFnMesh(meshPath).getPoint(0, point);
+  return point.x;
+}
+
+}
+
+/*
+ * Test that the deformer reads the points at each frame, with and without frames read ahead
+ */
+// MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
+TEST(MeshAnimDeformer, deform)
+{
+  for(int32_t readAheadFrames : { 0, 2 })
+  {
+    MFileIO::newFile(true);
+    const std::string temp_path = buildTempPath("AL_USDMayaTests_MeshAnimDeformer_deform.usda");
+    AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(buildAnimatedTriangle, temp_path);
+    ASSERT_TRUE(proxy);
+    const MDagPath meshPath = createDeformedMesh(proxy, readAheadFrames);
+
+    // forwards, then backwards
+    for(double frame : { 1.0, 2.0, 3.0, 4.0, 8.0, 7.0, 6.0, 2.0 })
+    {
+      MAnimControl::setCurrentTime(MTime(frame, MTime::uiUnit()));
+      EXPECT_NEAR(frame, firstPointX(meshPath), 1e-5);
+    }
+  }
+}
+
+/*
+ * Test that edits to the mesh prim discard the frames that have already been read ahead
+ */
+// void MeshAnimDeformer::onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender)
+TEST(MeshAnimDeformer, editThenEvaluate)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_MeshAnimDeformer_editThenEvaluate.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(buildAnimatedTriangle, temp_path);
+  ASSERT_TRUE(proxy);
+  const MDagPath meshPath = createDeformedMesh(proxy, 2);
+
+  // frames 2 and 3 are read ahead of frame 1
+  MAnimControl::setCurrentTime(MTime(1.0, MTime::uiUnit()));
+  EXPECT_NEAR(1.0, firstPointX(meshPath), 1e-5);
+
+  // edit a frame that has been read ahead
+  UsdGeomMesh mesh(proxy->getUsdStage()->GetPrimAtPath(SdfPath("/triangle")));
+  ASSERT_TRUE(mesh);
+  mesh.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(20.0f, 0, 0), GfVec3f(21.0f, 0, 0), GfVec3f(20.0f, 1.0f, 0) },
+                           UsdTimeCode(2.0));
+  MAnimControl::setCurrentTime(MTime(2.0, MTime::uiUnit()));
+  EXPECT_NEAR(20.0, firstPointX(meshPath), 1e-5);
+
+  // and an unrelated edit keeps the frames that are read ahead valid
+  proxy->getUsdStage()->DefinePrim(SdfPath("/other"));
+  MAnimControl::setCurrentTime(MTime(3.0, MTime::uiUnit()));
+  EXPECT_NEAR(3.0, firstPointX(meshPath), 1e-5);
+
+  // overriding the points in a stronger layer is an edit too
+  proxy->getUsdStage()->SetEditTarget(proxy->getUsdStage()->GetSessionLayer());
+  mesh.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(40.0f, 0, 0), GfVec3f(41.0f, 0, 0), GfVec3f(40.0f, 1.0f, 0) },
+                           UsdTimeCode(4.0));
+  MAnimControl::setCurrentTime(MTime(4.0, MTime::uiUnit()));
+  EXPECT_NEAR(40.0, firstPointX(meshPath), 1e-5);
+}
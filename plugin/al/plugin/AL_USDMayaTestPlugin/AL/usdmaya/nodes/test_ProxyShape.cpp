@@ -17,9 +17,12 @@
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/Transform.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
+#include "AL/usdmaya/Metadata.h"
 #include "AL/usdmaya/StageCache.h"
+#include "AL/usdmaya/fileio/SchemaPrims.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 
+#include "maya/MFnCamera.h"
 #include "maya/MFnTransform.h"
 #include "maya/MSelectionList.h"
 #include "maya/MGlobal.h"
@@ -29,10 +32,15 @@
 #include "maya/MStringArray.h"
 #include "maya/MCommonSystemUtils.h"
 
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/usd/ar/resolver.h"
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/editContext.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
+#include "pxr/usd/usd/variantSets.h"
+#include "pxr/usd/usdGeom/camera.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
 
@@ -1129,7 +1137,40 @@ TEST(ProxyShape, selectedPaths)
 // void findExcludedGeometry();
 TEST(ProxyShape, findExcludedGeometry)
 {
-  AL_USDMAYA_UNTESTED;
+  // enough siblings for the hierarchy to be split into several subtrees
+  std::function<UsdStageRefPtr()> constructExcludedChain = [] ()
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    for(int i = 0; i < 64; ++i)
+    {
+      stage->DefinePrim(SdfPath(TfStringPrintf("/root/child%d/grandchild", i)));
+    }
+    stage->GetPrimAtPath(SdfPath("/root/child3")).SetMetadata(AL::usdmaya::Metadata::excludeFromProxyShape, true);
+    stage->GetPrimAtPath(SdfPath("/root/child42/grandchild")).SetMetadata(AL::usdmaya::Metadata::excludeFromProxyShape, true);
+    return stage;
+  };
+
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_ProxyShape_findExcludedGeometry.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(constructExcludedChain, temp_path);
+  ASSERT_TRUE(proxy);
+  proxy->findExcludedGeometry();
+
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  auto isTaggedAsExcluded = [&stage] (const char* path)
+  {
+    VtValue schemaName = stage->GetPrimAtPath(SdfPath(path)).GetCustomDataByKey(AL::usdmaya::fileio::ALSchemaType);
+    return schemaName.IsHolding<std::string>() &&
+           schemaName.UncheckedGet<std::string>() == AL::usdmaya::fileio::ALExcludedPrimSchema.GetString();
+  };
+
+  // the excluded prims, and the descendants of excluded prims, are created as maya geometry
+  EXPECT_TRUE(isTaggedAsExcluded("/root/child3"));
+  EXPECT_TRUE(isTaggedAsExcluded("/root/child3/grandchild"));
+  EXPECT_TRUE(isTaggedAsExcluded("/root/child42/grandchild"));
+  EXPECT_FALSE(isTaggedAsExcluded("/root"));
+  EXPECT_FALSE(isTaggedAsExcluded("/root/child42"));
+  EXPECT_FALSE(isTaggedAsExcluded("/root/child4/grandchild"));
 }
 
 
@@ -1232,6 +1273,164 @@ TEST(ProxyShape, relativePathSupport)
   checkStageAndRootLayer(stage, bootstrapFullPath);
 }
 
+// static void ProxyShape::loadStages(const std::vector<ProxyShape*>& proxies);
+TEST(ProxyShape, loadStages)
+{
+  MFileIO::newFile(true);
+
+  const std::string temp_paths[] = {
+    buildTempPath("AL_USDMayaTests_loadStages1.usda"),
+    buildTempPath("AL_USDMayaTests_loadStages2.usda")
+  };
+  const MString temp_ma_path = buildTempPath("AL_USDMayaTests_loadStages.ma");
+
+  // generate a different hierarchy for each proxy shape
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root1"));
+    stage->Export(temp_paths[0], false);
+  }
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root2"));
+    stage->Export(temp_paths[1], false);
+  }
+
+  MString shapeNames[2];
+  for(int i = 0; i < 2; ++i)
+  {
+    MFnDagNode fn;
+    MObject xform = fn.create("transform");
+    fn.create("AL_usdmaya_ProxyShape", xform);
+    shapeNames[i] = fn.name();
+
+    AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+    proxy->filePathPlug().setString(temp_paths[i].c_str());
+    proxy->primPathPlug().setString(i ? "/root2" : "/root1");
+    ASSERT_TRUE(proxy->getUsdStage());
+  }
+
+  // reopening the scene loads the stages of both proxy shapes together
+  EXPECT_EQ(MStatus(MS::kSuccess), MFileIO::saveAs(temp_ma_path, NULL, true));
+  MFileIO::newFile(true);
+  MFileIO::open(temp_ma_path, NULL, true);
+
+  std::vector<AL::usdmaya::nodes::ProxyShape*> proxies;
+  for(int i = 0; i < 2; ++i)
+  {
+    MSelectionList sl;
+    EXPECT_EQ(MStatus(MS::kSuccess), sl.add(shapeNames[i]));
+    MObject shape;
+    sl.getDependNode(0, shape);
+    MFnDagNode fn(shape);
+    AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+    ASSERT_TRUE(proxy);
+
+    UsdStageRefPtr stage = proxy->getUsdStage();
+    ASSERT_TRUE(stage);
+    EXPECT_EQ(temp_paths[i], stage->GetRootLayer()->GetRealPath());
+    EXPECT_EQ(SdfPath(i ? "/root2" : "/root1"), proxy->getRootPrim().GetPath());
+    EXPECT_TRUE(AL::usdmaya::StageCache::Get().Contains(stage));
+    proxies.push_back(proxy);
+  }
+
+  // reloading the stages directly hands each proxy shape its own stage back, opened with a resolver context built
+  // from its own resolver config (or file path)
+  const std::string resolverConfig = buildTempPath("AL_USDMayaTests_loadStagesConfig/config.usda");
+  proxies[1]->assetResolverConfigPlug().setString(resolverConfig.c_str());
+  const std::string resolverAssets[] = { temp_paths[0], resolverConfig };
+  AL::usdmaya::nodes::ProxyShape::loadStages(proxies);
+  for(int i = 0; i < 2; ++i)
+  {
+    UsdStageRefPtr stage = proxies[i]->getUsdStage();
+    ASSERT_TRUE(stage);
+    EXPECT_EQ(temp_paths[i], stage->GetRootLayer()->GetRealPath());
+    EXPECT_EQ(SdfPath(i ? "/root2" : "/root1"), proxies[i]->getRootPrim().GetPath());
+    EXPECT_EQ(ArGetResolver().CreateDefaultContextForAsset(resolverAssets[i]), stage->GetPathResolverContext());
+  }
+
+  // with parallel loading turned off, the resolver is configured before each stage is opened, and the stages build
+  // their contexts from their root layers as they did before the stages were opened together
+  MGlobal::setOptionVarValue("AL_usdmaya_parallelStageLoad", 0);
+  AL::usdmaya::nodes::ProxyShape::loadStages(proxies);
+  MGlobal::setOptionVarValue("AL_usdmaya_parallelStageLoad", 1);
+  for(int i = 0; i < 2; ++i)
+  {
+    UsdStageRefPtr stage = proxies[i]->getUsdStage();
+    ASSERT_TRUE(stage);
+    EXPECT_EQ(temp_paths[i], stage->GetRootLayer()->GetRealPath());
+    EXPECT_EQ(SdfPath(i ? "/root2" : "/root1"), proxies[i]->getRootPrim().GetPath());
+    EXPECT_EQ(ArGetResolver().CreateDefaultContextForAsset(temp_paths[i]), stage->GetPathResolverContext());
+  }
+}
+
+/*
+ * Test that a resync only skips the prims whose composition is unchanged when a variant is switched. Any other
+ * resync may have edited the contents of the contributing layers, so those prims are updated.
+ */
+// void ProxyShape::translatePrimsIntoMaya(const SdfPathVector& importPaths, const SdfPathVector& teardownPaths, ...)
+TEST(ProxyShape, resyncUpdatesEditedPrims)
+{
+  MFileIO::newFile(true);
+  auto constructStage = [] ()
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    UsdGeomCamera cam = UsdGeomCamera::Define(stage, SdfPath("/root/cam"));
+    cam.GetFocalLengthAttr().Set(35.0f);
+
+    UsdVariantSet variantSet = stage->GetPrimAtPath(SdfPath("/root")).GetVariantSets().AddVariantSet("shot");
+    for(const char* const variant : { "a", "b" })
+    {
+      variantSet.AddVariant(variant);
+      variantSet.SetVariantSelection(variant);
+      UsdEditContext context(variantSet.GetVariantEditContext());
+      stage->DefinePrim(SdfPath(std::string("/root/cam") + variant), TfToken("Camera"));
+    }
+    variantSet.SetVariantSelection("a");
+    return stage;
+  };
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_resyncUpdatesEditedPrims.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(constructStage, temp_path);
+  ASSERT_TRUE(proxy);
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+
+  auto camShape = [] ()
+  {
+    MSelectionList sl;
+    sl.add("camShape");
+    MObject obj;
+    sl.getDependNode(0, obj);
+    return obj;
+  };
+  auto focalLength = [&camShape] ()
+  {
+    return MFnCamera(camShape()).focalLength();
+  };
+  auto exists = [] (const char* const name)
+  {
+    MSelectionList sl;
+    return sl.add(name) == MS::kSuccess;
+  };
+  EXPECT_NEAR(35.0, focalLength(), 1e-5);
+  EXPECT_TRUE(exists("camaShape"));
+
+  // an explicit resync of /root, followed by an edit of the layer that contributes the camera. The composition
+  // of the camera is unchanged, but its contents are not.
+  proxy->primChangedAtPath(SdfPath("/root"));
+  UsdGeomCamera(stage->GetPrimAtPath(SdfPath("/root/cam"))).GetFocalLengthAttr().Set(50.0f);
+  EXPECT_NEAR(50.0, focalLength(), 1e-5);
+
+  // a variant switch leaves the camera outside of the variant alone
+  MFnCamera(camShape()).setFocalLength(70.0);
+  stage->GetPrimAtPath(SdfPath("/root")).GetVariantSet("shot").SetVariantSelection("b");
+  EXPECT_NEAR(70.0, focalLength(), 1e-5);
+  EXPECT_FALSE(exists("camaShape"));
+  EXPECT_TRUE(exists("cambShape"));
+}
+
 //
 // funcs that aren't easily testable:
 //
@@ -117,3 +117,37 @@ TEST(ProxyShapeSelectabilityDB, selectableIsRemoval)
   //Check that the path has been removed from the selectable list
   EXPECT_FALSE(proxyShape->selectabilityDB().isPathUnselectable(expectedSelectable));
 }
+
+/*
+ * Tests that prims below an instanceable reference are visited through their instance master when opening a stage
+ */
+TEST(ProxyShapeSelectabilityDB, selectablesInInstanceMaster)
+{
+  std::function<UsdStageRefPtr()>  constructInstancedChain = [] ()
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    stage->DefinePrim(SdfPath("/Asset/Geo/Mesh"));
+    UsdPrim geo = stage->GetPrimAtPath(SdfPath("/Asset/Geo"));
+    geo.SetMetadata(AL::usdmaya::Metadata::selectability, AL::usdmaya::Metadata::unselectable);
+
+    for(const char* instancePath : { "/InstanceA", "/InstanceB" })
+    {
+      UsdPrim instance = stage->DefinePrim(SdfPath(instancePath));
+      instance.GetReferences().AddInternalReference(SdfPath("/Asset"));
+      instance.SetInstanceable(true);
+    }
+    return stage;
+  };
+
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_ProxyShape_selectablesInInstanceMaster.usda");
+  AL::usdmaya::nodes::ProxyShape* proxyShape = CreateMayaProxyShape(constructInstancedChain, temp_path);
+
+  UsdPrim instance = proxyShape->getUsdStage()->GetPrimAtPath(SdfPath("/InstanceA"));
+  ASSERT_TRUE(instance.IsInstance());
+  const SdfPath masterPath = instance.GetMaster().GetPath();
+
+  EXPECT_TRUE(proxyShape->selectabilityDB().isPathUnselectable(SdfPath("/Asset/Geo")));
+  EXPECT_TRUE(proxyShape->selectabilityDB().isPathUnselectable(masterPath.AppendChild(TfToken("Geo"))));
+  EXPECT_FALSE(proxyShape->selectabilityDB().isPathUnselectable(masterPath));
+}
@@ -880,6 +880,20 @@ TEST(Transform, animationValuesFromUsdAreCorrectlyRead)
       EXPECT_NEAR(scaleValues[i][2], s[2], 1e-5f);
     }
 
+    // the same values are read when the proxy shape samples the transforms ahead of the current time
+    proxy->transformPrefetchFramesPlug().setValue(10);
+    for(int i = 49; i >= 0; i -= 7)
+    {
+      MTime time(i, MTime::uiUnit());
+      MAnimControl::setCurrentTime(time);
+
+      MVector T = fnx.getTranslation(MSpace::kTransform);
+      EXPECT_NEAR(translateValues[i][0], T.x, 1e-5f);
+      EXPECT_NEAR(translateValues[i][1], T.y, 1e-5f);
+      EXPECT_NEAR(translateValues[i][2], T.z, 1e-5f);
+    }
+    proxy->transformPrefetchFramesPlug().setValue(0);
+
     {
       auto timePlug = transformNode->timePlug();
       auto timeOffsetPlug = transformNode->timeOffsetPlug();
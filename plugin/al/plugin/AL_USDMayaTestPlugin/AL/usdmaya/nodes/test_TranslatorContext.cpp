@@ -235,6 +235,28 @@ TEST(TranslatorContext, TranslatorContext)
       context->removeItems(SdfPath("/root/rig"));
     }
 
+    {
+      // scenes saved by older versions store the translator context as text
+      obj = fnd.create("polyCube");
+      MString text = MString("/root/rig=ALMayaReference,") + MFnDagNode(rigObj).fullPathName() + "," +
+                     MFnDependencyNode(obj).name() + ";";
+      context->clearPrimMappings();
+      context->deserialise(text);
+      {
+        AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+        context->getMObjects(SdfPath("/root/rig"), handles);
+        ASSERT_EQ(handles.size(), 1);
+        EXPECT_TRUE(handles[0].object() == obj);
+      }
+      {
+        MObjectHandle handle;
+        context->getTransform(SdfPath("/root/rig"), handle);
+        EXPECT_TRUE(handle.object() == rigObj);
+      }
+      EXPECT_TRUE(context->serialise() != text);
+      context->removeItems(SdfPath("/root/rig"));
+    }
+
     {
       obj = fnd.create("polyCube");
       context->registerItem(prim, transformHandle);
@@ -263,6 +285,64 @@ TEST(TranslatorContext, TranslatorContext)
 }
 
 
+// void TranslatorContext::deserialise(const MString& string);
+TEST(TranslatorContext, deserialiseCorrupt)
+{
+  auto constructRoot = [] ()
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    return stage;
+  };
+
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_TranslatorContext_deserialiseCorrupt.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(constructRoot, temp_path);
+  ASSERT_TRUE(proxy);
+
+  AL::usdmaya::fileio::translators::TranslatorContextPtr context = proxy->context();
+  UsdPrim prim = proxy->getUsdStage()->GetPrimAtPath(SdfPath("/root"));
+
+  MFnDagNode fn;
+  MFnDependencyNode fnd;
+  MObject xformObj = fn.create("transform");
+  MObject obj = fnd.create("polyCube");
+  context->clearPrimMappings();
+  context->registerItem(prim, MObjectHandle(xformObj));
+  context->insertItem(prim, obj);
+  const MString text = context->serialise();
+  ASSERT_EQ(text.substring(0, 5), MString("ALTC1:"));
+
+  // each of these fails, and leaves the prim mappings restored from the valid data untouched
+  const MString payload = text.substring(6, text.length() - 1);
+  const MString truncated = MString("ALTC1:") + payload.substring(0, (payload.length() / 2) / 4 * 4 - 1);
+  const MString badCharacters = MString("ALTC1:") + "!!!!" + payload;
+  const MString unknownVersion = MString("ALTC99:") + payload;
+  const MString noSeparator = MString("ALTC1") + payload;
+
+  for(const MString& corrupt : { truncated, badCharacters, unknownVersion, noSeparator })
+  {
+    context->clearPrimMappings();
+    context->deserialise(text);
+    context->deserialise(corrupt);
+
+    AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+    context->getMObjects(SdfPath("/root"), handles);
+    ASSERT_EQ(handles.size(), 1);
+    EXPECT_TRUE(handles[0].object() == obj);
+    MObjectHandle handle;
+    EXPECT_TRUE(context->getTransform(SdfPath("/root"), handle));
+    EXPECT_TRUE(handle.object() == xformObj);
+  }
+
+  // corrupt data on its own does not add any prim mappings
+  context->clearPrimMappings();
+  context->deserialise(truncated);
+  EXPECT_TRUE(context->getTypeForPath(SdfPath("/root")).IsEmpty());
+  context->deserialise(unknownVersion);
+  EXPECT_TRUE(context->getTypeForPath(SdfPath("/root")).IsEmpty());
+}
+
 // TranslatorContext::~TranslatorContext();
 // void TranslatorContext::updatePrimTypes();
 // void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object);
@@ -0,0 +1,202 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <AL/usdmaya/BoundingBoxCache.h>
+#include <gtest/gtest.h>
+
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/tokens.h"
+
+using namespace AL::usdmaya;
+
+namespace {
+
+UsdGeomMesh defineTriangle(const UsdStageRefPtr& stage, const char* path)
+{
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath(path));
+  VtVec3fArray points = { GfVec3f(0, 0, 0), GfVec3f(1, 0, 0), GfVec3f(0, 1, 0) };
+  mesh.GetPointsAttr().Set(points);
+  mesh.GetFaceVertexCountsAttr().Set(VtIntArray{ 3 });
+  mesh.GetFaceVertexIndicesAttr().Set(VtIntArray{ 0, 1, 2 });
+  return mesh;
+}
+
+}
+
+/*
+ * Test that a static hierarchy only ever caches a single bound
+ */
+// GfRange3d BoundingBoxCache::bound(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes)
+// bool BoundingBoxCache::isStatic() const
+TEST(BoundingBoxCache, staticHierarchy)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  defineTriangle(stage, "/root/triangle");
+  const UsdPrim root = stage->GetPrimAtPath(SdfPath("/root"));
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+
+  BoundingBoxCache cache;
+  for(double time = 0; time < 10.0; time += 1.0)
+  {
+    GfRange3d range = cache.bound(root, UsdTimeCode(time), purposes);
+    EXPECT_EQ(GfVec3d(1, 1, 0), range.GetMax());
+  }
+  EXPECT_TRUE(cache.isStatic());
+  EXPECT_EQ(1u, cache.size());
+}
+
+/*
+ * Test that an animated hierarchy caches a bound per time, and evicts the least recently used ones
+ */
+// GfRange3d BoundingBoxCache::bound(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes)
+// void BoundingBoxCache::clear()
+TEST(BoundingBoxCache, animatedHierarchy)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = defineTriangle(stage, "/root/triangle");
+  for(int frame = 0; frame < 10; ++frame)
+  {
+    const float scale = 1.0f + frame;
+    VtVec3fArray points = { GfVec3f(0, 0, 0), GfVec3f(scale, 0, 0), GfVec3f(0, scale, 0) };
+    mesh.GetPointsAttr().Set(points, UsdTimeCode(frame));
+  }
+  const UsdPrim root = stage->GetPrimAtPath(SdfPath("/root"));
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+
+  BoundingBoxCache cache(4);
+  EXPECT_EQ(GfVec3d(3, 3, 0), cache.bound(root, UsdTimeCode(2.0), purposes).GetMax());
+  EXPECT_FALSE(cache.isStatic());
+  EXPECT_EQ(GfVec3d(1, 1, 0), cache.bound(root, UsdTimeCode(0.0), purposes).GetMax());
+  EXPECT_EQ(2u, cache.size());
+
+  // the least recently used bounds are evicted once the cache is full
+  for(double time = 3.0; time < 10.0; time += 1.0)
+  {
+    EXPECT_EQ(GfVec3d(time + 1, time + 1, 0), cache.bound(root, UsdTimeCode(time), purposes).GetMax());
+  }
+  EXPECT_EQ(4u, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(GfVec3d(2, 2, 0), cache.bound(root, UsdTimeCode(1.0), purposes).GetMax());
+  EXPECT_EQ(1u, cache.size());
+}
+
+namespace {
+
+/// forwards the ObjectsChanged notices of a stage to a cache, as the proxy shape does
+struct BoundsInvalidator : public TfWeakBase
+{
+  BoundsInvalidator(BoundingBoxCache& cache, const UsdStageRefPtr& stage)
+    : m_cache(cache)
+  {
+    m_key = TfNotice::Register(TfCreateWeakPtr(this), &BoundsInvalidator::onObjectsChanged, UsdStageWeakPtr(stage));
+  }
+
+  ~BoundsInvalidator()
+  {
+    TfNotice::Revoke(m_key);
+  }
+
+  void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender)
+  {
+    m_cache.invalidate(notice);
+  }
+
+  BoundingBoxCache& m_cache;
+  TfNotice::Key m_key;
+};
+
+}
+
+/*
+ * Test that edits below the prim discard the cached bounds, and that a static hierarchy notices new animation
+ */
+// void BoundingBoxCache::invalidate(const UsdNotice::ObjectsChanged& notice)
+TEST(BoundingBoxCache, invalidate)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = defineTriangle(stage, "/root/triangle");
+  UsdGeomMesh other = defineTriangle(stage, "/other/triangle");
+  const UsdPrim root = stage->GetPrimAtPath(SdfPath("/root"));
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+
+  BoundingBoxCache cache;
+  BoundsInvalidator invalidator(cache, stage);
+  EXPECT_EQ(GfVec3d(1, 1, 0), cache.bound(root, UsdTimeCode(0.0), purposes).GetMax());
+  EXPECT_TRUE(cache.isStatic());
+
+  // edits outside of the hierarchy keep the cached bound
+  other.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(0, 0, 0), GfVec3f(5, 0, 0), GfVec3f(0, 5, 0) });
+  EXPECT_EQ(1u, cache.size());
+
+  // edits inside of it do not, and the hierarchy stays static
+  mesh.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(0, 0, 0), GfVec3f(2, 0, 0), GfVec3f(0, 2, 0) });
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(GfVec3d(2, 2, 0), cache.bound(root, UsdTimeCode(0.0), purposes).GetMax());
+  EXPECT_TRUE(cache.isStatic());
+
+  // animating the points makes the hierarchy animated
+  mesh.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(0, 0, 0), GfVec3f(3, 0, 0), GfVec3f(0, 3, 0) }, UsdTimeCode(1.0));
+  mesh.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(0, 0, 0), GfVec3f(4, 0, 0), GfVec3f(0, 4, 0) }, UsdTimeCode(2.0));
+  EXPECT_FALSE(cache.isStatic());
+  EXPECT_EQ(GfVec3d(3, 3, 0), cache.bound(root, UsdTimeCode(1.0), purposes).GetMax());
+  EXPECT_EQ(GfVec3d(4, 4, 0), cache.bound(root, UsdTimeCode(2.0), purposes).GetMax());
+
+  // new prims below the prim are taken into account
+  UsdGeomMesh added = defineTriangle(stage, "/root/added");
+  added.GetPointsAttr().Set(VtVec3fArray{ GfVec3f(0, 0, 0), GfVec3f(10, 0, 0), GfVec3f(0, 10, 0) });
+  EXPECT_EQ(GfVec3d(10, 10, 0), cache.bound(root, UsdTimeCode(1.0), purposes).GetMax());
+}
+
+/*
+ * Test that asking for the bounds of a different prim discards the bounds of the previous one
+ */
+// GfRange3d BoundingBoxCache::bound(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes)
+TEST(BoundingBoxCache, primChange)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  defineTriangle(stage, "/small/triangle");
+  UsdGeomMesh large = defineTriangle(stage, "/large/triangle");
+  for(int frame = 0; frame < 2; ++frame)
+  {
+    const float scale = 5.0f + frame;
+    VtVec3fArray points = { GfVec3f(0, 0, 0), GfVec3f(scale, 0, 0), GfVec3f(0, scale, 0) };
+    large.GetPointsAttr().Set(points, UsdTimeCode(frame));
+  }
+  const UsdPrim small = stage->GetPrimAtPath(SdfPath("/small"));
+  const UsdPrim animated = stage->GetPrimAtPath(SdfPath("/large"));
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+
+  BoundingBoxCache cache;
+  EXPECT_EQ(GfVec3d(1, 1, 0), cache.bound(small, UsdTimeCode(0.0), purposes).GetMax());
+  EXPECT_TRUE(cache.isStatic());
+
+  // the static bound of the first prim is not returned for the second one, which is animated
+  EXPECT_EQ(GfVec3d(5, 5, 0), cache.bound(animated, UsdTimeCode(0.0), purposes).GetMax());
+  EXPECT_FALSE(cache.isStatic());
+  EXPECT_EQ(GfVec3d(6, 6, 0), cache.bound(animated, UsdTimeCode(1.0), purposes).GetMax());
+  EXPECT_EQ(2u, cache.size());
+
+  // and switching back finds the first prim to be static again
+  EXPECT_EQ(GfVec3d(1, 1, 0), cache.bound(small, UsdTimeCode(1.0), purposes).GetMax());
+  EXPECT_TRUE(cache.isStatic());
+  EXPECT_EQ(1u, cache.size());
+}
@@ -88,3 +88,41 @@ TEST(SelectabilityDB, removePaths)
     EXPECT_TRUE(unselectablePaths.size() == 1);
   }
 }
+
+/*
+ * Test that the batch API keeps the paths sorted and ignores duplicates
+ */
+// void SelectableDB::addPathsAsUnselectable(const SdfPathVector& paths)
+// void SelectableDB::removePathsAsUnselectable(const SdfPathVector& paths)
+TEST(SelectabilityDB, batchPaths)
+{
+  SdfPath rootPath        ("/A");
+  SdfPath childPath       ("/A/B");
+  SdfPath grandchildPath  ("/A/B/C");
+  SdfPath secondChildPath ("/A/D");
+
+  SelectabilityDB selectable;
+  {
+    selectable.addPathsAsUnselectable({secondChildPath, grandchildPath, childPath, grandchildPath});
+    const SdfPathVector& unselectablePaths = selectable.getUnselectablePaths();
+    ASSERT_TRUE(unselectablePaths.size() == 3);
+    EXPECT_TRUE(unselectablePaths[0] == childPath);
+    EXPECT_TRUE(unselectablePaths[1] == grandchildPath);
+    EXPECT_TRUE(unselectablePaths[2] == secondChildPath);
+
+    selectable.addPathsAsUnselectable({childPath});
+    EXPECT_TRUE(unselectablePaths.size() == 3);
+
+    // removing the parent keeps the explicitly unselectable child
+    selectable.removePathsAsUnselectable({childPath, rootPath});
+    ASSERT_TRUE(unselectablePaths.size() == 2);
+    EXPECT_FALSE(selectable.isPathUnselectable(childPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(grandchildPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(SdfPath("/A/B/C/E")));
+    EXPECT_TRUE(selectable.isPathUnselectable(secondChildPath));
+
+    selectable.removePathsAsUnselectable({grandchildPath, secondChildPath});
+    EXPECT_TRUE(unselectablePaths.empty());
+    EXPECT_FALSE(selectable.isPathUnselectable(grandchildPath));
+  }
+}
@@ -0,0 +1,224 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <AL/usdmaya/TransformSampleCache.h>
+#include <gtest/gtest.h>
+
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/xform.h"
+
+using namespace AL::usdmaya;
+
+namespace {
+
+UsdStageRefPtr createAnimatedStage()
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform animated = UsdGeomXform::Define(stage, SdfPath("/animated"));
+  UsdGeomXformOp translate = animated.AddTranslateOp(UsdGeomXformOp::PrecisionFloat);
+  UsdGeomXformOp rotate = animated.AddRotateXYZOp(UsdGeomXformOp::PrecisionFloat);
+  UsdGeomXformOp scale = animated.AddScaleOp(UsdGeomXformOp::PrecisionFloat);
+  translate.Set(GfVec3f(0, 0, 0), UsdTimeCode(1.0));
+  translate.Set(GfVec3f(9.0f, 0, 0), UsdTimeCode(10.0));
+  rotate.Set(GfVec3f(0, 0, 0), UsdTimeCode(1.0));
+  rotate.Set(GfVec3f(0, 90.0f, 0), UsdTimeCode(10.0));
+  scale.Set(GfVec3f(2.0f, 2.0f, 2.0f));
+
+  UsdGeomXform still = UsdGeomXform::Define(stage, SdfPath("/static"));
+  still.AddTranslateOp(UsdGeomXformOp::PrecisionFloat).Set(GfVec3f(1.0f, 2.0f, 3.0f));
+  return stage;
+}
+
+struct SampleInvalidator : public TfWeakBase
+{
+  SampleInvalidator(TransformSampleCache& cache, const UsdStageRefPtr& stage)
+    : m_cache(cache)
+  {
+    m_key = TfNotice::Register(TfCreateWeakPtr(this), &SampleInvalidator::onObjectsChanged, UsdStageWeakPtr(stage));
+  }
+
+  ~SampleInvalidator()
+  {
+    TfNotice::Revoke(m_key);
+  }
+
+  void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender)
+  {
+    m_cache.invalidate(notice);
+  }
+
+  TransformSampleCache& m_cache;
+  TfNotice::Key m_key;
+};
+
+}
+
+/*
+ * Test that the sampler only reads the animated transform ops
+ */
+// void TransformSampler::init(const UsdPrim& prim)
+// void TransformSampler::sample(TransformSample& sample, UsdTimeCode time) const
+TEST(TransformSampleCache, sampler)
+{
+  UsdStageRefPtr stage = createAnimatedStage();
+
+  TransformSampler sampler;
+  sampler.init(stage->GetPrimAtPath(SdfPath("/static")));
+  EXPECT_TRUE(sampler.empty());
+
+  sampler.init(stage->GetPrimAtPath(SdfPath("/animated")));
+  EXPECT_FALSE(sampler.empty());
+
+  TransformSample sample;
+  sampler.sample(sample, UsdTimeCode(4.0));
+  EXPECT_NEAR(3.0, sample.translation.x, 1e-5);
+  EXPECT_NEAR(30.0 * 3.141592654 / 180.0, sample.rotation.y, 1e-5);
+  EXPECT_EQ(MEulerRotation::kXYZ, sample.rotation.order);
+
+  // the scale is not animated, so is left untouched
+  EXPECT_EQ(MVector(1.0, 1.0, 1.0), sample.scale);
+}
+
+/*
+ * Test that the animated transforms are cached for every frame of the window
+ */
+// void TransformSampleCache::prefetch(const UsdStageRefPtr& stage, const SdfPathVector& paths, double startFrame, double endFrame)
+// bool TransformSampleCache::lookup(const SdfPath& path, UsdTimeCode time, TransformSample& sample) const
+// bool TransformSampleCache::contains(UsdTimeCode time) const
+TEST(TransformSampleCache, prefetch)
+{
+  UsdStageRefPtr stage = createAnimatedStage();
+  const SdfPath animated("/animated");
+  const SdfPath still("/static");
+
+  TransformSampleCache cache;
+  cache.prefetch(stage, { animated, still, SdfPath("/missing") }, 2.0, 6.0);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_TRUE(cache.contains(animated));
+  EXPECT_FALSE(cache.contains(still));
+
+  EXPECT_FALSE(cache.contains(UsdTimeCode(1.0)));
+  EXPECT_TRUE(cache.contains(UsdTimeCode(2.0)));
+  EXPECT_TRUE(cache.contains(UsdTimeCode(6.0)));
+  EXPECT_FALSE(cache.contains(UsdTimeCode(6.5)));
+  EXPECT_FALSE(cache.contains(UsdTimeCode(7.0)));
+  EXPECT_FALSE(cache.contains(UsdTimeCode::Default()));
+
+  TransformSampler sampler;
+  sampler.init(stage->GetPrimAtPath(animated));
+  for(double frame = 2.0; frame <= 6.0; frame += 1.0)
+  {
+    TransformSample cached, expected;
+    EXPECT_TRUE(cache.lookup(animated, UsdTimeCode(frame), cached));
+    sampler.sample(expected, UsdTimeCode(frame));
+    EXPECT_NEAR(frame - 1.0, cached.translation.x, 1e-5);
+    EXPECT_EQ(expected.translation, cached.translation);
+    EXPECT_EQ(expected.rotation, cached.rotation);
+  }
+
+  TransformSample sample;
+  EXPECT_FALSE(cache.lookup(still, UsdTimeCode(2.0), sample));
+  EXPECT_FALSE(cache.lookup(animated, UsdTimeCode(2.5), sample));
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_FALSE(cache.contains(UsdTimeCode(2.0)));
+}
+
+/*
+ * Test that the window of frames is shortened to keep within the sampling budget
+ */
+// void TransformSampleCache::prefetch(const UsdStageRefPtr& stage, const SdfPathVector& paths, double startFrame, double endFrame)
+TEST(TransformSampleCache, prefetchBudget)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  const size_t numPrims = TransformSampleCache::kMaxPrefetchSamples / 8;
+  SdfPathVector paths;
+  for(size_t i = 0; i < numPrims; ++i)
+  {
+    paths.push_back(SdfPath(TfStringPrintf("/xform%zu", i)));
+    UsdGeomXformOp translate = UsdGeomXform::Define(stage, paths.back()).AddTranslateOp();
+    translate.Set(GfVec3d(0, 0, 0), UsdTimeCode(1.0));
+    translate.Set(GfVec3d(1.0, 0, 0), UsdTimeCode(2.0));
+  }
+
+  TransformSampleCache cache;
+  cache.prefetch(stage, paths, 1.0, 100.0);
+  EXPECT_EQ(numPrims, cache.size());
+  EXPECT_TRUE(cache.contains(UsdTimeCode(1.0)));
+  EXPECT_TRUE(cache.contains(UsdTimeCode(8.0)));
+  EXPECT_FALSE(cache.contains(UsdTimeCode(9.0)));
+
+  TransformSample sample;
+  EXPECT_TRUE(cache.lookup(paths.back(), UsdTimeCode(2.0), sample));
+  EXPECT_EQ(MVector(1.0, 0, 0), sample.translation);
+}
+
+/*
+ * Test that edits to the transform ops discard the cached samples, and are counted per prim
+ */
+// void TransformSampleCache::invalidate(const UsdNotice::ObjectsChanged& notice)
+// size_t TransformSampleCache::editCount(const SdfPath& path) const
+TEST(TransformSampleCache, invalidate)
+{
+  UsdStageRefPtr stage = createAnimatedStage();
+  const SdfPath animated("/animated");
+  const SdfPath still("/static");
+
+  TransformSampleCache cache;
+  SampleInvalidator invalidator(cache, stage);
+  cache.prefetch(stage, { animated, still }, 1.0, 10.0);
+  EXPECT_EQ(1u, cache.size());
+  const size_t animatedCount = cache.editCount(animated);
+  const size_t stillCount = cache.editCount(still);
+
+  // edits to attributes that aren't transform ops are ignored
+  bool resetsXformStack = false;
+  UsdPrim animatedPrim = stage->GetPrimAtPath(animated);
+  UsdGeomXform(animatedPrim).GetVisibilityAttr().Set(UsdGeomTokens->invisible);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(animatedCount, cache.editCount(animated));
+
+  // edits to the transform ops of a prim that isn't cached keep the samples, but are counted for that prim only
+  UsdGeomXform(stage->GetPrimAtPath(still)).GetOrderedXformOps(&resetsXformStack)[0].Set(GfVec3f(4.0f, 0, 0), UsdTimeCode(5.0));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_NE(stillCount, cache.editCount(still));
+  EXPECT_EQ(animatedCount, cache.editCount(animated));
+
+  // edits to the transform ops of a cached prim discard the samples, and the new value is read by a new sampler
+  UsdGeomXformOp translate = UsdGeomXform(animatedPrim).GetOrderedXformOps(&resetsXformStack)[0];
+  translate.Set(GfVec3f(2.0f, 0, 0), UsdTimeCode(5.0));
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_FALSE(cache.contains(UsdTimeCode(5.0)));
+  EXPECT_NE(animatedCount, cache.editCount(animated));
+
+  TransformSampler sampler;
+  sampler.init(animatedPrim);
+  TransformSample sample;
+  sampler.sample(sample, UsdTimeCode(5.0));
+  EXPECT_NEAR(2.0, sample.translation.x, 1e-5);
+
+  // a resync counts as an edit of every prim
+  const size_t stillEditCount = cache.editCount(still);
+  const size_t otherEditCount = cache.editCount(SdfPath("/other"));
+  stage->DefinePrim(SdfPath("/new"));
+  EXPECT_NE(stillEditCount, cache.editCount(still));
+  EXPECT_NE(otherEditCount, cache.editCount(SdfPath("/other")));
+}
@@ -16,6 +16,7 @@
 #include "test_usdmaya.h"
 
 #include "AL/usdmaya/fileio/AnimationTranslator.h"
+#include "AL/usdmaya/fileio/ExportParams.h"
 
 #include "maya/MDGModifier.h"
 #include "maya/MDoubleArray.h"
@@ -28,6 +29,8 @@
 #include "maya/MPointArray.h"
 #include "maya/MSelectionList.h"
 
+#include "pxr/usd/usdGeom/mesh.h"
+
 using AL::usdmaya::fileio::AnimationTranslator;
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -475,3 +478,46 @@ TEST(translators_AnimationTranslator, isAnimatedTransform)
 
 
 
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(translators_AnimationTranslator, meshContextsAreReused)
+{
+  MFileIO::newFile(true);
+  setUp();
+
+  MGlobal::executeCommand("polyCube -n cube", false, true);
+  MSelectionList sl;
+  sl.add("cubeShape");
+  MDagPath path;
+  sl.getDagPath(0, path);
+
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/cube"));
+  UsdAttribute pointsAttr = mesh.CreatePointsAttr();
+
+  AnimationTranslator translator;
+  translator.addMesh(path, pointsAttr);
+
+  AL::usdmaya::fileio::ExporterParams params;
+  params.m_minFrame = 1.0;
+  params.m_maxFrame = 4.0;
+  translator.exportAnimation(params);
+
+  EXPECT_EQ(4u, pointsAttr.GetNumTimeSamples());
+
+  VtArray<GfVec3f> points;
+  EXPECT_TRUE(pointsAttr.Get(&points, UsdTimeCode(2.0)));
+  EXPECT_EQ(8u, points.size());
+
+  // every sample was kept by the layer, so each frame needed a buffer of its own
+  EXPECT_EQ(0u, translator.meshPointsBufferReuses());
+
+  // the persistent contexts only live for the duration of the export, so exporting again writes the same samples.
+  // With filtering, the cube doesn't move after the first frame, so the samples of frames 3 and 4 are read into the
+  // buffer of the filtered sample before them.
+  pointsAttr.Clear();
+  params.m_filterSample = true;
+  translator.exportAnimation(params);
+  EXPECT_EQ(1u, pointsAttr.GetNumTimeSamples());
+  EXPECT_EQ(2u, translator.meshPointsBufferReuses());
+}
@@ -52,6 +52,24 @@ MStatus Mesh::initialize()
   return MStatus::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+UsdTimeCode Mesh::importTimeCode() const
+{
+  TranslatorContextPtr ctx = context();
+  return (ctx && ctx->getForceDefaultRead()) ? UsdTimeCode::Default() : UsdTimeCode::EarliestTime();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Mesh::preImport(const UsdPrim& prim)
+{
+  AL::usdmaya::utils::MeshImportData data;
+  data.read(UsdGeomMesh(prim), importTimeCode());
+
+  std::lock_guard<std::mutex> lock(m_preImportedMutex);
+  m_preImported[prim.GetPath()] = std::move(data);
+  return MStatus::kSuccess;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
 {
@@ -60,7 +78,25 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
   const UsdGeomMesh mesh(prim);
 
   TranslatorContextPtr ctx = context();
-  UsdTimeCode timeCode = (ctx && ctx->getForceDefaultRead()) ? UsdTimeCode::Default() : UsdTimeCode::EarliestTime();
+  UsdTimeCode timeCode = importTimeCode();
+
+  // use the data read by preImport if there is any, otherwise read it now
+  AL::usdmaya::utils::MeshImportData data;
+  bool preImported = false;
+  {
+    std::lock_guard<std::mutex> lock(m_preImportedMutex);
+    auto it = m_preImported.find(prim.GetPath());
+    if(it != m_preImported.end())
+    {
+      data = std::move(it->second);
+      m_preImported.erase(it);
+      preImported = true;
+    }
+  }
+  if(!preImported)
+  {
+    data.read(mesh, timeCode);
+  }
 
   bool parentUnmerged = false;
   TfToken val;
@@ -74,7 +110,7 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
     dagName += "Shape";
   }
 
-  AL::usdmaya::utils::MeshImportContext importContext(mesh, parent, dagName, timeCode);
+  AL::usdmaya::utils::MeshImportContext importContext(mesh, parent, dagName, timeCode, data);
   importContext.applyVertexNormals();
   importContext.applyHoleFaces();
   importContext.applyVertexCreases();
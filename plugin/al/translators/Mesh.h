@@ -16,6 +16,10 @@
 
 #pragma once
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
+#include "AL/usdmaya/utils/MeshUtils.h"
+
+#include <mutex>
+#include <unordered_map>
 
 
 namespace AL{
@@ -32,6 +36,7 @@ public:
   AL_USDMAYA_DECLARE_TRANSLATOR(Mesh);
 private:
   MStatus initialize() override;
+  MStatus preImport(const UsdPrim& prim) override;
   MStatus import(const UsdPrim& prim, MObject& parent, MObject& createdObj) override;
   UsdPrim exportObject(UsdStageRefPtr stage, MDagPath dagPath, const SdfPath& usdPath,
                        const ExporterParams& params) override;
@@ -55,6 +60,12 @@ private:
   };
   void writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options = kDynamicAttributes);
 
+  UsdTimeCode importTimeCode() const;
+
+  // the data read by preImport, until the prim is imported
+  std::unordered_map<SdfPath, AL::usdmaya::utils::MeshImportData, SdfPath::Hash> m_preImported;
+  std::mutex m_preImportedMutex;
+
 };
 
 //----------------------------------------------------------------------------------------------------------------------
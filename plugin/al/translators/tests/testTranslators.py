@@ -272,6 +272,23 @@ class TestTranslator(unittest.TestCase):
         variantSet.SetVariantSelection("")
         self.assertEqual(len(mc.ls(type='mesh')), 0)
 
+    def testMeshTranslator_importsSeveralMeshes(self):
+        """
+        Test that meshes imported together, whose data is read ahead of the import, match their prims
+        """
+        mc.AL_usdmaya_ProxyShapeImport(file='./testMeshVariants.usda')
+        stage = translatortestutils.getStage()
+        stage.SetEditTarget(stage.GetSessionLayer())
+        stage.GetPrimAtPath("/TestVariantSwitch").GetVariantSet("MeshVariants").SetVariantSelection("ShowMeshAnB")
+
+        mc.AL_usdmaya_TranslatePrim(ip="/TestVariantSwitch/MeshA,/TestVariantSwitch/MeshB", fi=True, proxy="AL_usdmaya_Proxy")
+        self.assertEqual(len(mc.ls(type='mesh')), 2)
+
+        for name in ('MeshA', 'MeshB'):
+            mesh = UsdGeom.Mesh(stage.GetPrimAtPath("/TestVariantSwitch/" + name))
+            self.assertEqual(mc.polyEvaluate(name, vertex=True), len(mesh.GetPointsAttr().Get()))
+            self.assertEqual(mc.polyEvaluate(name, face=True), len(mesh.GetFaceVertexCountsAttr().Get()))
+
     def testNurbsCurve_TranslatorExists(self):
         """
         Test that the NurbsCurve Translator exists
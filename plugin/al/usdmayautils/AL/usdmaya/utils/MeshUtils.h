@@ -123,6 +123,27 @@ AL_USDMAYA_UTILS_PUBLIC
 void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices);
 
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The USD data a MeshImportContext builds the Maya mesh from. This only reads from the stage, so the data of
+///         several meshes can be read ahead of time from different threads, before their Maya shapes are created.
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshImportData
+{
+  VtArray<GfVec3f> points; ///< the points of the mesh
+  VtArray<GfVec3f> normals; ///< the normals of the mesh
+  bool normalsAuthored = false; ///< true if the normals are authored
+  VtArray<int> faceVertexCounts; ///< the number of vertices in each face
+  VtArray<int> faceVertexIndices; ///< the vertex indices of each face-vertex
+  TfToken normalsInterpolation; ///< the interpolation of the normals
+  TfToken orientation; ///< the orientation of the faces
+
+  /// \brief  reads the data of the mesh at the specified time
+  /// \param  mesh the usd geometry to read
+  /// \param  timeCode the time code at which to read the data
+  AL_USDMAYA_UTILS_PUBLIC
+  void read(const UsdGeomMesh& mesh, UsdTimeCode timeCode);
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class used to import mesh data from Usd into Maya
 //----------------------------------------------------------------------------------------------------------------------
@@ -138,7 +159,19 @@ private:
   MObject polyShape; ///< the handle to the created mesh shape
   UsdTimeCode m_timeCode; ///< the time at which to import the mesh
   AL_USDMAYA_UTILS_PUBLIC
-  void gatherFaceConnectsAndVertices();
+  void gatherFaceConnectsAndVertices(const MeshImportData& data);
+  void create(const MeshImportData& data, MObject parentOrOwner, const MString& dagName)
+  {
+    gatherFaceConnectsAndVertices(data);
+    polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
+    bool leftHanded = (data.orientation == UsdGeomTokens->leftHanded);
+    fnMesh.findPlug("op", true).setBool(leftHanded);
+    // 
+    if(parentOrOwner.hasFn(MFn::kTransform))
+    {
+      fnMesh.setName(dagName);
+    }
+  }
 public:
 
   /// \brief  constructs the import context for the specified mesh
@@ -150,16 +183,23 @@ public:
   MeshImportContext(const UsdGeomMesh& mesh, MObject parentOrOwner, MString dagName, UsdTimeCode timeCode = UsdTimeCode::EarliestTime())
     : mesh(mesh), m_timeCode(timeCode)
   {
-    gatherFaceConnectsAndVertices();
-    polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
-    TfToken orientation;
-    bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, timeCode) && orientation == UsdGeomTokens->leftHanded);
-    fnMesh.findPlug("op", true).setBool(leftHanded);
-    // 
-    if(parentOrOwner.hasFn(MFn::kTransform))
-    {
-      fnMesh.setName(dagName);
-    }
+    MeshImportData data;
+    data.read(mesh, timeCode);
+    create(data, parentOrOwner, dagName);
+  }
+
+  /// \brief  constructs the import context for the specified mesh from data that has already been read
+  /// \param  mesh the usd geometry to import
+  /// \param  parentOrOwner the maya transform that will be the parent transform of the geometry being imported,
+  ///         or a mesh data objected created via MFnMeshData.
+  /// \param  dagName the name for the new mesh node
+  /// \param  timeCode the time code at which the data was read, and at which the rest of the data is read from USD
+  /// \param  data the data read from the mesh at timeCode
+  MeshImportContext(const UsdGeomMesh& mesh, MObject parentOrOwner, MString dagName, UsdTimeCode timeCode,
+                    const MeshImportData& data)
+    : mesh(mesh), m_timeCode(timeCode)
+  {
+    create(data, parentOrOwner, dagName);
   }
 
   /// \brief  reads the HoleIndices attribute from the usd geometry, and assigns those values as invisible faces on
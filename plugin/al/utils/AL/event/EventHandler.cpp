@@ -119,6 +119,7 @@ CallbackId EventDispatcher::registerCallbackInternal(
     newId = std::max(newId, it->callbackId());
   }
   m_callbacks.emplace(insertLocation, tag, functionPointer, weight, userData, ++newId);
+  invalidateDispatchTable();
   return newId;
 }
 
@@ -147,6 +148,7 @@ CallbackId EventDispatcher::registerCallback(
   }
 
   m_callbacks.emplace(insertLocation, tag, commandText, weight, isPython, ++newId);
+  invalidateDispatchTable();
   return newId;
 }
 
@@ -191,6 +193,7 @@ void EventDispatcher::registerCallback(Callback& info)
     }
   }
   m_callbacks.insert(insertLocation, std::move(info));
+  invalidateDispatchTable();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -201,6 +204,7 @@ bool EventDispatcher::unregisterCallback(CallbackId callbackId)
     if(it->callbackId() == callbackId)
     {
       m_callbacks.erase(it);
+      invalidateDispatchTable();
       return true;
     }
   }
@@ -216,12 +220,206 @@ bool EventDispatcher::unregisterCallback(CallbackId callbackId, Callback& info)
     {
       info = std::move(*it);
       m_callbacks.erase(it);
+      invalidateDispatchTable();
       return true;
     }
   }
   return false;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+namespace {
+
+// Appends the text to the script as a python string literal. Returns false if the text cannot be represented portably
+// (python 2 and 3 treat escaped non-ascii bytes differently), in which case the callback is not batched.
+bool appendPythonString(std::string& script, const char* text)
+{
+  static const char* const hexDigits = "0123456789abcdef";
+  script += '"';
+  for(const char* c = text; *c; ++c)
+  {
+    const unsigned char value = static_cast<unsigned char>(*c);
+    switch(value)
+    {
+    case '\\': script += "\\\\"; break;
+    case '"': script += "\\\""; break;
+    case '\n': script += "\\n"; break;
+    case '\r': script += "\\r"; break;
+    case '\t': script += "\\t"; break;
+    default:
+      if(value >= 0x80)
+      {
+        return false;
+      }
+      if(value < 0x20 || value == 0x7F)
+      {
+        script += "\\x";
+        script += hexDigits[value >> 4];
+        script += hexDigits[value & 0xF];
+      }
+      else
+      {
+        script += char(value);
+      }
+      break;
+    }
+  }
+  script += '"';
+  return true;
+}
+
+// Appends a python callback to a batch. Each callback is compiled and executed on its own, so that an exception raised
+// by one of them does not prevent the following ones from running (as was the case when they were executed one by one).
+// The callbacks are executed in the globals of __main__, as they would be on their own, while the batch itself runs in
+// its own namespace, so that its bookkeeping does not leak into __main__.
+bool appendPythonCallback(std::string& script, const Callback& callback)
+{
+  std::string code = "try:\n    exec(compile(";
+  if(!appendPythonString(code, callback.callbackText()))
+  {
+    return false;
+  }
+  code += ", ";
+  std::string tag;
+  if(!appendPythonString(tag, callback.tag().c_str()))
+  {
+    return false;
+  }
+  code += tag;
+  code += ", \"exec\"), _al_event_main)\n"
+          "except Exception:\n"
+          "    import traceback\n"
+          "    traceback.print_exc()\n"
+          "    _al_event_failed.append(";
+  code += tag;
+  code += ")\n";
+  script += code;
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<const DispatchTable> EventDispatcher::dispatchTable()
+{
+  if(m_dispatchTable)
+  {
+    return m_dispatchTable;
+  }
+
+  // Group consecutive callbacks of the same type into steps. The callbacks are already sorted by weight, so the order in
+  // which they are called does not change. Runs of python callbacks are merged into a single script, so that a trigger
+  // only enters the interpreter once per run rather than once per callback.
+  auto snapshot = [this](uint32_t begin, uint32_t end)
+  {
+    std::vector<DispatchStep::Entry> entries;
+    entries.reserve(end - begin);
+    for(uint32_t i = begin; i < end; ++i)
+    {
+      const Callback& callback = m_callbacks[i];
+      entries.push_back(DispatchStep::Entry{ callback.callbackId(), callback.callback(), callback.userData() });
+    }
+    return entries;
+  };
+
+  std::shared_ptr<DispatchTable> table = std::make_shared<DispatchTable>();
+  for(uint32_t i = 0, n = uint32_t(m_callbacks.size()); i < n; )
+  {
+    const uint32_t functionType = m_callbacks[i].m_functionType;
+    uint32_t end = i + 1;
+    if(functionType != kMEL)
+    {
+      while(end < n && m_callbacks[end].m_functionType == functionType)
+      {
+        ++end;
+      }
+    }
+
+    if(functionType == kPython && end - i > 1)
+    {
+      std::string batch = "_al_event_failed = []\n";
+      std::string tags;
+      uint32_t batchEnd = i;
+      for(; batchEnd < end; ++batchEnd)
+      {
+        if(!appendPythonCallback(batch, m_callbacks[batchEnd]))
+        {
+          break;
+        }
+        if(!tags.empty())
+        {
+          tags += ", ";
+        }
+        tags += m_callbacks[batchEnd].tag();
+      }
+
+      if(batchEnd - i > 1)
+      {
+        batch += "if _al_event_failed:\n"
+                 "    raise RuntimeError(\"callbacks failed: \" + \", \".join(_al_event_failed))\n";
+
+        // the batch only contains ascii characters, so it can always be quoted
+        std::string script = "exec(compile(";
+        appendPythonString(script, batch.c_str());
+        script += ", \"<AL event batch>\", \"exec\"), {\"_al_event_main\": __import__(\"__main__\").__dict__})\n";
+        table->push_back(DispatchStep{ functionType, snapshot(i, batchEnd), std::move(script), std::move(tags) });
+        i = batchEnd;
+        continue;
+      }
+
+      // a callback that could not be batched is executed on its own
+      end = std::max(batchEnd, i + 1);
+    }
+
+    table->push_back(DispatchStep{ functionType, snapshot(i, end), std::string(), std::string() });
+    i = end;
+  }
+
+  m_dispatchTable = table;
+  return m_dispatchTable;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventDispatcher::executeScripts(const DispatchStep& step)
+{
+  if(!step.script.empty())
+  {
+    if(!m_system->executePython(step.script.c_str()))
+    {
+      m_system->error("The python callbacks of event name \"%s\" and tags \"%s\" failed to execute correctly",
+          m_name.c_str(), step.tags.c_str());
+    }
+    return;
+  }
+
+  // the text of the callbacks is looked up by id, so that callbacks unregistered during the dispatch are skipped
+  for(const DispatchStep::Entry& entry : step.entries)
+  {
+    const Callback* found = findCallback(entry.callbackId);
+    if(!found || found->m_functionType != step.functionType)
+    {
+      continue;
+    }
+    const Callback& callback = *found;
+    if(callback.isPythonCallback())
+    {
+      if(!m_system->executePython(callback.callbackText()))
+      {
+        m_system->error("The python callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
+            m_name.c_str(), callback.tag().c_str());
+      }
+    }
+    else
+    {
+      if(!m_system->executeMEL(callback.callbackText()))
+      {
+        m_system->error("The MEL callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
+            m_name.c_str(), callback.tag().c_str());
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 EventId EventScheduler::registerEvent(const char* eventName, EventType eventType, const void* associatedData, CallbackId parentCallback)
 {
@@ -17,6 +17,8 @@
 
 #include "./Api.h"
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -378,6 +380,26 @@ private:
 };
 typedef std::vector<Callback> Callbacks;
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A run of consecutive callbacks (in weight order) of the same type, that are dispatched together.
+/// \ingroup events
+//----------------------------------------------------------------------------------------------------------------------
+struct DispatchStep
+{
+  /// \brief  a snapshot of a callback taken when the dispatch table was built
+  struct Entry
+  {
+    CallbackId callbackId; ///< the id of the callback, used to check it is still registered
+    const void* callback; ///< for C++ callbacks, the function pointer
+    void* userData; ///< for C++ callbacks, the user data passed to the function
+  };
+  uint32_t functionType; ///< the type of the callbacks in this step (e.g. C++, python, MEL)
+  std::vector<Entry> entries; ///< the callbacks of the step, in the order they are called
+  std::string script; ///< for a batch of python callbacks, the script that executes all of them in a single call
+  std::string tags; ///< for a batch of python callbacks, the tags of the callbacks (used to report errors)
+};
+typedef std::vector<DispatchStep> DispatchTable;
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class that manages a single event, and all the callbacks registered against that specific event
 /// \ingroup events
@@ -404,6 +426,7 @@ public:
     : m_system(system),
       m_name(name),
       m_callbacks(),
+      m_dispatchTable(),
       m_associatedData(associatedData),
       m_parentCallback(parentCallback),
       m_eventId(eventId),
@@ -416,10 +439,14 @@ public:
     : m_system(rhs.m_system),
       m_name(std::move(rhs.m_name)),
       m_callbacks(std::move(rhs.m_callbacks)),
+      m_dispatchTable(std::move(rhs.m_dispatchTable)),
       m_associatedData(rhs.m_associatedData),
       m_parentCallback(rhs.m_parentCallback),
       m_eventId(rhs.m_eventId),
-      m_eventType(rhs.m_eventType)
+      m_eventType(rhs.m_eventType),
+      m_triggerCount(rhs.m_triggerCount),
+      m_dispatchTime(rhs.m_dispatchTime),
+      m_maxDispatchTime(rhs.m_maxDispatchTime)
     {}
 
   /// \brief  move assignment
@@ -430,10 +457,14 @@ public:
       m_system = rhs.m_system;
       m_name = std::move(rhs.m_name);
       m_callbacks = std::move(rhs.m_callbacks);
+      m_dispatchTable = std::move(rhs.m_dispatchTable);
       m_associatedData = rhs.m_associatedData;
       m_parentCallback = rhs.m_parentCallback;
       m_eventId = rhs.m_eventId;
       m_eventType = rhs.m_eventType;
+      m_triggerCount = rhs.m_triggerCount;
+      m_dispatchTime = rhs.m_dispatchTime;
+      m_maxDispatchTime = rhs.m_maxDispatchTime;
       return *this;
     }
 
@@ -577,30 +608,30 @@ public:
   template<typename FunctionBinder>
   void triggerEvent(FunctionBinder binder)
   {
-    for(auto& callback : m_callbacks)
+    const auto start = std::chrono::steady_clock::now();
+
+    // hold on to the table, in case a callback modifies the callbacks of this event while it is being dispatched. If
+    // that happens, the table is replaced, and the remaining callbacks are only called if they are still registered.
+    const std::shared_ptr<const DispatchTable> table = dispatchTable();
+    for(const DispatchStep& step : *table)
     {
-      if(callback.isCCallback())
-      {
-        binder(callback.userData(), callback.callback());
-      }
-      else
-      if(callback.isPythonCallback())
+      if(step.functionType == kCFunction)
       {
-        if(!m_system->executePython(callback.callbackText()))
+        for(const DispatchStep::Entry& entry : step.entries)
         {
-          m_system->error("The python callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
+          if(m_dispatchTable == table || isStillRegistered(entry))
+          {
+            binder(entry.userData, entry.callback);
+          }
         }
       }
       else
       {
-        if(!m_system->executeMEL(callback.callbackText()))
-        {
-          m_system->error("The MEL callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
+        executeScripts(step);
       }
     }
+
+    recordDispatchTime(std::chrono::steady_clock::now() - start);
   }
 
   /// \brief  a default version of dispatchEvent that assumes a function callback type of
@@ -609,31 +640,32 @@ public:
   /// \endcode
   void triggerEvent()
   {
-    for(auto& callback : m_callbacks)
-    {
-      if(callback.isCCallback())
-      {
-        defaultEventFunction basic = (defaultEventFunction)callback.callback();
-        basic(callback.userData());
-      }
-      else
-      if(callback.isPythonCallback())
-      {
-        if(!m_system->executePython(callback.callbackText()))
-        {
-          m_system->error("The python callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
-      }
-      else
-      {
-        if(!m_system->executeMEL(callback.callbackText()))
-        {
-          m_system->error("The MEL callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
-      }
-    }
+    triggerEvent([](void* userData, const void* callback) {
+      ((defaultEventFunction)callback)(userData);
+    });
+  }
+
+  /// \brief  returns the number of times this event has been triggered (since the statistics were last reset)
+  /// \return the trigger count
+  uint64_t triggerCount() const
+    { return m_triggerCount; }
+
+  /// \brief  returns the total time spent dispatching this event to its callbacks
+  /// \return the total dispatch time in seconds
+  double totalDispatchTime() const
+    { return std::chrono::duration<double>(m_dispatchTime).count(); }
+
+  /// \brief  returns the longest time spent dispatching this event to its callbacks
+  /// \return the maximum dispatch time in seconds
+  double maxDispatchTime() const
+    { return std::chrono::duration<double>(m_maxDispatchTime).count(); }
+
+  /// \brief  resets the trigger count and dispatch times of this event
+  void resetStatistics()
+  {
+    m_triggerCount = 0;
+    m_dispatchTime = std::chrono::steady_clock::duration::zero();
+    m_maxDispatchTime = std::chrono::steady_clock::duration::zero();
   }
 
   /// \brief  used to sort the events based on their ID
@@ -683,14 +715,48 @@ private:
     const void* functionPointer,
     uint32_t weight,
     void* userData);
+
+  /// returns the dispatch table for the current callbacks, building it if the callbacks have changed
+  AL_EVENT_PUBLIC
+  std::shared_ptr<const DispatchTable> dispatchTable();
+
+  /// executes the python or MEL callbacks of a dispatch step
+  AL_EVENT_PUBLIC
+  void executeScripts(const DispatchStep& step);
+
+  /// returns true if the C++ callback in the snapshot is still registered against this event. Ids can be handed out
+  /// again once a callback has been unregistered, so the function and user data have to match as well.
+  bool isStillRegistered(const DispatchStep::Entry& entry)
+  {
+    const Callback* callback = findCallback(entry.callbackId);
+    return callback && callback->isCCallback() &&
+           callback->callback() == entry.callback && callback->userData() == entry.userData;
+  }
+
+  void recordDispatchTime(std::chrono::steady_clock::duration time)
+  {
+    ++m_triggerCount;
+    m_dispatchTime += time;
+    if(time > m_maxDispatchTime)
+    {
+      m_maxDispatchTime = time;
+    }
+  }
+
+  void invalidateDispatchTable()
+    { m_dispatchTable.reset(); }
 private:
   EventSystemBinding* m_system;
   std::string m_name;
   Callbacks m_callbacks;
+  std::shared_ptr<const DispatchTable> m_dispatchTable;
   const void* m_associatedData;
   CallbackId m_parentCallback;
   EventId m_eventId;
   EventType m_eventType;
+  uint64_t m_triggerCount = 0;
+  std::chrono::steady_clock::duration m_dispatchTime = std::chrono::steady_clock::duration::zero();
+  std::chrono::steady_clock::duration m_maxDispatchTime = std::chrono::steady_clock::duration::zero();
 };
 typedef std::vector<EventDispatcher> EventDispatchers;
 
@@ -26,6 +26,12 @@ TF_REGISTRY_FUNCTION(TfDebug)
             "UsdMaya registration for usd types.");
     TF_DEBUG_ENVIRONMENT_SYMBOL(PXRUSDMAYA_DIAGNOSTICS,
             "Debugging of the the diagnostics batching system in UsdMaya.");
+    TF_DEBUG_ENVIRONMENT_SYMBOL(PXRUSDMAYA_POINT_BASED_DEFORMER,
+            "Throughput of the point based deformer node.");
+    TF_DEBUG_ENVIRONMENT_SYMBOL(PXRUSDMAYA_READ_JOB,
+            "Timings of the usdImport read job and of its prefetching.");
+    TF_DEBUG_ENVIRONMENT_SYMBOL(PXRUSDMAYA_STAGE_LOAD_QUEUE,
+            "Stages opened ahead of DG evaluation when reading a scene.");
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
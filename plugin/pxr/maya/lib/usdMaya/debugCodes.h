@@ -24,7 +24,10 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 TF_DEBUG_CODES(
     PXRUSDMAYA_REGISTRY,
-    PXRUSDMAYA_DIAGNOSTICS
+    PXRUSDMAYA_DIAGNOSTICS,
+    PXRUSDMAYA_POINT_BASED_DEFORMER,
+    PXRUSDMAYA_READ_JOB,
+    PXRUSDMAYA_STAGE_LOAD_QUEUE
 );
 
 
@@ -82,6 +82,12 @@ MSyntax UsdMayaExportCommand::createSyntax()
     syntax.addFlag("-nnu",
                    UsdMayaJobExportArgsTokens->normalizeNurbs.GetText() ,
                    MSyntax::kBoolean);
+    syntax.addFlag("-pw",
+                   UsdMayaJobExportArgsTokens->parallelWrite.GetText(),
+                   MSyntax::kBoolean);
+    syntax.addFlag("-prp",
+                   UsdMayaJobExportArgsTokens->profileReport.GetText(),
+                   MSyntax::kBoolean);
     syntax.addFlag("-cls",
                    UsdMayaJobExportArgsTokens->exportColorSets.GetText(),
                    MSyntax::kBoolean);
@@ -121,6 +127,9 @@ MSyntax UsdMayaExportCommand::createSyntax()
     syntax.addFlag("-k",
                    UsdMayaJobExportArgsTokens->kind.GetText(),
                    MSyntax::kString);
+    syntax.addFlag("-ccs",
+                   UsdMayaJobExportArgsTokens->clipChunkSize.GetText(),
+                   MSyntax::kLong);
     syntax.addFlag("-com",
                    UsdMayaJobExportArgsTokens->compatibility.GetText(),
                    MSyntax::kString);
@@ -75,9 +75,15 @@ UsdMayaImportCommand::createSyntax()
                    MSyntax::kString);
     syntax.makeFlagMultiUse(
             UsdMayaJobImportArgsTokens->excludePrimvar.GetText());
+    syntax.addFlag("-prd",
+                   UsdMayaJobImportArgsTokens->parallelRead.GetText(),
+                   MSyntax::kBoolean);
     syntax.addFlag("-uac",
                    UsdMayaJobImportArgsTokens->useAsAnimationCache.GetText(),
                    MSyntax::kBoolean);
+    syntax.addFlag("-act",
+                   UsdMayaJobImportArgsTokens->animationCacheThreshold.GetText(),
+                   MSyntax::kLong);
 
     // These are additional flags under our control.
     syntax.addFlag("-f" , "-file", MSyntax::kString);
@@ -77,6 +77,18 @@ _Boolean(const VtDictionary& userArgs, const TfToken& key)
     return VtDictionaryGet<bool>(userArgs, key);
 }
 
+/// Extracts an int at \p key from \p userArgs, or 0 if it can't extract.
+static int
+_Int(const VtDictionary& userArgs, const TfToken& key)
+{
+    if (!VtDictionaryIsHolding<int>(userArgs, key)) {
+        TF_CODING_ERROR("Dictionary is missing required key '%s' or key is "
+                "not int type", key.GetText());
+        return 0;
+    }
+    return VtDictionaryGet<int>(userArgs, key);
+}
+
 /// Extracts a string at \p key from \p userArgs, or "" if it can't extract.
 static std::string
 _String(const VtDictionary& userArgs, const TfToken& key)
@@ -236,6 +248,8 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
     const VtDictionary& userArgs,
     const UsdMayaUtil::MDagPathSet& dagPaths,
     const std::vector<double>& timeSamples) :
+        clipChunkSize(
+            _Int(userArgs, UsdMayaJobExportArgsTokens->clipChunkSize)),
         compatibility(
             _Token(userArgs,
                 UsdMayaJobExportArgsTokens->compatibility,
@@ -310,6 +324,10 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
                 UsdMayaJobExportArgsTokens->mergeTransformAndShape)),
         normalizeNurbs(
             _Boolean(userArgs, UsdMayaJobExportArgsTokens->normalizeNurbs)),
+        parallelWrite(
+            _Boolean(userArgs, UsdMayaJobExportArgsTokens->parallelWrite)),
+        profileReport(
+            _Boolean(userArgs, UsdMayaJobExportArgsTokens->profileReport)),
         stripNamespaces(
             _Boolean(userArgs,
                 UsdMayaJobExportArgsTokens->stripNamespaces)),
@@ -356,7 +374,8 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
 std::ostream&
 operator <<(std::ostream& out, const UsdMayaJobExportArgs& exportArgs)
 {
-    out << "compatibility: " << exportArgs.compatibility << std::endl
+    out << "clipChunkSize: " << exportArgs.clipChunkSize << std::endl
+        << "compatibility: " << exportArgs.compatibility << std::endl
         << "defaultMeshScheme: " << exportArgs.defaultMeshScheme << std::endl
         << "eulerFilter: " << TfStringify(exportArgs.eulerFilter) << std::endl
         << "excludeInvisible: " << TfStringify(exportArgs.excludeInvisible) << std::endl
@@ -376,7 +395,9 @@ operator <<(std::ostream& out, const UsdMayaJobExportArgs& exportArgs)
         << "materialsScopeName: " << exportArgs.materialsScopeName << std::endl
         << "mergeTransformAndShape: " << TfStringify(exportArgs.mergeTransformAndShape) << std::endl
         << "normalizeNurbs: " << TfStringify(exportArgs.normalizeNurbs) << std::endl
+        << "parallelWrite: " << TfStringify(exportArgs.parallelWrite) << std::endl
         << "parentScope: " << exportArgs.parentScope << std::endl
+        << "profileReport: " << TfStringify(exportArgs.profileReport) << std::endl
         << "renderLayerMode: " << exportArgs.renderLayerMode << std::endl
         << "rootKind: " << exportArgs.rootKind << std::endl
         << "shadingMode: " << exportArgs.shadingMode << std::endl
@@ -441,6 +462,7 @@ UsdMayaJobExportArgs::GetDefaultDictionary()
         // Base defaults.
         d[UsdMayaJobExportArgsTokens->chaser] = std::vector<VtValue>();
         d[UsdMayaJobExportArgsTokens->chaserArgs] = std::vector<VtValue>();
+        d[UsdMayaJobExportArgsTokens->clipChunkSize] = 0;
         d[UsdMayaJobExportArgsTokens->compatibility] =
                 UsdMayaJobExportArgsTokens->none.GetString();
         d[UsdMayaJobExportArgsTokens->defaultCameras] = false;
@@ -468,7 +490,9 @@ UsdMayaJobExportArgs::GetDefaultDictionary()
         d[UsdMayaJobExportArgsTokens->melPostCallback] = std::string();
         d[UsdMayaJobExportArgsTokens->mergeTransformAndShape] = true;
         d[UsdMayaJobExportArgsTokens->normalizeNurbs] = false;
+        d[UsdMayaJobExportArgsTokens->parallelWrite] = false;
         d[UsdMayaJobExportArgsTokens->parentScope] = std::string();
+        d[UsdMayaJobExportArgsTokens->profileReport] = false;
         d[UsdMayaJobExportArgsTokens->pythonPerFrameCallback] = std::string();
         d[UsdMayaJobExportArgsTokens->pythonPostCallback] = std::string();
         d[UsdMayaJobExportArgsTokens->renderableOnly] = false;
@@ -531,6 +555,9 @@ UsdMayaJobImportArgs::UsdMayaJobImportArgs(
     const VtDictionary& userArgs,
     const bool importWithProxyShapes,
     const GfInterval& timeInterval) :
+        animationCacheThreshold(
+            _Int(userArgs,
+                UsdMayaJobImportArgsTokens->animationCacheThreshold)),
         assemblyRep(
             _Token(userArgs,
                 UsdMayaJobImportArgsTokens->assemblyRep,
@@ -546,6 +573,8 @@ UsdMayaJobImportArgs::UsdMayaJobImportArgs(
             _TokenSet(userArgs, UsdMayaJobImportArgsTokens->apiSchema)),
         includeMetadataKeys(
             _TokenSet(userArgs, UsdMayaJobImportArgsTokens->metadata)),
+        parallelRead(
+            _Boolean(userArgs, UsdMayaJobImportArgsTokens->parallelRead)),
         shadingMode(
             _Token(userArgs,
                 UsdMayaJobImportArgsTokens->shadingMode,
@@ -579,6 +608,7 @@ const VtDictionary& UsdMayaJobImportArgs::GetDefaultDictionary()
     static std::once_flag once;
     std::call_once(once, []() {
         // Base defaults.
+        d[UsdMayaJobImportArgsTokens->animationCacheThreshold] = 0;
         d[UsdMayaJobImportArgsTokens->assemblyRep] =
                 UsdMayaJobImportArgsTokens->Collapsed.GetString();
         d[UsdMayaJobImportArgsTokens->apiSchema] = std::vector<VtValue>();
@@ -589,6 +619,7 @@ const VtDictionary& UsdMayaJobImportArgs::GetDefaultDictionary()
                     VtValue(SdfFieldKeys->Instanceable.GetString()),
                     VtValue(SdfFieldKeys->Kind.GetString())
                 });
+        d[UsdMayaJobImportArgsTokens->parallelRead] = false;
         d[UsdMayaJobImportArgsTokens->shadingMode] =
                 UsdMayaShadingModeTokens->displayColor.GetString();
         d[UsdMayaJobImportArgsTokens->useAsAnimationCache] = false;
@@ -611,7 +642,9 @@ operator <<(std::ostream& out, const UsdMayaJobImportArgs& importArgs)
     out << "shadingMode: " << importArgs.shadingMode << std::endl
         << "assemblyRep: " << importArgs.assemblyRep << std::endl
         << "timeInterval: " << importArgs.timeInterval << std::endl
+        << "parallelRead: " << TfStringify(importArgs.parallelRead) << std::endl
         << "useAsAnimationCache: " << TfStringify(importArgs.useAsAnimationCache) << std::endl
+        << "animationCacheThreshold: " << importArgs.animationCacheThreshold << std::endl
         << "importWithProxyShapes: " << TfStringify(importArgs.importWithProxyShapes) << std::endl;
 
     return out;
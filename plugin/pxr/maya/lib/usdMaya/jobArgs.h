@@ -57,6 +57,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     /* Dictionary keys */ \
     (chaser) \
     (chaserArgs) \
+    (clipChunkSize) \
     (compatibility) \
     (defaultCameras) \
     (defaultMeshScheme) \
@@ -79,7 +80,9 @@ TF_DECLARE_PUBLIC_TOKENS(
     (melPostCallback) \
     (mergeTransformAndShape) \
     (normalizeNurbs) \
+    (parallelWrite) \
     (parentScope) \
+    (profileReport) \
     (pythonPerFrameCallback) \
     (pythonPostCallback) \
     (renderableOnly) \
@@ -106,10 +109,12 @@ TF_DECLARE_PUBLIC_TOKENS(
 
 #define PXRUSDMAYA_JOB_IMPORT_ARGS_TOKENS \
     /* Dictionary keys */ \
+    (animationCacheThreshold) \
     (apiSchema) \
     (assemblyRep) \
     (excludePrimvar) \
     (metadata) \
+    (parallelRead) \
     (shadingMode) \
     (useAsAnimationCache) \
     /* assemblyRep values */ \
@@ -126,6 +131,11 @@ TF_DECLARE_PUBLIC_TOKENS(
 
 struct UsdMayaJobExportArgs
 {
+    /// If greater than zero, time-sampled data is streamed out of the stage
+    /// into a separate value clip file every \p clipChunkSize frames, and the
+    /// exported layer stitches the clips back together. This bounds the
+    /// memory used by long animated exports to the size of one chunk.
+    const int clipChunkSize;
     const TfToken compatibility;
     const TfToken defaultMeshScheme;
     const bool eulerFilter;
@@ -163,6 +173,16 @@ struct UsdMayaJobExportArgs
     /// a single node in the output USD.
     const bool mergeTransformAndShape;
     const bool normalizeNurbs;
+
+    /// Whether time-sampled values written by prim writers are staged per
+    /// frame, then filtered in parallel and merged into the layer in a single
+    /// change block, rather than being authored one prim writer at a time.
+    const bool parallelWrite;
+
+    /// Whether per-phase, per-prim-writer-type and per-frame timings are
+    /// collected during the export and written out as a JSON report next to
+    /// the exported file.
+    const bool profileReport;
     const bool stripNamespaces;
 
     /// This is the path of the USD prim under which *all* prims will be
@@ -247,10 +267,25 @@ std::ostream& operator <<(
 
 struct UsdMayaJobImportArgs
 {
+    /// If greater than zero, animated meshes with more point samples (time
+    /// samples times points) than this are imported as if
+    /// useAsAnimationCache were set: their points are streamed from the stage
+    /// by a point based deformer rather than baked into blend shape targets,
+    /// so the memory used by the Maya scene doesn't grow with the frame
+    /// count.
+    const int animationCacheThreshold;
+
     const TfToken assemblyRep;
     const TfToken::Set excludePrimvarNames;
     const TfToken::Set includeAPINames;
     const TfToken::Set includeMetadataKeys;
+
+    /// Whether the topology, points and normals of upcoming meshes are read
+    /// and converted into Maya arrays on worker threads, ahead of the serial
+    /// creation of their Maya nodes. Primvars and transforms are still read
+    /// serially.
+    const bool parallelRead;
+
     TfToken shadingMode; // XXX can we make this const?
     const bool useAsAnimationCache;
 
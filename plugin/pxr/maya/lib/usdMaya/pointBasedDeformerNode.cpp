@@ -15,23 +15,29 @@
 //
 #include "usdMaya/pointBasedDeformerNode.h"
 
+#include "usdMaya/debugCodes.h"
 #include "usdMaya/stageData.h"
 
-#include "pxr/base/gf/math.h"
 #include "pxr/base/gf/vec3f.h"
+#include "pxr/base/tf/debug.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/tf/stopwatch.h"
 #include "pxr/base/tf/stringUtils.h"
 #include "pxr/base/tf/token.h"
 #include "pxr/base/vt/array.h"
 #include "pxr/base/vt/types.h"
+#include "pxr/base/work/loops.h"
 
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/pointBased.h"
 
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MFnData.h>
@@ -44,6 +50,7 @@
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPoint.h>
+#include <maya/MPointArray.h>
 #include <maya/MPxDeformerNode.h>
 #include <maya/MStatus.h>
 #include <maya/MString.h>
@@ -64,6 +71,9 @@ const MTypeId UsdMayaPointBasedDeformerNode::typeId(0x00126401);
 const MString UsdMayaPointBasedDeformerNode::typeName(
     UsdMayaPointBasedDeformerNodeTokens->MayaTypeName.GetText());
 
+// Geometry with fewer points than this is deformed on the calling thread.
+static const size_t _PARALLEL_DEFORM_MIN_POINTS = 16384u;
+
 // Attributes
 MObject UsdMayaPointBasedDeformerNode::inUsdStageAttr;
 MObject UsdMayaPointBasedDeformerNode::primPathAttr;
@@ -134,6 +144,103 @@ UsdMayaPointBasedDeformerNode::initialize()
     return status;
 }
 
+/// Moves each of \p positions towards the matching point of \p targets by its
+/// weight times \p envelope, in place. The loop is kept free of branches so
+/// that it stays cheap per point.
+static
+void
+_LerpPositions(
+        size_t begin,
+        size_t end,
+        const GfVec3f* targets,
+        const float* weights,
+        const float envelope,
+        MPointArray* positions)
+{
+    MPointArray& points = *positions;
+    for (size_t i = begin; i < end; ++i) {
+        const double t = weights[i] * envelope;
+        MPoint& position = points[static_cast<unsigned int>(i)];
+        position.x += t * (targets[i][0] - position.x);
+        position.y += t * (targets[i][1] - position.y);
+        position.z += t * (targets[i][2] - position.z);
+    }
+}
+
+bool
+UsdMayaPointBasedDeformerNode::_UpdatePointsQuery(
+        const UsdStageRefPtr& stage,
+        const MString& primPathString)
+{
+    // A stage that has been destroyed may have its address reused by the new
+    // one, so an expired stage always counts as a change.
+    const bool stageChanged =
+        _stage.IsExpired() || get_pointer(_stage) != get_pointer(stage);
+    if (_pointsQuery.IsValid() &&
+            !stageChanged &&
+            _primPathString == primPathString) {
+        return true;
+    }
+
+    _pointsQuery = UsdAttributeQuery();
+    _primPathString = primPathString;
+    if (stageChanged) {
+        _stage = stage;
+        _stageNoticeListener.SetStage(_stage);
+    }
+
+    const std::string trimmedPrimPathString =
+        TfStringTrim(primPathString.asChar());
+    if (trimmedPrimPathString.empty()) {
+        return false;
+    }
+
+    const UsdGeomPointBased usdPointBased(
+        stage->GetPrimAtPath(SdfPath(trimmedPrimPathString)));
+    if (!usdPointBased) {
+        return false;
+    }
+
+    _pointsQuery = UsdAttributeQuery(usdPointBased.GetPointsAttr());
+    return _pointsQuery.IsValid();
+}
+
+MStatus
+UsdMayaPointBasedDeformerNode::_ReadWeights(
+        MDataBlock& block,
+        unsigned int multiIndex,
+        size_t numPoints)
+{
+    // Points without an authored weight have a weight of one.
+    _weights.assign(numPoints, 1.0f);
+
+    MStatus status;
+    MArrayDataHandle weightListHandle =
+        block.inputArrayValue(weightList, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    if (weightListHandle.jumpToElement(multiIndex) != MS::kSuccess) {
+        return MS::kSuccess;
+    }
+
+    MDataHandle weightsParentHandle = weightListHandle.inputValue(&status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MArrayDataHandle weightsHandle(weightsParentHandle.child(weights),
+                                   &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const unsigned int numWeights = weightsHandle.elementCount();
+    for (unsigned int i = 0u; i < numWeights; ++i, weightsHandle.next()) {
+        const unsigned int index = weightsHandle.elementIndex();
+        if (index < numPoints) {
+            _weights[index] = weightsHandle.inputValue().asFloat();
+        }
+    }
+
+    return MS::kSuccess;
+}
+
 /* virtual */
 MStatus
 UsdMayaPointBasedDeformerNode::deform(
@@ -155,24 +262,11 @@ UsdMayaPointBasedDeformerNode::deform(
         return MS::kFailure;
     }
 
-    const UsdStageRefPtr& usdStage = stageData->stage;
-
     // Get the prim path.
     const MDataHandle primPathHandle = block.inputValue(primPathAttr, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    const std::string primPathString =
-        TfStringTrim(primPathHandle.asString().asChar());
-
-    if (primPathString.empty()) {
-        return MS::kFailure;
-    }
-
-    const SdfPath primPath(primPathString);
-
-    const UsdPrim& usdPrim = usdStage->GetPrimAtPath(primPath);
-    const UsdGeomPointBased usdPointBased(usdPrim);
-    if (!usdPointBased) {
+    if (!_UpdatePointsQuery(stageData->stage, primPathHandle.asString())) {
         return MS::kFailure;
     }
 
@@ -184,30 +278,77 @@ UsdMayaPointBasedDeformerNode::deform(
     CHECK_MSTATUS_AND_RETURN_IT(status);
     const float envelope = envelopeHandle.asFloat();
 
-    VtVec3fArray usdPoints;
-    if (!usdPointBased.GetPointsAttr().Get(&usdPoints, usdTime) ||
-            usdPoints.empty()) {
+    TfStopwatch deformStopwatch;
+    deformStopwatch.Start();
+
+    if (!_pointsQuery.Get(&_usdPoints, usdTime) || _usdPoints.empty()) {
         return MS::kFailure;
     }
 
-    for ( ; !iter.isDone(); iter.next()) {
-        const int index = iter.index();
-        if (index < 0 || static_cast<size_t>(index) >= usdPoints.size()) {
-            continue;
-        }
+    status = _ReadWeights(block, multiIndex, _usdPoints.size());
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-        const MPoint mayaPoint = iter.position();
-        const float weight = weightValue(block, multiIndex, index);
+    status = iter.allPositions(_mayaPoints);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-        const GfVec3f& usdPoint = usdPoints[static_cast<size_t>(index)];
+    const size_t numPositions = _mayaPoints.length();
+    if (numPositions == 0u) {
+        return status;
+    }
 
-        const GfVec3f deformedPoint =
-            GfLerp<GfVec3f>(weight * envelope,
-                            GfVec3f(mayaPoint[0], mayaPoint[1], mayaPoint[2]),
-                            usdPoint);
+    // When all of the points of the geometry are deformed, which is the
+    // usual case since the geometry is imported from the prim, the positions
+    // are in point order and the USD points and weights can be used as they
+    // are. Otherwise, the point and weight of each position are gathered by
+    // its index first, with out of range indices left where they are.
+    const GfVec3f* targets = _usdPoints.cdata();
+    const float* targetWeights = _weights.data();
+    if (numPositions != _usdPoints.size()) {
+        _gatheredPoints.resize(numPositions);
+        _gatheredWeights.resize(numPositions);
+        size_t i = 0u;
+        for (iter.reset(); !iter.isDone() && i < numPositions; iter.next(), ++i) {
+            const int index = iter.index();
+            if (index < 0 || static_cast<size_t>(index) >= _usdPoints.size()) {
+                _gatheredPoints[i] = GfVec3f(0.0f);
+                _gatheredWeights[i] = 0.0f;
+            } else {
+                _gatheredPoints[i] = targets[index];
+                _gatheredWeights[i] = targetWeights[index];
+            }
+        }
+        targets = _gatheredPoints.data();
+        targetWeights = _gatheredWeights.data();
+    }
+
+    MPointArray* positions = &_mayaPoints;
+    if (numPositions < _PARALLEL_DEFORM_MIN_POINTS) {
+        _LerpPositions(0u, numPositions, targets, targetWeights, envelope,
+                       positions);
+    } else {
+        WorkParallelForN(
+            numPositions,
+            [targets, targetWeights, envelope, positions](
+                    size_t begin, size_t end) {
+                _LerpPositions(begin, end, targets, targetWeights, envelope,
+                               positions);
+            });
+    }
+
+    status = iter.setAllPositions(_mayaPoints);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-        iter.setPosition(
-            MPoint(deformedPoint[0], deformedPoint[1], deformedPoint[2]));
+    if (TfDebug::IsEnabled(PXRUSDMAYA_POINT_BASED_DEFORMER)) {
+        deformStopwatch.Stop();
+        const double seconds = deformStopwatch.GetSeconds();
+        TF_DEBUG(PXRUSDMAYA_POINT_BASED_DEFORMER).Msg(
+            "UsdMayaPointBasedDeformerNode: deformed %zu points of <%s> at "
+            "time %f in %.6f seconds (%.0f points per second)\n",
+            numPositions,
+            _pointsQuery.GetAttribute().GetPrimPath().GetText(),
+            usdTime.GetValue(),
+            seconds,
+            seconds > 0.0 ? numPositions / seconds : 0.0);
     }
 
     return status;
@@ -216,6 +357,12 @@ UsdMayaPointBasedDeformerNode::deform(
 UsdMayaPointBasedDeformerNode::UsdMayaPointBasedDeformerNode() :
     MPxDeformerNode()
 {
+    // Any change to the contents of the stage may affect the resolved points,
+    // so the query gets rebuilt on the next evaluation.
+    _stageNoticeListener.SetStageContentsChangedCallback(
+        [this](const UsdNotice::StageContentsChanged&) {
+            _pointsQuery = UsdAttributeQuery();
+        });
 }
 
 /* virtual */
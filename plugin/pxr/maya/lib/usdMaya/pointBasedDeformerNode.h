@@ -19,20 +19,28 @@
 /// \file usdMaya/pointBasedDeformerNode.h
 
 #include "usdMaya/api.h"
+#include "usdMaya/stageNoticeListener.h"
 
 #include "pxr/pxr.h"
 
+#include "pxr/base/gf/vec3f.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/vt/types.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/stage.h"
 
 #include <maya/MDataBlock.h>
 #include <maya/MItGeometry.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
+#include <maya/MPointArray.h>
 #include <maya/MPxDeformerNode.h>
 #include <maya/MStatus.h>
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
+#include <vector>
+
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -55,6 +63,11 @@ TF_DECLARE_PUBLIC_TOKENS(UsdMayaPointBasedDeformerNodeTokens,
 /// the deformer runs, it will read the points attribute of the prim at that
 /// time sample and use the positions to modify the positions of the geometry
 /// being deformed.
+///
+/// The points are read through an attribute query that is kept until the
+/// stage, the prim path or the contents of the stage change, and the geometry
+/// is deformed in a single pass over all of its points, split across threads
+/// for dense geometry.
 class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
 {
     public:
@@ -92,6 +105,34 @@ class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
         UsdMayaPointBasedDeformerNode(const UsdMayaPointBasedDeformerNode&);
         UsdMayaPointBasedDeformerNode& operator=(
                 const UsdMayaPointBasedDeformerNode&);
+
+        /// Rebuilds the points attribute query if the stage or the prim path
+        /// changed since it was built, or if it was invalidated. Returns
+        /// false if the prim path does not point to a UsdGeomPointBased.
+        bool _UpdatePointsQuery(
+                const UsdStageRefPtr& stage,
+                const MString& primPathString);
+
+        /// Reads the weights of the geometry at \p multiIndex into _weights,
+        /// indexed by point.
+        MStatus _ReadWeights(
+                MDataBlock& block,
+                unsigned int multiIndex,
+                size_t numPoints);
+
+        UsdMayaStageNoticeListener _stageNoticeListener;
+
+        UsdStageWeakPtr _stage;
+        MString _primPathString;
+        UsdAttributeQuery _pointsQuery;
+
+        // Buffers that are kept between evaluations so that they don't need
+        // to be reallocated.
+        VtVec3fArray _usdPoints;
+        MPointArray _mayaPoints;
+        std::vector<float> _weights;
+        std::vector<GfVec3f> _gatheredPoints;
+        std::vector<float> _gatheredWeights;
 };
 
 
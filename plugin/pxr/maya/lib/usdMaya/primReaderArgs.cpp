@@ -20,10 +20,12 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 UsdMayaPrimReaderArgs::UsdMayaPrimReaderArgs(
         const UsdPrim& prim,
-        const UsdMayaJobImportArgs& jobArgs)
+        const UsdMayaJobImportArgs& jobArgs,
+        UsdMaya_ReadPrefetchCache* prefetchCache)
     : 
         _prim(prim),
-        _jobArgs(jobArgs)
+        _jobArgs(jobArgs),
+        _prefetchCache(prefetchCache)
 {
 }
 const UsdPrim&
@@ -67,5 +69,19 @@ UsdMayaPrimReaderArgs::GetUseAsAnimationCache() const
     return _jobArgs.useAsAnimationCache;
 }
 
+bool
+UsdMayaPrimReaderArgs::ShouldStreamPoints(
+        size_t numPoints,
+        size_t numTimeSamples) const
+{
+    if (_jobArgs.useAsAnimationCache) {
+        return true;
+    }
+
+    return _jobArgs.animationCacheThreshold > 0 &&
+        numPoints * numTimeSamples >
+            static_cast<size_t>(_jobArgs.animationCacheThreshold);
+}
+
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -30,6 +30,8 @@
 PXR_NAMESPACE_OPEN_SCOPE
 
 
+class UsdMaya_ReadPrefetchCache;
+
 /// \class UsdMayaPrimReaderArgs
 /// \brief This class holds read-only arguments that are passed into reader plugins for
 /// the usdMaya library.
@@ -41,7 +43,8 @@ public:
     PXRUSDMAYA_API
     UsdMayaPrimReaderArgs(
             const UsdPrim& prim,
-            const UsdMayaJobImportArgs& jobArgs);
+            const UsdMayaJobImportArgs& jobArgs,
+            UsdMaya_ReadPrefetchCache* prefetchCache = nullptr);
 
     /// \brief return the usd prim that should be read.
     PXRUSDMAYA_API
@@ -67,6 +70,19 @@ public:
     PXRUSDMAYA_API
     bool GetUseAsAnimationCache() const;
 
+    /// Returns whether an animated point based prim with \p numPoints points
+    /// and \p numTimeSamples time samples should stream its points from the
+    /// stage rather than bake them, either because useAsAnimationCache is set
+    /// or because it is above the animationCacheThreshold.
+    PXRUSDMAYA_API
+    bool ShouldStreamPoints(size_t numPoints, size_t numTimeSamples) const;
+
+    /// Returns the cache of the USD data read ahead of the prim readers when
+    /// the parallelRead import arg is set, or null.
+    UsdMaya_ReadPrefetchCache* GetPrefetchCache() const {
+        return _prefetchCache;
+    }
+
     bool ShouldImportUnboundShaders() const {
         // currently this is disabled.
         return false;
@@ -75,6 +91,7 @@ public:
 private:
     const UsdPrim& _prim;
     const UsdMayaJobImportArgs& _jobArgs;
+    UsdMaya_ReadPrefetchCache* _prefetchCache;
 };
 
 
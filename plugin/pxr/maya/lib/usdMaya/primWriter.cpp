@@ -34,7 +34,6 @@
 #include "pxr/usd/usdGeom/gprim.h"
 #include "pxr/usd/usdGeom/imageable.h"
 #include "pxr/usd/usdGeom/tokens.h"
-#include "pxr/usd/usdUtils/sparseValueWriter.h"
 
 #include <maya/MDagPath.h>
 #include <maya/MFnDagNode.h>
@@ -124,6 +123,7 @@ UsdMayaPrimWriter::UsdMayaPrimWriter(
     _mayaObject(depNodeFn.object()),
     _usdPath(usdPath),
     _baseDagToUsdPaths(_GetDagPathMap(depNodeFn, usdPath)),
+    _valueWriter(jobCtx),
     _exportVisibility(jobCtx.GetArgs().exportVisibility),
     _hasAnimCurves(_IsAnimated(jobCtx.GetArgs(), depNodeFn.object()))
 {
@@ -253,7 +253,7 @@ UsdMayaPrimWriter::Write(const UsdTimeCode& usdTime)
                 _usdPrim,
                 {UsdGeomTokens->purpose},
                 usdTime,
-                &_valueWriter);
+                _GetStagedValueWriter());
         }
 
         // Write API schema attributes and strongly-typed metadata.
@@ -262,7 +262,7 @@ UsdMayaPrimWriter::Write(const UsdTimeCode& usdTime)
         UsdMayaWriteUtil::WriteAPISchemaAttributesToPrim(
             GetMayaObject(),
             _usdPrim,
-            _GetSparseValueWriter());
+            _GetStagedValueWriter());
     }
 
     // Write out user-tagged attributes, which are supported at default time
@@ -271,7 +271,7 @@ UsdMayaPrimWriter::Write(const UsdTimeCode& usdTime)
         GetMayaObject(),
         _usdPrim,
         usdTime,
-        _GetSparseValueWriter());
+        _GetStagedValueWriter());
 }
 
 /* virtual */
@@ -359,6 +359,12 @@ UsdMayaPrimWriter::_GetExportArgs() const
 
 UsdUtilsSparseValueWriter*
 UsdMayaPrimWriter::_GetSparseValueWriter()
+{
+    return _valueWriter.GetSparseValueWriter();
+}
+
+UsdMayaStagedValueWriter*
+UsdMayaPrimWriter::_GetStagedValueWriter()
 {
     return &_valueWriter;
 }
@@ -22,6 +22,7 @@
 #include "usdMaya/api.h"
 
 #include "usdMaya/jobArgs.h"
+#include "usdMaya/stagedValueWriter.h"
 #include "usdMaya/util.h"
 
 #include "pxr/base/vt/value.h"
@@ -180,7 +181,7 @@ protected:
     /// Sets the value of \p attr to \p value at \p time with value
     /// compression. When this method is used to write attribute values,
     /// any redundant authoring of the default value or of time-samples
-    /// are avoided (by using the utility class UsdUtilsSparseValueWriter).
+    /// are avoided (by using the utility class UsdMayaStagedValueWriter).
     template <typename T>
     bool _SetAttribute(
             const UsdAttribute& attr,
@@ -200,15 +201,24 @@ protected:
             const UsdAttribute& attr,
             T* value,
             const UsdTimeCode time = UsdTimeCode::Default()) {
-        return _valueWriter.SetAttribute(attr, VtValue::Take(*value), time);
+        VtValue val = VtValue::Take(*value);
+        return _valueWriter.SetAttribute(attr, &val, time);
     }
 
     /// Get the attribute value-writer object to be used when writing
     /// attributes. Access to this is provided so that attribute authoring
-    /// happening inside non-member functions can make use of it.
+    /// happening inside non-member functions can make use of it. Values
+    /// written through it are always authored directly on the stage; use
+    /// _GetStagedValueWriter() to have them staged with the parallelWrite
+    /// export arg.
     PXRUSDMAYA_API
     UsdUtilsSparseValueWriter* _GetSparseValueWriter();
 
+    /// Get the value-writer object used by _SetAttribute(). Values written
+    /// through it are staged in the same way as with _SetAttribute().
+    PXRUSDMAYA_API
+    UsdMayaStagedValueWriter* _GetStagedValueWriter();
+
     UsdPrim _usdPrim;
     UsdMayaWriteJobContext& _writeJobCtx;
 
@@ -232,7 +242,7 @@ private:
     const SdfPath _usdPath;
     const UsdMayaUtil::MDagPathMap<SdfPath> _baseDagToUsdPaths;
 
-    UsdUtilsSparseValueWriter _valueWriter;
+    UsdMayaStagedValueWriter _valueWriter;
 
     bool _exportVisibility;
     bool _hasAnimCurves;
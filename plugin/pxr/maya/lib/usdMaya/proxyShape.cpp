@@ -16,9 +16,11 @@
 #include "usdMaya/proxyShape.h"
 
 #include "usdMaya/hdImagingShape.h"
+#include "usdMaya/proxyShapeBoundsCache.h"
 #include "usdMaya/query.h"
 #include "usdMaya/stageCache.h"
 #include "usdMaya/stageData.h"
+#include "usdMaya/stageLoadQueue.h"
 #include "usdMaya/util.h"
 
 #include "pxr/base/gf/bbox3d.h"
@@ -71,7 +73,6 @@
 #include <maya/MTime.h>
 #include <maya/MViewport2Renderer.h>
 
-#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -397,6 +398,62 @@ UsdMayaProxyShape::GetObjectSoftSelectEnabled()
     return _sharedObjectSoftSelectEnabledDelgate();
 }
 
+/// Returns the shared session layer that selects the \p variantKey
+/// modelingVariant of the model at the root of \p primPath, or null if there
+/// is no variant key.
+static
+SdfLayerRefPtr
+_GetVariantKeySessionLayer(
+        const std::string& variantKey,
+        const std::string& primPath)
+{
+    if (variantKey.empty()) {
+        return SdfLayerRefPtr();
+    }
+
+    std::vector<std::pair<std::string, std::string> > variantSelections;
+    variantSelections.push_back(std::make_pair("modelingVariant", variantKey));
+
+    const std::vector<std::string> primPathEltStrs =
+        TfStringTokenize(primPath, "/");
+    if (primPathEltStrs.empty()) {
+        return SdfLayerRefPtr();
+    }
+
+    return UsdUtilsStageCache::GetSessionLayerForVariantSelections(
+        TfToken(primPathEltStrs[0]), variantSelections);
+}
+
+static
+std::string
+_GetQueuedStageRootLayerPath(const MObject& node)
+{
+    // Shapes with an incoming stage do not open one themselves.
+    if (MPlug(node, UsdMayaProxyShape::inStageDataAttr).isDestination()) {
+        return std::string();
+    }
+
+    const MString filePath =
+        MPlug(node, UsdMayaProxyShape::filePathAttr).asString();
+    return TfStringTrimRight(filePath.asChar());
+}
+
+static
+bool
+_GetQueuedStageSessionLayer(
+        const MObject& node,
+        const SdfLayerRefPtr& /*rootLayer*/,
+        SdfLayerRefPtr* sessionLayer)
+{
+    const MString variantKey =
+        MPlug(node, UsdMayaProxyShape::variantKeyAttr).asString();
+    const MString primPath =
+        MPlug(node, UsdMayaProxyShape::primPathAttr).asString();
+    *sessionLayer =
+        _GetVariantKeySessionLayer(variantKey.asChar(), primPath.asChar());
+    return true;
+}
+
 /* virtual */
 void
 UsdMayaProxyShape::postConstructor()
@@ -406,6 +463,13 @@ UsdMayaProxyShape::postConstructor()
     // This shape uses Hydra for imaging, so make sure that the
     // pxrHdImagingShape is setup.
     PxrMayaHdImagingShape::GetOrCreateInstance();
+
+    // Shapes read from a file have their stages opened together with those of
+    // the rest of the scene.
+    UsdMaya_StageLoadQueue::Enqueue(
+        thisMObject(),
+        _GetQueuedStageRootLayerPath,
+        _GetQueuedStageSessionLayer);
 }
 
 /* virtual */
@@ -484,26 +548,13 @@ UsdMayaProxyShape::computeInStageDataCached(MDataBlock& dataBlock)
         CHECK_MSTATUS_AND_RETURN_IT(retValue);
         const MString variantKey = variantKeyHandle.asString();
 
-        SdfLayerRefPtr sessionLayer;
-        std::vector<std::pair<std::string, std::string> > variantSelections;
-        std::string variantKeyString = variantKey.asChar();
-        if (!variantKeyString.empty()) {
-            variantSelections.push_back(
-                std::make_pair("modelingVariant",variantKeyString));
-
-            // Get the primPath
-            const MString primPathMString =
-                dataBlock.inputValue(primPathAttr, &retValue).asString();
-            CHECK_MSTATUS_AND_RETURN_IT(retValue);
-
-            std::vector<std::string> primPathEltStrs =
-                TfStringTokenize(primPathMString.asChar(),"/");
-            if (!primPathEltStrs.empty()) {
-                sessionLayer =
-                    UsdUtilsStageCache::GetSessionLayerForVariantSelections(
-                        TfToken(primPathEltStrs[0]), variantSelections);
-            }
-        }
+        // Get the primPath
+        const MString primPathMString =
+            dataBlock.inputValue(primPathAttr, &retValue).asString();
+        CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
+        SdfLayerRefPtr sessionLayer = _GetVariantKeySessionLayer(
+            variantKey.asChar(), primPathMString.asChar());
 
         if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(fileString)) {
             UsdStageCacheContext ctx(UsdMayaStageCache::Get());
@@ -555,11 +606,12 @@ UsdMayaProxyShape::computeOutStageData(MDataBlock& dataBlock)
 {
     MStatus retValue = MS::kSuccess;
 
-    TfReset(_boundingBoxCache);
+    _boundingBoxCache->Clear();
 
     // Reset the stage listener until we determine that everything is valid.
     _stageNoticeListener.SetStage(UsdStageWeakPtr());
     _stageNoticeListener.SetStageContentsChangedCallback(nullptr);
+    _stageNoticeListener.SetStageObjectsChangedCallback(nullptr);
 
     MDataHandle inDataCachedHandle =
         dataBlock.inputValue(inStageDataCachedAttr, &retValue);
@@ -642,6 +694,10 @@ UsdMayaProxyShape::computeOutStageData(MDataBlock& dataBlock)
         std::bind(&UsdMayaProxyShape::_OnStageContentsChanged,
                   this,
                   std::placeholders::_1));
+    _stageNoticeListener.SetStageObjectsChangedCallback(
+        std::bind(&UsdMayaProxyShape::_OnStageObjectsChanged,
+                  this,
+                  std::placeholders::_1));
 
     return MS::kSuccess;
 }
@@ -670,27 +726,14 @@ UsdMayaProxyShape::boundingBox() const
     dataBlock.inputValue(outStageDataAttr, &status);
     CHECK_MSTATUS_AND_RETURN(status, MBoundingBox());
 
-    // XXX:
-    // If we could cheaply determine whether a stage only has static geometry,
-    // we could make this value a constant one for that case, avoiding the
-    // memory overhead of a cache entry per frame
     MDataHandle timeHandle = dataBlock.inputValue(timeAttr, &status);
     UsdTimeCode currTime = UsdTimeCode(timeHandle.asTime().value());
 
-    std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup =
-        _boundingBoxCache.find(currTime);
-
-    if (cacheLookup != _boundingBoxCache.end()) {
-        return cacheLookup->second;
-    }
-
     UsdPrim prim = usdPrim();
     if (!prim) {
         return MBoundingBox();
     }
 
-    const UsdGeomImageable imageablePrim(prim);
-
     bool drawRenderPurpose = false;
     bool drawProxyPurpose = true;
     bool drawGuidePurpose = false;
@@ -700,24 +743,24 @@ UsdMayaProxyShape::boundingBox() const
         &drawProxyPurpose,
         &drawGuidePurpose);
 
-    const TfToken purpose1 = UsdGeomTokens->default_;
-    const TfToken purpose2 =
-        drawRenderPurpose ? UsdGeomTokens->render : TfToken();
-    const TfToken purpose3 =
-        drawProxyPurpose ? UsdGeomTokens->proxy : TfToken();
-    const TfToken purpose4 =
-        drawGuidePurpose ? UsdGeomTokens->guide : TfToken();
+    TfTokenVector purposes = { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
 
-    const GfBBox3d allBox = imageablePrim.ComputeUntransformedBound(
-        currTime,
-        purpose1,
-        purpose2,
-        purpose3,
-        purpose4);
+    UsdMaya_ProxyShapeBoundsCache& boundsCache =
+        *nonConstThis->_boundingBoxCache;
 
-    MBoundingBox& retval = nonConstThis->_boundingBoxCache[currTime];
+    const GfRange3d boxRange =
+        boundsCache.GetBound(prim, currTime, purposes);
 
-    const GfRange3d boxRange = allBox.ComputeAlignedBox();
+    MBoundingBox retval;
     if (!boxRange.IsEmpty()) {
         const GfVec3d boxMin = boxRange.GetMin();
         const GfVec3d boxMax = boxRange.GetMax();
@@ -943,6 +986,7 @@ UsdMayaProxyShape::GetAllRenderAttributes(
 
 UsdMayaProxyShape::UsdMayaProxyShape() :
     MPxSurfaceShape(),
+    _boundingBoxCache(new UsdMaya_ProxyShapeBoundsCache()),
     _useFastPlayback(false)
 {
     TfRegistryManager::GetInstance().SubscribeTo<UsdMayaProxyShape>();
@@ -1008,6 +1052,14 @@ UsdMayaProxyShape::_OnStageContentsChanged(
     MHWRender::MRenderer::setGeometryDrawDirty(thisMObject());
 }
 
+void
+UsdMayaProxyShape::_OnStageObjectsChanged(
+        const UsdNotice::ObjectsChanged& notice)
+{
+    // Only drop the cached bounds that the edit may have affected.
+    _boundingBoxCache->Invalidate(notice);
+}
+
 bool
 UsdMayaProxyShape::closestPoint(
     const MPoint& raySource,
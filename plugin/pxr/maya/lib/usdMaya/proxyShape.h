@@ -47,7 +47,7 @@
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
-#include <map>
+#include <memory>
 
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -61,6 +61,8 @@ TF_DECLARE_PUBLIC_TOKENS(UsdMayaProxyShapeTokens,
                          PXRUSDMAYA_PROXY_SHAPE_TOKENS);
 
 
+class UsdMaya_ProxyShapeBoundsCache;
+
 class UsdMayaProxyShape : public MPxSurfaceShape,
                           public UsdMayaUsdPrimProvider
 {
@@ -243,9 +245,12 @@ class UsdMayaProxyShape : public MPxSurfaceShape,
         void _OnStageContentsChanged(
                 const UsdNotice::StageContentsChanged& notice);
 
+        void _OnStageObjectsChanged(
+                const UsdNotice::ObjectsChanged& notice);
+
         UsdMayaStageNoticeListener _stageNoticeListener;
 
-        std::map<UsdTimeCode, MBoundingBox> _boundingBoxCache;
+        std::unique_ptr<UsdMaya_ProxyShapeBoundsCache> _boundingBoxCache;
 
         bool _useFastPlayback;
 
@@ -0,0 +1,225 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "usdMaya/proxyShapeBoundsCache.h"
+
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usdGeom/boundable.h"
+#include "pxr/usd/usdGeom/pointBased.h"
+#include "pxr/usd/usdGeom/xformable.h"
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/// Returns true if any of the attributes that contribute to the bounds of
+/// \p prim might be time-varying.
+static
+bool
+_MightBoundsBeTimeVarying(const UsdPrim& prim)
+{
+    const UsdGeomXformable xformable(prim);
+    if (xformable &&
+            (xformable.TransformMightBeTimeVarying() ||
+             xformable.GetVisibilityAttr().ValueMightBeTimeVarying())) {
+        return true;
+    }
+
+    const UsdGeomBoundable boundable(prim);
+    if (!boundable) {
+        return false;
+    }
+    if (boundable.GetExtentAttr().ValueMightBeTimeVarying()) {
+        return true;
+    }
+
+    const UsdGeomPointBased pointBased(prim);
+    if (pointBased) {
+        return pointBased.GetPointsAttr().ValueMightBeTimeVarying();
+    }
+
+    // The bounds of the other boundable prims (spheres, cubes, etc.) are
+    // driven by attributes of their own schemas.
+    for (const UsdAttribute& attr : prim.GetAttributes()) {
+        if (!TfStringStartsWith(attr.GetName().GetString(), "primvars:") &&
+                attr.ValueMightBeTimeVarying()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static
+bool
+_MightHierarchyBoundsBeTimeVarying(const UsdPrim& root)
+{
+    for (const UsdPrim& prim :
+            UsdPrimRange(root, UsdTraverseInstanceProxies())) {
+        if (_MightBoundsBeTimeVarying(prim)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+UsdMaya_ProxyShapeBoundsCache::UsdMaya_ProxyShapeBoundsCache(size_t capacity) :
+    _bboxCache(
+        UsdTimeCode::Default(),
+        TfTokenVector(),
+        /* useExtentsHint = */ false),
+    _capacity(std::max<size_t>(capacity, 1u)),
+    _lastUsed(0u),
+    _state(_State::Unknown)
+{
+}
+
+void
+UsdMaya_ProxyShapeBoundsCache::Clear()
+{
+    _entries.clear();
+    _bboxCache.Clear();
+    _rootPath = SdfPath();
+    _state = _State::Unknown;
+}
+
+void
+UsdMaya_ProxyShapeBoundsCache::Invalidate(
+        const UsdNotice::ObjectsChanged& notice)
+{
+    if (_state == _State::Unknown) {
+        return;
+    }
+
+    const UsdStageWeakPtr stage = notice.GetStage();
+    bool affected = false;
+    bool animated = false;
+    bool rescan = false;
+    const auto check = [&](const SdfPath& changedPath, bool resynced) {
+        const SdfPath primPath = changedPath.GetPrimPath();
+        if (primPath.HasPrefix(_rootPath)) {
+            affected = true;
+            if (_state == _State::Static && !animated) {
+                const UsdPrim prim = stage->GetPrimAtPath(primPath);
+                animated = prim &&
+                    (resynced ?
+                        _MightHierarchyBoundsBeTimeVarying(prim) :
+                        _MightBoundsBeTimeVarying(prim));
+            }
+        } else if (_rootPath.HasPrefix(primPath)) {
+            // Edits of an ancestor (its visibility, for instance) can change
+            // the bounds, and resyncing it rebuilds the whole hierarchy.
+            affected = true;
+            rescan = rescan || resynced;
+        }
+    };
+
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        check(path, true);
+    }
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        check(path, false);
+    }
+
+    if (!affected) {
+        return;
+    }
+
+    _entries.clear();
+    _bboxCache.Clear();
+    if (rescan) {
+        _state = _State::Unknown;
+    } else if (animated) {
+        _state = _State::Animated;
+    }
+}
+
+void
+UsdMaya_ProxyShapeBoundsCache::_Update(
+        const UsdPrim& prim,
+        const TfTokenVector& purposes)
+{
+    if (_bboxCache.GetIncludedPurposes() != purposes) {
+        _bboxCache.SetIncludedPurposes(purposes);
+        _entries.clear();
+    }
+
+    if (_state == _State::Unknown) {
+        _rootPath = prim.GetPath();
+        _state = _MightHierarchyBoundsBeTimeVarying(prim) ?
+            _State::Animated : _State::Static;
+    }
+}
+
+UsdMaya_ProxyShapeBoundsCache::_Entries::const_iterator
+UsdMaya_ProxyShapeBoundsCache::_LowerBound(UsdTimeCode time) const
+{
+    return std::lower_bound(
+        _entries.begin(),
+        _entries.end(),
+        time,
+        [](const _Entry& entry, UsdTimeCode t) { return entry.time < t; });
+}
+
+void
+UsdMaya_ProxyShapeBoundsCache::_Insert(
+        UsdTimeCode time,
+        const GfRange3d& bound)
+{
+    if (_entries.size() >= _capacity) {
+        const auto leastRecentlyUsed = std::min_element(
+            _entries.begin(),
+            _entries.end(),
+            [](const _Entry& a, const _Entry& b) {
+                return a.lastUsed < b.lastUsed;
+            });
+        _entries.erase(leastRecentlyUsed);
+    }
+
+    _entries.insert(_LowerBound(time), _Entry{time, bound, ++_lastUsed});
+}
+
+GfRange3d
+UsdMaya_ProxyShapeBoundsCache::GetBound(
+        const UsdPrim& prim,
+        UsdTimeCode time,
+        const TfTokenVector& purposes)
+{
+    _Update(prim, purposes);
+
+    // The only entry of a static hierarchy is valid at all times.
+    if (_state == _State::Static && !_entries.empty()) {
+        return _entries.front().bound;
+    }
+
+    const auto it = _LowerBound(time);
+    if (it != _entries.end() && it->time == time) {
+        _entries[it - _entries.begin()].lastUsed = ++_lastUsed;
+        return it->bound;
+    }
+
+    _bboxCache.SetTime(time);
+    const GfRange3d bound =
+        _bboxCache.ComputeUntransformedBound(prim).ComputeAlignedBox();
+    _Insert(time, bound);
+    return bound;
+}
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
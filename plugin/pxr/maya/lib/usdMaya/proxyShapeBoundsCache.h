@@ -0,0 +1,109 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_PROXY_SHAPE_BOUNDS_CACHE_H
+#define PXRUSDMAYA_PROXY_SHAPE_BOUNDS_CACHE_H
+
+/// \file usdMaya/proxyShapeBoundsCache.h
+
+#include "pxr/pxr.h"
+
+#include "pxr/base/gf/range3d.h"
+#include "pxr/base/tf/token.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/usdGeom/bboxCache.h"
+
+#include <cstdint>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/// Bounded cache of the untransformed bounds of a proxy shape's prim over
+/// time.
+///
+/// The first time bounds are requested, the prim's hierarchy is inspected for
+/// time-varying attributes that contribute to its bounds. If there are none, a
+/// single bound is cached and returned for all times. Otherwise, bounds are
+/// kept in an array sorted by time, and the least recently used one is evicted
+/// once the cache reaches its capacity.
+///
+/// Misses are computed using a UsdGeomBBoxCache that is kept between calls, so
+/// the bounds of the static parts of an animated hierarchy are only computed
+/// once.
+class UsdMaya_ProxyShapeBoundsCache
+{
+public:
+    explicit UsdMaya_ProxyShapeBoundsCache(size_t capacity = 256);
+
+    /// Discards all of the cached bounds, and whether the hierarchy was found
+    /// to be static. This must be called whenever the prim or its stage
+    /// changes.
+    void Clear();
+
+    /// Returns the untransformed bound of \p prim at \p time, computing it if
+    /// it is not cached. Changing \p purposes discards the cached bounds.
+    GfRange3d GetBound(
+            const UsdPrim& prim,
+            UsdTimeCode time,
+            const TfTokenVector& purposes);
+
+    /// Discards the cached bounds that the edit described by \p notice may
+    /// have changed. Edits that are not below the prim, or to one of its
+    /// ancestors, are ignored. If the hierarchy was static, only the edited
+    /// prims are checked for animation rather than the whole hierarchy.
+    void Invalidate(const UsdNotice::ObjectsChanged& notice);
+
+    /// Returns true if the hierarchy has been found to be static.
+    bool IsStatic() const {
+        return _state == _State::Static;
+    }
+
+private:
+    struct _Entry
+    {
+        UsdTimeCode time;
+        GfRange3d bound;
+        uint64_t lastUsed;
+    };
+    using _Entries = std::vector<_Entry>;
+
+    enum class _State
+    {
+        Unknown,
+        Static,
+        Animated
+    };
+
+    void _Update(const UsdPrim& prim, const TfTokenVector& purposes);
+    _Entries::const_iterator _LowerBound(UsdTimeCode time) const;
+    void _Insert(UsdTimeCode time, const GfRange3d& bound);
+
+    _Entries _entries;
+    UsdGeomBBoxCache _bboxCache;
+    SdfPath _rootPath;
+    size_t _capacity;
+    uint64_t _lastUsed;
+    _State _state;
+};
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+
+#endif
@@ -15,15 +15,18 @@
 //
 #include "usdMaya/readJob.h"
 
+#include "usdMaya/debugCodes.h"
 #include "usdMaya/primReaderRegistry.h"
+#include "usdMaya/readPrefetchCache.h"
 #include "usdMaya/shadingModeRegistry.h"
 #include "usdMaya/stageCache.h"
-#include "usdMaya/stageNode.h"
 #include "usdMaya/translatorMaterial.h"
 #include "usdMaya/translatorModelAssembly.h"
 #include "usdMaya/translatorXformable.h"
 #include "usdMaya/util.h"
 
+#include "pxr/base/tf/debug.h"
+#include "pxr/base/tf/stopwatch.h"
 #include "pxr/base/tf/token.h"
 
 #include "pxr/usd/sdf/layer.h"
@@ -34,6 +37,7 @@
 #include "pxr/usd/usd/stageCacheContext.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usd/variantSets.h"
+#include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usdGeom/metrics.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
@@ -42,15 +46,14 @@
 
 #include <maya/MAnimControl.h>
 #include <maya/MDagModifier.h>
-#include <maya/MDGModifier.h>
 #include <maya/MDistance.h>
-#include <maya/MFnDependencyNode.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MStatus.h>
 #include <maya/MTime.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -225,33 +228,8 @@ UsdMaya_ReadJob::Read(std::vector<MDagPath>* addedDagPaths)
                 rootPathToRegister.GetString(),
                 mMayaRootDagPath.node()));
 
-    if (mArgs.useAsAnimationCache) {
-        MDGModifier dgMod;
-        MObject usdStageNode = dgMod.createNode(UsdMayaStageNode::typeId,
-                                                &status);
-        CHECK_MSTATUS_AND_RETURN(status, false);
-
-        // We only ever create a single stage node per usdImport, so we can
-        // simply register it and later look it up in the registry using its
-        // type name.
-        mNewNodeRegistry.insert(
-            std::make_pair(UsdMayaStageNodeTokens->MayaTypeName.GetString(),
-                           usdStageNode));
-
-        MFnDependencyNode depNodeFn(usdStageNode, &status);
-        CHECK_MSTATUS_AND_RETURN(status, false);
-
-        MPlug filePathPlug = depNodeFn.findPlug(UsdMayaStageNode::filePathAttr,
-                                                true,
-                                                &status);
-        CHECK_MSTATUS_AND_RETURN(status, false);
-
-        status = dgMod.newPlugValueString(filePathPlug, mFileName.c_str());
-        CHECK_MSTATUS_AND_RETURN(status, false);
-
-        status = dgMod.doIt();
-        CHECK_MSTATUS_AND_RETURN(status, false);
-    }
+    TfStopwatch importStopwatch;
+    importStopwatch.Start();
 
     if (mArgs.importWithProxyShapes) {
         _DoImportWithProxies(range);
@@ -259,6 +237,13 @@ UsdMaya_ReadJob::Read(std::vector<MDagPath>* addedDagPaths)
         _DoImport(range, usdRootPrim);
     }
 
+    importStopwatch.Stop();
+    TF_DEBUG(PXRUSDMAYA_READ_JOB).Msg(
+            "UsdMaya_ReadJob: read <%s> in %.3f seconds (parallelRead: %s)\n",
+            usdRootPrim.GetPath().GetText(),
+            importStopwatch.GetSeconds(),
+            mArgs.parallelRead ? "on" : "off");
+
     SdfPathSet topImportedPaths;
     if (isImportingPsuedoRoot) {
         // get all the dag paths for the root prims
@@ -283,9 +268,55 @@ UsdMaya_ReadJob::Read(std::vector<MDagPath>* addedDagPaths)
 }
 
 
+std::unique_ptr<UsdMaya_ReadPrefetchCache>
+UsdMaya_ReadJob::_CreatePrefetchCache(
+        const UsdPrimRange& rootRange,
+        const UsdPrim& usdRootPrim) const
+{
+    std::unique_ptr<UsdMaya_ReadPrefetchCache> prefetchCache(
+        new UsdMaya_ReadPrefetchCache(mArgs.timeInterval));
+
+    // Collect the meshes in the order in which _DoImport will visit them.
+    // Models that will be imported as assemblies are skipped since their
+    // meshes are not read by this job.
+    for (auto rootIt = rootRange.begin(); rootIt != rootRange.end(); ++rootIt) {
+        rootIt.PruneChildren();
+
+        const UsdPrimRange range(*rootIt);
+        for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
+            const UsdPrim& prim = *primIt;
+
+            std::string assetIdentifier;
+            SdfPath assetPrimPath;
+            if (mArgs.assemblyRep != UsdMayaJobImportArgsTokens->Import &&
+                    UsdMayaTranslatorModelAssembly::ShouldImportAsAssembly(
+                        usdRootPrim,
+                        prim,
+                        &assetIdentifier,
+                        &assetPrimPath)) {
+                primIt.PruneChildren();
+                continue;
+            }
+
+            if (prim.IsA<UsdGeomMesh>()) {
+                prefetchCache->AddMesh(prim);
+            }
+        }
+    }
+
+    return prefetchCache;
+}
+
 bool
 UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
 {
+    // When reading in parallel, the data of the meshes is read ahead of their
+    // prim readers, a window of meshes at a time.
+    std::unique_ptr<UsdMaya_ReadPrefetchCache> prefetchCache;
+    if (mArgs.parallelRead) {
+        prefetchCache = _CreatePrefetchCache(rootRange, usdRootPrim);
+    }
+
     // We want both pre- and post- visit iterations over the prims in this
     // method. To do so, iterate over all the root prims of the input range,
     // and create new PrimRanges to iterate over their subtrees.
@@ -304,7 +335,7 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
             // step.
             if (!primIt.IsPostVisit()) {
                 // This is the normal Read step (pre-visit).
-                UsdMayaPrimReaderArgs args(prim, mArgs);
+                UsdMayaPrimReaderArgs args(prim, mArgs, prefetchCache.get());
                 UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
 
                 // If we are NOT importing on behalf of an assembly, then we'll
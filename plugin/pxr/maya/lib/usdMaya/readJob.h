@@ -30,12 +30,15 @@
 #include <maya/MDagPath.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
 
+class UsdMaya_ReadPrefetchCache;
+
 
 class UsdMaya_ReadJob
 {
@@ -73,6 +76,12 @@ private:
     bool _DoImport(UsdPrimRange& range, const UsdPrim& usdRootPrim);
     bool _DoImportWithProxies(UsdPrimRange& range);
 
+    // Collects the meshes that _DoImport will read, for the parallelRead
+    // import arg.
+    std::unique_ptr<UsdMaya_ReadPrefetchCache> _CreatePrefetchCache(
+            const UsdPrimRange& range,
+            const UsdPrim& usdRootPrim) const;
+
     // These are helper methods for the proxy import method.
     bool _ProcessProxyPrims(
             const std::vector<UsdPrim>& proxyPrims,
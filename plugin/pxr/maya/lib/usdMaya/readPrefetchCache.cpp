@@ -0,0 +1,248 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "usdMaya/readPrefetchCache.h"
+
+#include "usdMaya/debugCodes.h"
+
+#include "pxr/base/tf/debug.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/vt/types.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/timeCode.h"
+
+#include <algorithm>
+#include <utility>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/* static */
+bool
+UsdMaya_ReadPrefetchCache::ReadMesh(
+        const UsdGeomMesh& mesh,
+        const GfInterval& timeInterval,
+        MeshData* data,
+        std::string* reason)
+{
+    const UsdPrim& prim = mesh.GetPrim();
+
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+
+    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
+    if (fvc.ValueMightBeTimeVarying()) {
+        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
+        // for the mesh, perhaps?  For now, better to give a more specific error
+        *reason = TfStringPrintf(
+                "<%s> is a topologically varying Mesh (has animated "
+                "faceVertexCounts), which isn't currently supported. "
+                "Skipping...",
+                prim.GetPath().GetText());
+        return false;
+    }
+    fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
+
+    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
+    if (fvi.ValueMightBeTimeVarying()) {
+        *reason = TfStringPrintf(
+                "<%s> is a topologically varying Mesh (has animated "
+                "faceVertexIndices), which isn't currently supported. "
+                "Skipping...",
+                prim.GetPath().GetText());
+        return false;
+    }
+    fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
+
+    // Sanity Checks. If the vertex arrays are empty, skip this mesh
+    if (faceVertexCounts.empty() || faceVertexIndices.empty()) {
+        *reason = TfStringPrintf(
+                "faceVertexCounts or faceVertexIndices array is empty "
+                "[count: %zu, indices:%zu] on Mesh <%s>. Skipping...",
+                faceVertexCounts.size(), faceVertexIndices.size(),
+                prim.GetPath().GetText());
+        return false; // invalid mesh, so exit
+    }
+
+    // Gather points and normals
+    // If timeInterval is non-empty, pick the first available sample in the
+    // timeInterval or default.
+    VtVec3fArray points;
+    VtVec3fArray normals;
+    UsdTimeCode pointsTimeSample = UsdTimeCode::EarliestTime();
+    UsdTimeCode normalsTimeSample = UsdTimeCode::EarliestTime();
+    data->pointsTimeSamples.clear();
+    if (!timeInterval.IsEmpty()) {
+        mesh.GetPointsAttr().GetTimeSamplesInInterval(
+                timeInterval, &data->pointsTimeSamples);
+        if (!data->pointsTimeSamples.empty()) {
+            pointsTimeSample = data->pointsTimeSamples.front();
+        }
+
+        std::vector<double> normalsTimeSamples;
+        mesh.GetNormalsAttr().GetTimeSamplesInInterval(
+                timeInterval, &normalsTimeSamples);
+        if (!normalsTimeSamples.empty()) {
+            normalsTimeSample = normalsTimeSamples.front();
+        }
+    }
+
+    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
+    mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
+
+    if (points.empty()) {
+        *reason = TfStringPrintf(
+                "points array is empty on Mesh <%s>. Skipping...",
+                prim.GetPath().GetText());
+        return false;
+    }
+
+    std::string topologyReason;
+    if (!UsdGeomMesh::ValidateTopology(faceVertexIndices,
+                                       faceVertexCounts,
+                                       points.size(),
+                                       &topologyReason)) {
+        *reason = TfStringPrintf(
+                "Skipping Mesh <%s> with invalid topology: %s",
+                prim.GetPath().GetText(), topologyReason.c_str());
+        return false;
+    }
+
+    // == Convert data
+    const size_t numVertices = points.size();
+    data->points.setLength(numVertices);
+    for (size_t i = 0u; i < numVertices; ++i) {
+        data->points.set(i, points[i][0], points[i][1], points[i][2]);
+    }
+
+    data->polygonCounts = MIntArray(
+            faceVertexCounts.cdata(), faceVertexCounts.size());
+    data->polygonConnects = MIntArray(
+            faceVertexIndices.cdata(), faceVertexIndices.size());
+
+    // Normals are only used when there is one per face-vertex.
+    data->normals.clear();
+    data->normalsFaceIds.clear();
+    if (normals.size() == faceVertexIndices.size()) {
+        data->normalsFaceIds.setLength(faceVertexIndices.size());
+        unsigned int faceVertex = 0u;
+        for (size_t i = 0u; i < faceVertexCounts.size(); ++i) {
+            for (int j = 0; j < faceVertexCounts[i]; ++j) {
+                data->normalsFaceIds[faceVertex++] = i;
+            }
+        }
+
+        data->normals.setLength(normals.size());
+        for (size_t i = 0u; i < normals.size(); ++i) {
+            data->normals.set(MVector(normals[i][0u],
+                                      normals[i][1u],
+                                      normals[i][2u]),
+                              i);
+        }
+    }
+
+    return true;
+}
+
+UsdMaya_ReadPrefetchCache::UsdMaya_ReadPrefetchCache(
+        const GfInterval& timeInterval,
+        size_t windowSize) :
+    _timeInterval(timeInterval),
+    _windowSize(std::max<size_t>(windowSize, 1u)),
+    _windowBegin(0u),
+    _numWindows(0u),
+    _numHits(0u),
+    _numMisses(0u)
+{
+}
+
+UsdMaya_ReadPrefetchCache::~UsdMaya_ReadPrefetchCache()
+{
+    TF_DEBUG(PXRUSDMAYA_READ_JOB).Msg(
+            "UsdMaya_ReadPrefetchCache: prefetched %zu meshes in %zu "
+            "windows in %.3f seconds (%zu used, %zu read by their prim "
+            "reader)\n",
+            _prims.size(),
+            _numWindows,
+            _fetchStopwatch.GetSeconds(),
+            _numHits,
+            _numMisses);
+}
+
+void
+UsdMaya_ReadPrefetchCache::AddMesh(const UsdPrim& prim)
+{
+    if (_indices.insert(std::make_pair(prim.GetPath(), _prims.size())).second) {
+        _prims.push_back(prim);
+    }
+}
+
+UsdMaya_ReadPrefetchCache::MeshData*
+UsdMaya_ReadPrefetchCache::GetMesh(const UsdPrim& prim)
+{
+    const auto it = _indices.find(prim.GetPath());
+    if (it == _indices.end()) {
+        ++_numMisses;
+        return nullptr;
+    }
+
+    const size_t index = it->second;
+    if (index < _windowBegin || index >= _windowBegin + _window.size()) {
+        _Fetch(index);
+    }
+
+    _Entry& entry = _window[index - _windowBegin];
+    if (!entry.valid) {
+        ++_numMisses;
+        return nullptr;
+    }
+
+    ++_numHits;
+    return &entry.data;
+}
+
+void
+UsdMaya_ReadPrefetchCache::_Fetch(size_t begin)
+{
+    const size_t end = std::min(begin + _windowSize, _prims.size());
+
+    _fetchStopwatch.Start();
+
+    _window.clear();
+    _window.resize(end - begin);
+    _windowBegin = begin;
+
+    WorkParallelForN(
+        end - begin,
+        [this, begin](size_t first, size_t last) {
+            std::string reason;
+            for (size_t i = first; i < last; ++i) {
+                const UsdGeomMesh mesh(_prims[begin + i]);
+                _Entry& entry = _window[i];
+                // Meshes that can't be read are left to their prim reader,
+                // which reports why.
+                entry.valid = mesh &&
+                    ReadMesh(mesh, _timeInterval, &entry.data, &reason);
+            }
+        });
+
+    _fetchStopwatch.Stop();
+    ++_numWindows;
+}
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,135 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_READ_PREFETCH_CACHE_H
+#define PXRUSDMAYA_READ_PREFETCH_CACHE_H
+
+/// \file usdMaya/readPrefetchCache.h
+
+#include "pxr/pxr.h"
+
+#include "pxr/base/gf/interval.h"
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/base/tf/stopwatch.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usdGeom/mesh.h"
+
+#include <maya/MIntArray.h>
+#include <maya/MPointArray.h>
+#include <maya/MVectorArray.h>
+
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/// Reads the USD data of the meshes of an import on worker threads, ahead of
+/// the serial creation of their Maya nodes.
+///
+/// Meshes are added in the order in which the read job visits them. When a
+/// mesh reader asks for a mesh that is not in the current window, the data of
+/// that mesh and of the meshes that follow it is read and converted into Maya
+/// arrays in parallel, replacing the previous window, so only a bounded
+/// number of meshes is held in memory at once.
+///
+/// The reads do not overlap the creation of Maya nodes, since prim readers
+/// are free to edit the stage.
+///
+/// Only the topology, points and normals of the meshes are prefetched. Their
+/// primvars (UV sets and color sets) and the transform samples of the prims
+/// are still read by the prim readers on the main thread.
+class UsdMaya_ReadPrefetchCache
+{
+public:
+    /// The data of a mesh, converted into the arrays expected by MFnMesh.
+    struct MeshData
+    {
+        MPointArray points;
+        MIntArray polygonCounts;
+        MIntArray polygonConnects;
+
+        /// The face-vertex normals and the face of each of them. These are
+        /// only filled when there is one normal per face-vertex.
+        MVectorArray normals;
+        MIntArray normalsFaceIds;
+
+        /// The time samples of the points within the import interval.
+        std::vector<double> pointsTimeSamples;
+    };
+
+    /// Reads the data of \p mesh, taking points and normals from their first
+    /// time sample within \p timeInterval. Returns false, and the reason in
+    /// \p reason, if the mesh is topologically varying, is empty or has
+    /// invalid topology.
+    ///
+    /// This does not post any diagnostics, so it is safe to call from worker
+    /// threads.
+    static bool ReadMesh(
+            const UsdGeomMesh& mesh,
+            const GfInterval& timeInterval,
+            MeshData* data,
+            std::string* reason);
+
+    UsdMaya_ReadPrefetchCache(
+            const GfInterval& timeInterval,
+            size_t windowSize = 256u);
+
+    ~UsdMaya_ReadPrefetchCache();
+
+    /// Appends \p prim to the meshes to prefetch.
+    void AddMesh(const UsdPrim& prim);
+
+    /// Returns the prefetched data of the mesh at \p prim, reading the window
+    /// that starts at that mesh first if needed. The data stays valid until
+    /// the next call. Returns null if the mesh was not added or could not be
+    /// read, in which case the caller should read it itself.
+    MeshData* GetMesh(const UsdPrim& prim);
+
+    /// Returns the number of meshes added to the cache.
+    size_t GetNumMeshes() const {
+        return _prims.size();
+    }
+
+private:
+    struct _Entry
+    {
+        MeshData data;
+        bool valid = false;
+    };
+
+    void _Fetch(size_t begin);
+
+    GfInterval _timeInterval;
+    size_t _windowSize;
+
+    std::vector<UsdPrim> _prims;
+    TfHashMap<SdfPath, size_t, SdfPath::Hash> _indices;
+
+    std::vector<_Entry> _window;
+    size_t _windowBegin;
+
+    TfStopwatch _fetchStopwatch;
+    size_t _numWindows;
+    size_t _numHits;
+    size_t _numMisses;
+};
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+
+#endif
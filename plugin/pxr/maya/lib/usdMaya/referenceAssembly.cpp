@@ -23,6 +23,7 @@
 #include "usdMaya/readJob.h"
 #include "usdMaya/stageCache.h"
 #include "usdMaya/stageData.h"
+#include "usdMaya/stageLoadQueue.h"
 
 #include "pxr/base/tf/fileUtils.h"
 #include "pxr/base/tf/registryManager.h"
@@ -416,6 +417,12 @@ bool UsdMayaReferenceAssembly::activateRep(const MString& repMStr)
 
 void UsdMayaReferenceAssembly::postLoad()
 {
+    // Activating the initial representation below pulls on the stage, and
+    // this runs while the file is still being read, before the queue is
+    // flushed by the kAfterOpen message. So open the stages of the nodes
+    // read so far together first.
+    UsdMaya_StageLoadQueue::Flush();
+
     MFnAssembly assemblyFn(thisMObject());
 
     // If this is not a top-level assembly, lock the repNamespace attribute.
@@ -635,6 +642,84 @@ std::set<std::string> _GetVariantSetNamesForStageCache(
     return varSetNames;
 }
 
+/// Returns the shared session layer that holds the variant selections and
+/// draw mode of the assembly \p dagNodeFn for the model of \p rootLayer.
+static
+SdfLayerRefPtr
+_GetSharedSessionLayer(
+        const MFnDagNode& dagNodeFn,
+        const SdfLayerRefPtr& rootLayer)
+{
+    std::map<std::string, std::string> varSels;
+    TfToken modelName = UsdUtilsGetModelNameFromRootLayer(rootLayer);
+    const std::set<std::string> varSetNamesForCache = _GetVariantSetNamesForStageCache(dagNodeFn);
+    TF_FOR_ALL(variantSet, varSetNamesForCache) {
+        MString variantSetPlugName(UsdMayaVariantSetTokens->PlugNamePrefix.GetText());
+        variantSetPlugName += variantSet->c_str();
+        MPlug varSetPlg = dagNodeFn.findPlug(variantSetPlugName, true);
+        if (!varSetPlg.isNull()) {
+            MString varSetVal = varSetPlg.asString();
+            if (varSetVal.length() > 0) {
+                varSels[*variantSet] = varSetVal.asChar();
+            }
+        }
+    }
+
+    TfToken drawMode;
+    MPlug drawModePlug =
+        dagNodeFn.findPlug(UsdMayaReferenceAssembly::drawModeAttr, true);
+    if (!drawModePlug.isNull()) {
+        drawMode = TfToken(drawModePlug.asString().asChar());
+    }
+
+    return UsdMayaStageCache::GetSharedSessionLayer(
+            SdfPath::AbsoluteRootPath().AppendChild(modelName),
+            varSels,
+            drawMode);
+}
+
+static
+std::string
+_GetQueuedStageRootLayerPath(const MObject& assemObj)
+{
+    // Assemblies with an incoming stage do not open one themselves.
+    if (MPlug(assemObj, UsdMayaReferenceAssembly::inStageDataAttr).isDestination()) {
+        return std::string();
+    }
+
+    const MString filePath =
+        MPlug(assemObj, UsdMayaReferenceAssembly::filePathAttr).asString();
+    return TfStringTrimRight(filePath.asChar());
+}
+
+static
+bool
+_GetQueuedStageSessionLayer(
+        const MObject& assemObj,
+        const SdfLayerRefPtr& rootLayer,
+        SdfLayerRefPtr* sessionLayer)
+{
+    // Assemblies with edits open their stages with a session layer of their
+    // own, so there is nothing to share.
+    MItEdits assemEdits(_GetEdits(assemObj));
+    if (!assemEdits.isDone()) {
+        return false;
+    }
+
+    *sessionLayer = _GetSharedSessionLayer(MFnDagNode(assemObj), rootLayer);
+    return true;
+}
+
+void UsdMayaReferenceAssembly::postConstructor()
+{
+    // Assemblies read from a file have their stages opened together with
+    // those of the rest of the scene.
+    UsdMaya_StageLoadQueue::Enqueue(
+        thisMObject(),
+        _GetQueuedStageRootLayerPath,
+        _GetQueuedStageSessionLayer);
+}
+
 MStatus
 UsdMayaReferenceAssembly::computeInStageDataCached(MDataBlock& dataBlock)
 {
@@ -677,32 +762,8 @@ UsdMayaReferenceAssembly::computeInStageDataCached(MDataBlock& dataBlock)
         MFnDagNode dagNodeFn(thisMObject());
 
         if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(fileString)) {
-            std::map<std::string, std::string> varSels;
-            TfToken modelName = UsdUtilsGetModelNameFromRootLayer(rootLayer);
-            const std::set<std::string> varSetNamesForCache = _GetVariantSetNamesForStageCache(dagNodeFn);
-            TF_FOR_ALL(variantSet, varSetNamesForCache) {
-                MString variantSetPlugName(UsdMayaVariantSetTokens->PlugNamePrefix.GetText());
-                variantSetPlugName += variantSet->c_str();
-                MPlug varSetPlg = dagNodeFn.findPlug(variantSetPlugName, true);
-                if (!varSetPlg.isNull()) {
-                    MString varSetVal = varSetPlg.asString();
-                    if (varSetVal.length() > 0) {
-                        varSels[*variantSet] = varSetVal.asChar();
-                    }
-                }
-            }
-
-            TfToken drawMode;
-            MPlug drawModePlug = dagNodeFn.findPlug(drawModeAttr, true);
-            if (!drawModePlug.isNull()) {
-                drawMode = TfToken(drawModePlug.asString().asChar());
-            }
-
             SdfLayerRefPtr sessionLayer =
-                    UsdMayaStageCache::GetSharedSessionLayer(
-                        SdfPath::AbsoluteRootPath().AppendChild(modelName),
-                        varSels,
-                        drawMode);
+                _GetSharedSessionLayer(dagNodeFn, rootLayer);
 
             // If we have assembly edits, do not share session layers with
             // other models that have our same set of variant selections,
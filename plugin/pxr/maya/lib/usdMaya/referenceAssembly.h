@@ -113,6 +113,8 @@ public:
 
     // == Base Class Virtuals ==
     PXRUSDMAYA_API
+    void postConstructor() override;
+    PXRUSDMAYA_API
     MStatus compute(const MPlug& plug, MDataBlock& dataBlock) override;
 
     PXRUSDMAYA_API
@@ -0,0 +1,252 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "usdMaya/stageLoadQueue.h"
+
+#include "usdMaya/debugCodes.h"
+#include "usdMaya/stageCache.h"
+
+#include "pxr/base/tf/debug.h"
+#include "pxr/base/tf/stopwatch.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/stageCache.h"
+
+#include <maya/MCallbackIdArray.h>
+#include <maya/MFileIO.h>
+#include <maya/MMessage.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MSceneMessage.h>
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+namespace {
+
+struct _QueuedNode
+{
+    MObjectHandle node;
+    UsdMaya_StageLoadQueue::RootLayerPathFn rootLayerPathFn;
+    UsdMaya_StageLoadQueue::SessionLayerFn sessionLayerFn;
+};
+
+// The queue is only accessed from the main thread.
+static std::vector<_QueuedNode> _queuedNodes;
+
+static MCallbackIdArray _callbackIds;
+
+static
+void
+_OnMayaFileReadCallback(void* /*clientData*/)
+{
+    UsdMaya_StageLoadQueue::Flush();
+}
+
+struct _StageKey
+{
+    SdfLayerRefPtr rootLayer;
+    SdfLayerRefPtr sessionLayer;
+};
+
+} // anonymous namespace
+
+/* static */
+void
+UsdMaya_StageLoadQueue::Enqueue(
+        const MObject& node,
+        const RootLayerPathFn& rootLayerPathFn,
+        const SessionLayerFn& sessionLayerFn)
+{
+    if (!MFileIO::isReadingFile()) {
+        return;
+    }
+
+    _queuedNodes.push_back(
+        _QueuedNode{MObjectHandle(node), rootLayerPathFn, sessionLayerFn});
+}
+
+/* static */
+void
+UsdMaya_StageLoadQueue::Flush()
+{
+    if (_queuedNodes.empty()) {
+        return;
+    }
+
+    // Take the queue first, so that a file read while the stages are opened
+    // (e.g. a reference loaded by a callback) starts a queue of its own.
+    std::vector<_QueuedNode> queuedNodes;
+    queuedNodes.swap(_queuedNodes);
+
+    TfStopwatch stopwatch;
+    stopwatch.Start();
+
+    // Gather the root layer paths of the nodes, and open the unique root
+    // layers in parallel.
+    std::vector<std::string> rootLayerPaths(queuedNodes.size());
+    std::map<std::string, size_t> rootLayerIndices;
+    for (size_t i = 0u; i < queuedNodes.size(); ++i) {
+        const MObjectHandle& node = queuedNodes[i].node;
+        if (!node.isValid() || !node.isAlive()) {
+            continue;
+        }
+
+        rootLayerPaths[i] = queuedNodes[i].rootLayerPathFn(node.object());
+        if (!rootLayerPaths[i].empty()) {
+            rootLayerIndices.insert(
+                std::make_pair(rootLayerPaths[i], rootLayerIndices.size()));
+        }
+    }
+
+    std::vector<const std::string*> uniqueRootLayerPaths(
+        rootLayerIndices.size());
+    for (const auto& pathAndIndex : rootLayerIndices) {
+        uniqueRootLayerPaths[pathAndIndex.second] = &pathAndIndex.first;
+    }
+
+    std::vector<SdfLayerRefPtr> rootLayers(uniqueRootLayerPaths.size());
+    WorkParallelForN(
+        uniqueRootLayerPaths.size(),
+        [&uniqueRootLayerPaths, &rootLayers](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                rootLayers[i] = SdfLayer::FindOrOpen(*uniqueRootLayerPaths[i]);
+            }
+        });
+
+    // Gather the unique stages that are not cached yet. The session layers
+    // are looked up on the main thread since they come from the Maya nodes.
+    const ArResolverContext resolverContext =
+        ArGetResolver().GetCurrentContext();
+    UsdStageCache& stageCache = UsdMayaStageCache::Get();
+
+    std::vector<_StageKey> keys;
+    std::set<std::pair<SdfLayer*, SdfLayer*>> visitedKeys;
+    size_t numCached = 0u;
+    for (size_t i = 0u; i < queuedNodes.size(); ++i) {
+        if (rootLayerPaths[i].empty()) {
+            continue;
+        }
+
+        const SdfLayerRefPtr& rootLayer =
+            rootLayers[rootLayerIndices[rootLayerPaths[i]]];
+        if (!rootLayer) {
+            continue;
+        }
+
+        SdfLayerRefPtr sessionLayer;
+        if (!queuedNodes[i].sessionLayerFn(
+                queuedNodes[i].node.object(), rootLayer, &sessionLayer)) {
+            continue;
+        }
+
+        if (!visitedKeys.insert(std::make_pair(
+                get_pointer(rootLayer), get_pointer(sessionLayer))).second) {
+            continue;
+        }
+
+        const UsdStageRefPtr cachedStage = sessionLayer ?
+            stageCache.FindOneMatching(
+                rootLayer, sessionLayer, resolverContext) :
+            stageCache.FindOneMatching(rootLayer, resolverContext);
+        if (cachedStage) {
+            ++numCached;
+            continue;
+        }
+
+        keys.push_back(_StageKey{rootLayer, sessionLayer});
+    }
+
+    // Open the stages in parallel. They are added to the cache afterwards,
+    // on the main thread.
+    std::vector<UsdStageRefPtr> stages(keys.size());
+    WorkParallelForN(
+        keys.size(),
+        [&keys, &stages, &resolverContext](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const _StageKey& key = keys[i];
+                if (key.sessionLayer) {
+                    stages[i] = UsdStage::Open(
+                        key.rootLayer,
+                        key.sessionLayer,
+                        resolverContext,
+                        UsdStage::LoadAll);
+                } else {
+                    stages[i] = UsdStage::Open(
+                        key.rootLayer,
+                        resolverContext,
+                        UsdStage::LoadAll);
+                }
+            }
+        });
+
+    size_t numOpened = 0u;
+    for (const UsdStageRefPtr& stage : stages) {
+        if (stage) {
+            stageCache.Insert(stage);
+            ++numOpened;
+        }
+    }
+
+    stopwatch.Stop();
+
+    TF_DEBUG(PXRUSDMAYA_STAGE_LOAD_QUEUE).Msg(
+            "UsdMaya_StageLoadQueue: opened %zu stages from %zu root layers "
+            "for %zu nodes in %.3f seconds (%zu already cached)\n",
+            numOpened,
+            rootLayers.size(),
+            queuedNodes.size(),
+            stopwatch.GetSeconds(),
+            numCached);
+}
+
+/* static */
+void
+UsdMaya_StageLoadQueue::InstallListener()
+{
+    if (_callbackIds.length() != 0u) {
+        return;
+    }
+
+    // Every node of the file has been created and has had its attributes set
+    // by the time these messages are sent, but the DG has not pulled on any
+    // of their stages yet.
+    for (const MSceneMessage::Message message : {
+            MSceneMessage::kAfterOpen,
+            MSceneMessage::kAfterImport,
+            MSceneMessage::kAfterReference,
+            MSceneMessage::kAfterLoadReference}) {
+        _callbackIds.append(
+            MSceneMessage::addCallback(message, _OnMayaFileReadCallback));
+    }
+}
+
+/* static */
+void
+UsdMaya_StageLoadQueue::RemoveListener()
+{
+    MMessage::removeCallbacks(_callbackIds);
+    _callbackIds.clear();
+    _queuedNodes.clear();
+}
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
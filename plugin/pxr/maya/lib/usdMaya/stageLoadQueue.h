@@ -0,0 +1,88 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_STAGE_LOAD_QUEUE_H
+#define PXRUSDMAYA_STAGE_LOAD_QUEUE_H
+
+/// \file usdMaya/stageLoadQueue.h
+
+#include "pxr/pxr.h"
+
+#include "pxr/usd/sdf/layer.h"
+
+#include <maya/MObject.h>
+
+#include <functional>
+#include <string>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/// Opens the stages of the proxy shapes and reference assemblies of a scene
+/// together, ahead of the DG evaluation that pulls them.
+///
+/// Nodes that are created while a file is being read add themselves to the
+/// queue. The queue is flushed on the main thread once the file has been
+/// opened, imported or referenced, from the scene message callbacks that
+/// InstallListener() adds. Reference assemblies also flush it from postLoad,
+/// since they activate their initial representations before those messages
+/// are sent. Flushing gathers the root layer and session layer of the stage of
+/// every queued node, then opens each unique stage that is not already in
+/// UsdMayaStageCache in parallel and adds it to the cache. The nodes then
+/// find their stages in the cache when they are evaluated.
+///
+/// Both node types open their stages with UsdStage::LoadAll and the current
+/// resolver context, so the two layers are enough to identify a stage.
+class UsdMaya_StageLoadQueue
+{
+public:
+    /// Returns the path of the root layer of the stage of \p node, or an
+    /// empty string if the node does not open a stage itself.
+    using RootLayerPathFn = std::function<std::string(const MObject& node)>;
+
+    /// Sets \p sessionLayer to the session layer that the stage of \p node
+    /// is opened with, given the \p rootLayer of the stage, or leaves it null
+    /// if the stage uses an anonymous session layer of its own. Returns false
+    /// if the stage of \p node cannot be shared with other nodes.
+    using SessionLayerFn = std::function<bool(
+            const MObject& node,
+            const SdfLayerRefPtr& rootLayer,
+            SdfLayerRefPtr* sessionLayer)>;
+
+    /// Adds \p node to the queue if a file is being read. The functions are
+    /// called on the main thread when the queue is flushed.
+    static void Enqueue(
+            const MObject& node,
+            const RootLayerPathFn& rootLayerPathFn,
+            const SessionLayerFn& sessionLayerFn);
+
+    /// Opens the stages of the queued nodes and empties the queue. This does
+    /// nothing if the queue is empty.
+    static void Flush();
+
+    /// Adds the scene message callbacks that flush the queue after a file
+    /// is opened, imported or referenced.
+    static void InstallListener();
+
+    /// Removes the callbacks added by InstallListener() and empties the
+    /// queue.
+    static void RemoveListener();
+};
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+
+#endif
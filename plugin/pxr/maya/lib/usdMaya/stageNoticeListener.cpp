@@ -35,6 +35,9 @@ UsdMayaStageNoticeListener::~UsdMayaStageNoticeListener()
     if (_stageContentsChangedKey.IsValid()) {
         TfNotice::Revoke(_stageContentsChangedKey);
     }
+    if (_stageObjectsChangedKey.IsValid()) {
+        TfNotice::Revoke(_stageObjectsChangedKey);
+    }
 }
 
 void
@@ -43,6 +46,7 @@ UsdMayaStageNoticeListener::SetStage(const UsdStageWeakPtr& stage)
     _stage = stage;
 
     _UpdateStageContentsChangedRegistration();
+    _UpdateStageObjectsChangedRegistration();
 }
 
 void
@@ -54,6 +58,15 @@ UsdMayaStageNoticeListener::SetStageContentsChangedCallback(
     _UpdateStageContentsChangedRegistration();
 }
 
+void
+UsdMayaStageNoticeListener::SetStageObjectsChangedCallback(
+        const StageObjectsChangedCallback& callback)
+{
+    _stageObjectsChangedCallback = callback;
+
+    _UpdateStageObjectsChangedRegistration();
+}
+
 void
 UsdMayaStageNoticeListener::_UpdateStageContentsChangedRegistration()
 {
@@ -83,5 +96,33 @@ UsdMayaStageNoticeListener::_OnStageContentsChanged(
     }
 }
 
+void
+UsdMayaStageNoticeListener::_UpdateStageObjectsChangedRegistration()
+{
+    // The registration is for a specific stage, so it is renewed whenever
+    // the stage changes.
+    if (_stageObjectsChangedKey.IsValid()) {
+        TfNotice::Revoke(_stageObjectsChangedKey);
+    }
+
+    if (_stage && _stageObjectsChangedCallback) {
+        _stageObjectsChangedKey =
+            TfNotice::Register(
+                TfCreateWeakPtr(this),
+                &UsdMayaStageNoticeListener::_OnStageObjectsChanged,
+                _stage);
+    }
+}
+
+void
+UsdMayaStageNoticeListener::_OnStageObjectsChanged(
+        const UsdNotice::ObjectsChanged& notice,
+        const UsdStageWeakPtr& sender) const
+{
+    if (sender == _stage && _stageObjectsChangedCallback) {
+        _stageObjectsChangedCallback(notice);
+    }
+}
+
 
-PXR_NAMESPACE_CLOSE_SCOPE
+PXR_NAMESPACE_CLOSE_SCOPE
\ No newline at end of file
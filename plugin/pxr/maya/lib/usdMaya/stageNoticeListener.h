@@ -63,6 +63,16 @@ class UsdMayaStageNoticeListener : public TfWeakBase
         void SetStageContentsChangedCallback(
                 const StageContentsChangedCallback& callback);
 
+        /// Callback type for ObjectsChanged notices.
+        typedef std::function<void (const UsdNotice::ObjectsChanged& notice)>
+            StageObjectsChangedCallback;
+
+        /// Sets the callback to be invoked when the listener receives an
+        /// ObjectsChanged notice.
+        PXRUSDMAYA_API
+        void SetStageObjectsChangedCallback(
+                const StageObjectsChangedCallback& callback);
+
     private:
         UsdMayaStageNoticeListener(const UsdMayaStageNoticeListener&);
         UsdMayaStageNoticeListener& operator=(
@@ -78,6 +88,16 @@ class UsdMayaStageNoticeListener : public TfWeakBase
         void _UpdateStageContentsChangedRegistration();
         void _OnStageContentsChanged(
                 const UsdNotice::StageContentsChanged& notice) const;
+
+        /// Handling for UsdNotice::ObjectsChanged.
+
+        TfNotice::Key _stageObjectsChangedKey;
+        StageObjectsChangedCallback _stageObjectsChangedCallback;
+
+        void _UpdateStageObjectsChangedRegistration();
+        void _OnStageObjectsChanged(
+                const UsdNotice::ObjectsChanged& notice,
+                const UsdStageWeakPtr& sender) const;
 };
 
 
@@ -0,0 +1,173 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "usdMaya/stagedValueWriter.h"
+
+#include "usdMaya/writeJobContext.h"
+
+#include "pxr/base/tf/diagnostic.h"
+#include "pxr/base/tf/type.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/layerOffset.h"
+
+#include <utility>
+
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+UsdMayaStagedValueWriter::UsdMayaStagedValueWriter(
+        UsdMayaWriteJobContext& jobCtx) :
+    _writeJobCtx(jobCtx)
+{
+}
+
+bool
+UsdMayaStagedValueWriter::SetAttribute(
+        const UsdAttribute& attr,
+        const VtValue& value,
+        const UsdTimeCode time)
+{
+    VtValue val(value);
+    return SetAttribute(attr, &val, time);
+}
+
+bool
+UsdMayaStagedValueWriter::SetAttribute(
+        const UsdAttribute& attr,
+        VtValue* value,
+        const UsdTimeCode time)
+{
+    if (!IsStagingValues(time)) {
+        return _valueWriter.SetAttribute(attr, value, time);
+    }
+
+    if (!attr) {
+        TF_CODING_ERROR("Invalid attribute '%s'", attr.GetPath().GetText());
+        return false;
+    }
+
+    // Register with the job context the first time we stage something for
+    // the current frame so that the write job knows which writers need
+    // merging.
+    if (_stagedValues.empty()) {
+        _writeJobCtx.mStagingValueWriters.push_back(this);
+    }
+
+    _stagedValues.push_back({attr, VtValue(), time});
+    _stagedValues.back().value.Swap(*value);
+    return true;
+}
+
+bool
+UsdMayaStagedValueWriter::IsStagingValues(const UsdTimeCode& time) const
+{
+    return !time.IsDefault() && _writeJobCtx.IsStagingValues();
+}
+
+UsdUtilsSparseValueWriter*
+UsdMayaStagedValueWriter::GetSparseValueWriter()
+{
+    return &_valueWriter;
+}
+
+void
+UsdMayaStagedValueWriter::_ResolveStagedValues(
+        const UsdEditTarget& editTarget)
+{
+    std::vector<_StagedValue> valuesToAuthor;
+    valuesToAuthor.reserve(_stagedValues.size());
+
+    for (_StagedValue& staged : _stagedValues) {
+        const auto insertResult = _stagedAttrStates.emplace(
+            staged.attr.GetPath(), _StagedAttrState());
+        _StagedAttrState& state = insertResult.first->second;
+        if (insertResult.second) {
+            // First time-sample for this attribute, so compare against its
+            // default value.
+            staged.attr.Get(&state.prevValue, UsdTimeCode::Default());
+            state.prevTime = UsdTimeCode::Default();
+            state.prevAuthored = true;
+        }
+
+        if (!state.prevValue.IsEmpty() && staged.value == state.prevValue) {
+            // Still in a run of identical values; hold on to the time so that
+            // the end of the run can be authored once the value changes.
+            state.prevTime = staged.time;
+            state.prevAuthored = false;
+            continue;
+        }
+
+        if (!state.prevAuthored) {
+            valuesToAuthor.push_back(
+                {staged.attr, state.prevValue, state.prevTime,
+                 SdfPath(), 0.0});
+        }
+
+        state.prevValue = staged.value;
+        state.prevTime = staged.time;
+        state.prevAuthored = true;
+        valuesToAuthor.push_back(std::move(staged));
+    }
+
+    // Do the work UsdAttribute::Set() would do before touching the layer
+    // here, so that only the layer edits are left for the main thread.
+    const SdfLayerHandle& layer = editTarget.GetLayer();
+    const SdfLayerOffset timeOffset =
+        editTarget.GetMapFunction().GetTimeOffset().GetInverse();
+    for (_StagedValue& staged : valuesToAuthor) {
+        const SdfPath specPath =
+            editTarget.MapToSpecPath(staged.attr.GetPath());
+        if (specPath.IsEmpty() || !layer->GetAttributeAtPath(specPath)) {
+            continue;
+        }
+
+        const TfType& type = staged.attr.GetTypeName().GetType();
+        if (staged.value.GetType() != type) {
+            VtValue cast = VtValue::CastToTypeid(
+                staged.value, type.GetTypeid());
+            if (cast.IsEmpty()) {
+                // Leave it to UsdAttribute::Set() to report the mismatch.
+                continue;
+            }
+            staged.value.Swap(cast);
+        }
+
+        staged.specPath = specPath;
+        staged.layerTime = timeOffset * staged.time.GetValue();
+    }
+
+    _stagedValues.swap(valuesToAuthor);
+}
+
+void
+UsdMayaStagedValueWriter::_AuthorStagedValues(
+        const UsdEditTarget& editTarget)
+{
+    const SdfLayerHandle& layer = editTarget.GetLayer();
+    for (const _StagedValue& staged : _stagedValues) {
+        if (staged.specPath.IsEmpty()) {
+            staged.attr.Set(staged.value, staged.time);
+        } else {
+            layer->SetTimeSample(
+                staged.specPath, staged.layerTime, staged.value);
+        }
+    }
+
+    _stagedValues.clear();
+}
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
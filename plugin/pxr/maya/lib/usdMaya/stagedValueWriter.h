@@ -0,0 +1,133 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_STAGED_VALUE_WRITER_H
+#define PXRUSDMAYA_STAGED_VALUE_WRITER_H
+
+/// \file usdMaya/stagedValueWriter.h
+
+#include "pxr/pxr.h"
+#include "usdMaya/api.h"
+
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/editTarget.h"
+#include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/usdUtils/sparseValueWriter.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+class UsdMayaWriteJobContext;
+
+
+/// Attribute value-writer used by prim writers. It avoids redundant authoring
+/// of default values and time-samples in the same way as
+/// UsdUtilsSparseValueWriter, which it uses to author values directly.
+///
+/// While the write job is exporting a frame with the parallelWrite export arg
+/// enabled, time-sampled values are staged in this writer instead. Once every
+/// prim writer has written the frame, the write job drops the redundant
+/// staged values of all staging writers in parallel and then authors the
+/// remaining ones.
+class UsdMayaStagedValueWriter
+{
+public:
+    PXRUSDMAYA_API
+    explicit UsdMayaStagedValueWriter(UsdMayaWriteJobContext& jobCtx);
+
+    /// Sets the value of \p attr to \p value at \p time with value
+    /// compression, or stages it if time-samples are being staged.
+    PXRUSDMAYA_API
+    bool SetAttribute(
+            const UsdAttribute& attr,
+            const VtValue& value,
+            const UsdTimeCode time = UsdTimeCode::Default());
+
+    /// \overload
+    /// The value held by \p value is swapped out, leaving it empty.
+    PXRUSDMAYA_API
+    bool SetAttribute(
+            const UsdAttribute& attr,
+            VtValue* value,
+            const UsdTimeCode time = UsdTimeCode::Default());
+
+    /// Whether a value set at \p time is staged instead of being authored
+    /// directly on the stage. This is only the case for time-sampled values
+    /// while the write job is exporting frames with the parallelWrite export
+    /// arg enabled.
+    PXRUSDMAYA_API
+    bool IsStagingValues(const UsdTimeCode& time) const;
+
+    /// Get the UsdUtilsSparseValueWriter used to author values directly.
+    /// Values written through it are never staged.
+    PXRUSDMAYA_API
+    UsdUtilsSparseValueWriter* GetSparseValueWriter();
+
+private:
+    friend class UsdMaya_WriteJob;
+
+    /// Drops the staged values that would be redundant with what has
+    /// already been authored for their attributes, and resolves where in
+    /// the edit target layer each remaining value goes, casting it to the
+    /// attribute's type. This only touches state owned by this writer and
+    /// reads from the stage, so it may run concurrently for different
+    /// writers as long as nothing is authoring to the stage.
+    void _ResolveStagedValues(const UsdEditTarget& editTarget);
+
+    /// Authors the values kept by _ResolveStagedValues() into the edit
+    /// target layer and clears the staging buffer. Layers cannot be edited
+    /// from several threads at once, so this must be called from the main
+    /// thread.
+    void _AuthorStagedValues(const UsdEditTarget& editTarget);
+
+    UsdMayaWriteJobContext& _writeJobCtx;
+
+    UsdUtilsSparseValueWriter _valueWriter;
+
+    struct _StagedValue {
+        UsdAttribute attr;
+        VtValue value;
+        UsdTimeCode time;
+
+        /// Filled in by _ResolveStagedValues(). An empty spec path means
+        /// the value has to be authored through the attribute instead.
+        SdfPath specPath;
+        double layerTime;
+    };
+
+    /// The last value seen for a staged attribute, and whether that value
+    /// has actually been authored at its time.
+    struct _StagedAttrState {
+        VtValue prevValue;
+        UsdTimeCode prevTime;
+        bool prevAuthored;
+    };
+
+    std::vector<_StagedValue> _stagedValues;
+    std::unordered_map<SdfPath, _StagedAttrState, SdfPath::Hash>
+            _stagedAttrStates;
+};
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+
+#endif
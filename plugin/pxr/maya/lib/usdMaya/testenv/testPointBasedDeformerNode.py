@@ -16,9 +16,13 @@
 #
 
 import os
+import time
 import unittest
 
 from pxr import Gf
+from pxr import Usd
+from pxr import UsdGeom
+from pxr import Vt
 
 from maya import OpenMaya as OM
 from maya import OpenMayaAnim as OMA
@@ -108,6 +112,95 @@ class testPointBasedDeformerNode(unittest.TestCase):
         self._ValidateControlPoint(testCube, 2, Gf.Vec3d(-1.0, 0.0, 1.0))
         self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.0, 1.0, 1.0))
 
+    def testDeformDensePlane(self):
+        """
+        Tests that a dense plane, with enough points to be deformed in
+        parallel, is deformed correctly by a point based deformer node, and
+        reports how many points per second it deforms.
+        """
+        subdivisions = 200
+        numFrames = 24
+
+        # Create a plane and a USD mesh with the same points, moved up by the
+        # frame number.
+        plane = cmds.polyPlane(width=1.0, height=1.0,
+            subdivisionsX=subdivisions, subdivisionsY=subdivisions)[0]
+        numPoints = cmds.polyEvaluate(plane, vertex=True)
+        restPoints = cmds.xform('%s.vtx[*]' % plane, query=True,
+            translation=True, objectSpace=True)
+
+        usdFilePath = os.path.abspath('DenseMesh.usda')
+        stage = Usd.Stage.CreateNew(usdFilePath)
+        mesh = UsdGeom.Mesh.Define(stage, '/DenseMesh')
+        pointsAttr = mesh.CreatePointsAttr()
+        for frame in range(1, numFrames + 1):
+            pointsAttr.Set(Vt.Vec3fArray([
+                Gf.Vec3f(restPoints[3 * i], restPoints[3 * i + 1] + frame,
+                    restPoints[3 * i + 2])
+                for i in range(numPoints)]), frame)
+        stage.GetRootLayer().Save()
+
+        stageNode = cmds.createNode('pxrUsdStageNode')
+        cmds.setAttr('%s.filePath' % stageNode, usdFilePath, type='string')
+
+        cmds.select(plane, replace=True)
+        deformerNode = cmds.deformer(type='pxrUsdPointBasedDeformerNode')[0]
+        cmds.setAttr('%s.primPath' % deformerNode, '/DenseMesh',
+            type='string')
+        cmds.connectAttr('%s.outUsdStage' % stageNode,
+            '%s.inUsdStage' % deformerNode)
+        cmds.connectAttr('time1.outTime', '%s.time' % deformerNode)
+
+        # Only evaluate the deformer while timing it, and check the deformed
+        # positions afterwards.
+        start = time.time()
+        for frame in range(1, numFrames + 1):
+            cmds.currentTime(frame)
+            cmds.getAttr('%s.controlPoints[0]' % plane)
+        elapsed = time.time() - start
+
+        print('Deformed %d points over %d frames in %f seconds '
+            '(%.0f points per second)' % (numPoints, numFrames, elapsed,
+                numPoints * numFrames / max(elapsed, 1e-9)))
+
+        lastIndex = numPoints - 1
+        for frame in range(1, numFrames + 1):
+            cmds.currentTime(frame)
+            self._ValidateControlPoint(plane, 0, Gf.Vec3d(restPoints[0],
+                restPoints[1] + frame, restPoints[2]))
+            self._ValidateControlPoint(plane, lastIndex, Gf.Vec3d(
+                restPoints[3 * lastIndex],
+                restPoints[3 * lastIndex + 1] + frame,
+                restPoints[3 * lastIndex + 2]))
+
+    def testImportAboveAnimationCacheThreshold(self):
+        """
+        Tests that importing with animationCacheThreshold streams the points of
+        meshes with more point samples than the threshold through a point
+        based deformer node, and bakes the others into blend shapes.
+        """
+        # The cube has 8 points and 24 time samples.
+        cmds.usdImport(file=self._deformingCubeUsdFilePath,
+            readAnimData=True, shadingMode='none',
+            animationCacheThreshold=100)
+        self.assertEqual(
+            len(cmds.ls(type='pxrUsdPointBasedDeformerNode')), 1)
+        self.assertEqual(len(cmds.ls(type='pxrUsdStageNode')), 1)
+        self.assertFalse(cmds.ls(type='blendShape'))
+
+        cmds.currentTime(self.MID_TIMECODE)
+        self._ValidateControlPoint('CubeShape', 0, Gf.Vec3d(0.0, -1.0, 1.0))
+
+        cmds.file(new=True, force=True)
+        cmds.usdImport(file=self._deformingCubeUsdFilePath,
+            readAnimData=True, shadingMode='none',
+            animationCacheThreshold=1000)
+        self.assertFalse(cmds.ls(type='pxrUsdPointBasedDeformerNode'))
+        self.assertEqual(len(cmds.ls(type='blendShape')), 1)
+
+        # The stage node is only created for the meshes that are streamed.
+        self.assertFalse(cmds.ls(type='pxrUsdStageNode'))
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -132,6 +132,41 @@ class testUsdExportAsClip(unittest.TestCase):
         # animated points:
         self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube1', 'points', (0, 21))
 
+    def testExportStreamingClips(self):
+        """
+        Test that exporting with a clip chunk size streams the time-samples
+        into value clips that resolve the same way as a regular export.
+        """
+        canonicalUsdFile = os.path.abspath('canonical_streaming.usda')
+        cmds.usdExport(mergeTransformAndShape=True, file=canonicalUsdFile,
+            frameRange=(1, 20))
+
+        usdFile = os.path.abspath('UsdExportAsClip_streaming.usda')
+        cmds.usdExport(mergeTransformAndShape=True, file=usdFile,
+            frameRange=(1, 20), clipChunkSize=5)
+
+        # 20 frames in chunks of 5 frames.
+        for i in xrange(4):
+            clipFile = os.path.abspath(
+                'UsdExportAsClip_streaming.clip%04d.usdc' % i)
+            self.assertTrue(os.path.exists(clipFile), clipFile)
+        self.assertTrue(os.path.exists(
+            os.path.abspath('UsdExportAsClip_streaming.manifest.usdc')))
+
+        # The exported layer itself should not hold any time-samples.
+        layer = Sdf.Layer.FindOrOpen(usdFile)
+        attrPath = Sdf.Path('/world/pCube1.points')
+        self.assertEqual(layer.GetNumTimeSamplesForPath(attrPath), 0)
+
+        canonicalStage = Usd.Stage.Open(canonicalUsdFile)
+        clipsStage = Usd.Stage.Open(usdFile)
+        self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube1', 'visibility', (0, 21))
+        self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube2', 'visibility', (0, 21))
+        self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube4', 'visibility', (0, 21))
+        self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube2', 'points', (0, 21))
+        self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube3', 'points', (0, 21))
+        self._ValidateSamples(canonicalStage, clipsStage, '/world/pCube1', 'points', (0, 21))
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -134,6 +134,82 @@ class testUsdExportMesh(unittest.TestCase):
             # make sure the other 2 values aren't both 0.
             self.assertNotAlmostEqual(abs(n[0]) + abs(n[2]), 0.0, delta=1e-4)
 
+    def testExportTopologyChanges(self):
+        """
+        Tests that an animated mesh whose topology only changes partway
+        through the frame range gets its new topology exported.
+        """
+        cmds.file(new=True, force=True)
+        cmds.polyPlane(name='topologyPlane', subdivisionsX=1,
+            subdivisionsY=1, constructionHistory=True)
+        cmds.setKeyframe('polyPlane1', attribute='subdivisionsWidth',
+            time=1, value=1, outTangentType='step')
+        cmds.setKeyframe('polyPlane1', attribute='subdivisionsWidth',
+            time=3, value=2, outTangentType='step')
+
+        usdFile = os.path.abspath('UsdExportMesh_topologyChanges.usda')
+        cmds.usdExport(mergeTransformAndShape=True, file=usdFile,
+            shadingMode='none', exportDisplayColor=True, frameRange=(1, 4))
+
+        stage = Usd.Stage.Open(usdFile)
+        m = UsdGeom.Mesh.Get(stage, '/topologyPlane')
+        self.assertTrue(m)
+
+        # The shader-derived display color is written on the samples where
+        # the topology is unchanged.
+        displayColor = m.GetDisplayColorPrimvar()
+        self.assertTrue(displayColor.HasAuthoredValue())
+        self.assertEqual(len(displayColor.Get(2)), 1)
+
+        self.assertEqual(len(m.GetFaceVertexCountsAttr().Get(1)), 1)
+        self.assertEqual(len(m.GetFaceVertexCountsAttr().Get(2)), 1)
+        self.assertEqual(len(m.GetFaceVertexCountsAttr().Get(3)), 2)
+        self.assertEqual(len(m.GetFaceVertexCountsAttr().Get(4)), 2)
+        self.assertEqual(len(m.GetPointsAttr().Get(1)), 4)
+        self.assertEqual(len(m.GetPointsAttr().Get(4)), 6)
+        self.assertEqual(len(m.GetFaceVertexIndicesAttr().Get(4)), 8)
+
+        cmds.file(os.path.abspath('UsdExportMeshTest.ma'), open=True,
+            force=True)
+
+    def testExportAnimatedUVsWithUnchangedTopology(self):
+        """
+        Tests that the UVs of an animated mesh are exported on every sample
+        when they change but the topology does not, so that the held UVs are
+        not interpolated towards the next change.
+        """
+        cmds.file(new=True, force=True)
+        cmds.polyPlane(name='uvPlane', subdivisionsX=1, subdivisionsY=1,
+            constructionHistory=True)
+        moveUV = cmds.polyMoveUV('uvPlane.map[*]', translateU=0.0)[0]
+        cmds.setKeyframe(moveUV, attribute='translateU', time=1, value=0.0,
+            outTangentType='step')
+        cmds.setKeyframe(moveUV, attribute='translateU', time=3, value=1.0,
+            outTangentType='step')
+
+        usdFile = os.path.abspath('UsdExportMesh_animatedUVs.usda')
+        cmds.usdExport(mergeTransformAndShape=True, file=usdFile,
+            shadingMode='none', frameRange=(1, 3))
+
+        stage = Usd.Stage.Open(usdFile)
+        m = UsdGeom.Mesh.Get(stage, '/uvPlane')
+        self.assertTrue(m)
+        st = m.GetPrimvar('st')
+        self.assertTrue(st)
+
+        self.assertEqual(len(m.GetFaceVertexCountsAttr().Get(1)), 1)
+        self.assertEqual(len(m.GetFaceVertexCountsAttr().Get(3)), 1)
+
+        stFrame1 = st.ComputeFlattened(1)
+        stFrame2 = st.ComputeFlattened(2)
+        stFrame3 = st.ComputeFlattened(3)
+        for uvFrame1, uvFrame2, uvFrame3 in zip(stFrame1, stFrame2, stFrame3):
+            self.assertAlmostEqual(uvFrame1[0], uvFrame2[0], places=5)
+            self.assertAlmostEqual(uvFrame1[0] + 1.0, uvFrame3[0], places=5)
+
+        cmds.file(os.path.abspath('UsdExportMeshTest.ma'), open=True,
+            force=True)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -0,0 +1,159 @@
+#!/pxrpythonsubst
+#
+# Copyright 2018 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import json
+import os
+import time
+import unittest
+
+from pxr import Usd
+
+from maya import cmds
+from maya import standalone
+
+
+class testUsdExportParallelWrite(unittest.TestCase):
+
+    START_TIME = 1
+    END_TIME = 24
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+
+        cmds.file(new=True, force=True)
+        for i in xrange(20):
+            sphere = cmds.polySphere(name='Sphere%d' % i,
+                subdivisionsX=40, subdivisionsY=40)[0]
+
+            # Hold the translation for a few frames before it starts moving
+            # so that sparse value writing has a run of identical samples to
+            # collapse.
+            cmds.setKeyframe(sphere, attribute='translateX',
+                time=cls.START_TIME, value=0.0)
+            cmds.setKeyframe(sphere, attribute='translateX',
+                time=6, value=0.0)
+            cmds.setKeyframe(sphere, attribute='translateX',
+                time=cls.END_TIME, value=float(i))
+            cmds.setKeyframe(sphere, attribute='visibility',
+                time=cls.START_TIME, value=1)
+            cmds.setKeyframe(sphere, attribute='visibility',
+                time=12, value=0)
+
+            # A user-exported attribute is written through the write
+            # utilities rather than through the prim writer itself, so it
+            # exercises staging from outside of _SetAttribute().
+            cmds.addAttr(sphere, longName='wobble', attributeType='double')
+            cmds.setKeyframe(sphere, attribute='wobble',
+                time=cls.START_TIME, value=0.0)
+            cmds.setKeyframe(sphere, attribute='wobble',
+                time=cls.END_TIME, value=1.0)
+            cmds.addAttr(sphere, longName='USD_UserExportedAttributesJson',
+                dataType='string')
+            cmds.setAttr('%s.USD_UserExportedAttributesJson' % sphere,
+                json.dumps({'wobble': {}}), type='string')
+
+            wave, _ = cmds.nonLinear(sphere, type='wave')
+            cmds.setKeyframe(wave, attribute='offset',
+                time=cls.START_TIME, value=0.0)
+            cmds.setKeyframe(wave, attribute='offset',
+                time=cls.END_TIME, value=2.0)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _Export(self, fileName, parallelWrite):
+        usdFilePath = os.path.abspath(fileName)
+
+        startTime = time.time()
+        cmds.usdExport(
+            file=usdFilePath,
+            frameRange=(self.START_TIME, self.END_TIME),
+            parallelWrite=parallelWrite,
+            shadingMode='none')
+        elapsed = time.time() - startTime
+
+        numFrames = self.END_TIME - self.START_TIME + 1
+        print('%s: %d frames in %f seconds (%f frames per second)' % (
+            'parallelWrite' if parallelWrite else 'serial',
+            numFrames, elapsed, numFrames / elapsed))
+
+        return Usd.Stage.Open(usdFilePath)
+
+    def testParallelWriteMatchesSerialWrite(self):
+        """
+        Tests that staging and merging time-samples per frame authors exactly
+        the same samples as the serial export, and reports the frame rate of
+        both so that they can be compared.
+        """
+        serialStage = self._Export('ParallelWrite_serial.usda', False)
+        parallelStage = self._Export('ParallelWrite_parallel.usda', True)
+
+        numAnimatedAttrs = 0
+        for serialPrim in serialStage.Traverse():
+            parallelPrim = parallelStage.GetPrimAtPath(serialPrim.GetPath())
+            self.assertTrue(parallelPrim)
+
+            for serialAttr in serialPrim.GetAttributes():
+                parallelAttr = parallelPrim.GetAttribute(serialAttr.GetName())
+                self.assertTrue(parallelAttr)
+
+                timeSamples = serialAttr.GetTimeSamples()
+                self.assertEqual(timeSamples, parallelAttr.GetTimeSamples(),
+                    serialAttr.GetPath())
+                self.assertEqual(serialAttr.Get(), parallelAttr.Get())
+                for t in timeSamples:
+                    self.assertEqual(serialAttr.Get(t), parallelAttr.Get(t))
+
+                if timeSamples:
+                    numAnimatedAttrs += 1
+
+        # Points, extent, translation and visibility are all animated.
+        self.assertGreater(numAnimatedAttrs, 0)
+
+    def testParallelWriteStagesTransformAndUserAttributes(self):
+        """
+        Tests that the transform ops and user-exported attributes, which are
+        authored through the value writer rather than through _SetAttribute(),
+        get their redundant samples dropped when they are staged.
+        """
+        stage = self._Export('ParallelWrite_staged.usda', True)
+
+        prim = stage.GetPrimAtPath('/Sphere5')
+        self.assertTrue(prim)
+
+        # translateX holds at 0.0 from frame 1 to 6, so only the end of that
+        # run is kept before the value starts changing.
+        translateAttr = prim.GetAttribute('xformOp:translate')
+        self.assertTrue(translateAttr)
+        timeSamples = translateAttr.GetTimeSamples()
+        self.assertEqual(timeSamples[:2], [1.0, 6.0])
+        self.assertEqual(timeSamples[-1], self.END_TIME)
+        self.assertEqual(translateAttr.Get(self.END_TIME), (5.0, 0.0, 0.0))
+
+        wobbleAttr = prim.GetAttribute('userProperties:wobble')
+        self.assertTrue(wobbleAttr)
+        self.assertEqual(len(wobbleAttr.GetTimeSamples()),
+            self.END_TIME - self.START_TIME + 1)
+        self.assertAlmostEqual(wobbleAttr.Get(self.START_TIME), 0.0)
+        self.assertAlmostEqual(wobbleAttr.Get(self.END_TIME), 1.0)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,110 @@
+#!/pxrpythonsubst
+#
+# Copyright 2018 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import json
+import os
+import unittest
+
+from maya import cmds
+from maya import standalone
+
+
+class testUsdExportProfileReport(unittest.TestCase):
+
+    START_TIME = 1
+    END_TIME = 10
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+
+        cmds.file(new=True, force=True)
+        cube = cmds.polyCube(name='Cube')[0]
+        cmds.setKeyframe(cube, attribute='translateX',
+            time=cls.START_TIME, value=0.0)
+        cmds.setKeyframe(cube, attribute='translateX',
+            time=cls.END_TIME, value=10.0)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _ReadReport(self, reportFilePath):
+        self.assertTrue(os.path.isfile(reportFilePath))
+        with open(reportFilePath) as reportFile:
+            return json.load(reportFile)
+
+    def testProfileReport(self):
+        """
+        Tests that exporting with profileReport writes a JSON report next to
+        the USD file with per-phase, per-writer-type and per-frame entries.
+        """
+        usdFilePath = os.path.abspath('ProfileReport.usda')
+        reportFilePath = os.path.abspath('ProfileReport.report.json')
+
+        cmds.usdExport(
+            file=usdFilePath,
+            frameRange=(self.START_TIME, self.END_TIME),
+            profileReport=True,
+            shadingMode='none')
+
+        report = self._ReadReport(reportFilePath)
+        self.assertEqual(report['version'], 1)
+        self.assertGreater(report['totalSeconds'], 0.0)
+
+        phases = {phase['name']: phase for phase in report['phases']}
+        for phaseName in ('begin', 'begin/dagTraversal', 'frame',
+                'frame/writePrims', 'viewFrame', 'finish', 'finish/save'):
+            self.assertIn(phaseName, phases)
+        self.assertEqual(phases['begin/dagTraversal']['parent'], 'begin')
+
+        numFrames = self.END_TIME - self.START_TIME + 1
+        self.assertEqual(phases['frame']['calls'], numFrames)
+
+        frames = report['frames']
+        self.assertEqual([frame['time'] for frame in frames],
+            [float(t) for t in range(self.START_TIME, self.END_TIME + 1)])
+
+        # There is a single prim writer of each type for the cube, which writes
+        # the default time plus every frame.
+        writerTypes = report['writerTypes']
+        self.assertTrue(writerTypes)
+        for writerType in writerTypes:
+            self.assertEqual(writerType['defaultCalls'], 1)
+            self.assertEqual(writerType['frameCalls'], numFrames)
+            for frame in frames:
+                self.assertIn(writerType['type'], frame['writerSeconds'])
+
+    def testNoProfileReport(self):
+        """
+        Tests that no report is written unless profileReport is enabled.
+        """
+        usdFilePath = os.path.abspath('NoProfileReport.usda')
+        reportFilePath = os.path.abspath('NoProfileReport.report.json')
+
+        cmds.usdExport(
+            file=usdFilePath,
+            frameRange=(self.START_TIME, self.END_TIME),
+            shadingMode='none')
+
+        self.assertTrue(os.path.isfile(usdFilePath))
+        self.assertFalse(os.path.isfile(reportFilePath))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
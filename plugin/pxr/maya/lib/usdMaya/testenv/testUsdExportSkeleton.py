@@ -15,6 +15,7 @@
 # limitations under the License.
 #
 import os
+import time
 import unittest
 
 from maya import cmds
@@ -165,6 +166,85 @@ class testUsdExportSkeleton(unittest.TestCase):
             cmds.usdExport(mergeTransformAndShape=True, file=usdFile,
                            shadingMode='none', exportSkels='auto')
 
+    def testSkinWeightsSyntheticCluster(self):
+        """
+        Tests the compressed skin weights of a dense mesh bound to a long
+        joint chain against the weights of the source skinCluster, and reports
+        how long the export takes.
+        """
+        cmds.file(new=True, force=True)
+
+        root = cmds.group(empty=True, name='SkinWeightsRoot')
+        cmds.select(clear=True)
+        joints = []
+        for i in xrange(50):
+            joints.append(cmds.joint(position=(0.0, 0.0, i * 0.5)))
+        cmds.parent(joints[0], root)
+
+        plane = cmds.polyPlane(name='SkinWeightsMesh', width=1, height=25,
+            subdivisionsX=100, subdivisionsY=2500,
+            constructionHistory=False)[0]
+        cmds.rotate(90, 0, 0, plane)
+        cmds.move(0, 0, 12.5, plane)
+        cmds.makeIdentity(plane, apply=True)
+        cmds.parent(plane, root)
+        skinCluster = cmds.skinCluster(joints[0], plane,
+            maximumInfluences=4, toSelectedBones=False)[0]
+        influences = cmds.skinCluster(skinCluster, query=True, influence=True)
+
+        usdFile = os.path.abspath('UsdExportSkinWeightsSyntheticCluster.usda')
+        startTime = time.time()
+        cmds.usdExport(mergeTransformAndShape=True, file=usdFile,
+                       shadingMode='none', exportSkin='auto',
+                       exportSkels='auto')
+        print('Exported skinned mesh in %f seconds' % (
+            time.time() - startTime))
+
+        stage = Usd.Stage.Open(usdFile)
+        mesh = stage.GetPrimAtPath('/SkinWeightsRoot/SkinWeightsMesh')
+        binding = UsdSkel.BindingAPI(mesh)
+
+        indicesPrimvar = binding.GetJointIndicesPrimvar()
+        weightsPrimvar = binding.GetJointWeightsPrimvar()
+        numSlots = indicesPrimvar.GetElementSize()
+        self.assertEqual(numSlots, weightsPrimvar.GetElementSize())
+        self.assertGreater(numSlots, 0)
+        self.assertLessEqual(numSlots, 4)
+
+        indices = indicesPrimvar.Get()
+        weights = weightsPrimvar.Get()
+        numVertices = len(UsdGeom.Mesh(mesh).GetPointsAttr().Get())
+        self.assertEqual(len(indices), numVertices * numSlots)
+        self.assertEqual(len(weights), numVertices * numSlots)
+
+        # The joint indices refer to the joints of the mesh's binding, which
+        # are in the order of the skinCluster influences.
+        jointNames = [joint.split('/')[-1]
+            for joint in binding.GetJointsAttr().Get()]
+        self.assertEqual(jointNames, influences)
+
+        for vert in xrange(0, numVertices, 997):
+            vertIndices = indices[vert * numSlots:(vert + 1) * numSlots]
+            vertWeights = weights[vert * numSlots:(vert + 1) * numSlots]
+            self.assertAlmostEqual(sum(vertWeights), 1.0, places=4)
+
+            # Influences are sorted by decreasing weight.
+            self.assertEqual(list(vertWeights),
+                sorted(vertWeights, reverse=True))
+
+            # The skinCluster limits each vertex to four influences, so all of
+            # its non-zero influences are kept, with the same weights.
+            mayaWeights = cmds.skinPercent(skinCluster,
+                '%s.vtx[%d]' % (plane, vert), query=True, value=True)
+            expected = dict((influences[i], w)
+                for i, w in enumerate(mayaWeights) if w > 1e-8)
+            kept = dict((jointNames[i], w)
+                for i, w in zip(vertIndices, vertWeights) if w > 0.0)
+            self.assertLessEqual(len(expected), numSlots)
+            self.assertEqual(sorted(kept.keys()), sorted(expected.keys()))
+            for jointName, weight in expected.items():
+                self.assertAlmostEqual(kept[jointName], weight, places=5)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
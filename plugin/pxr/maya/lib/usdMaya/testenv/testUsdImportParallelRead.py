@@ -0,0 +1,115 @@
+#!/pxrpythonsubst
+#
+# Copyright 2018 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from pxr import Gf
+from pxr import Usd
+from pxr import UsdGeom
+
+from maya import cmds
+from maya import standalone
+
+import os
+import sys
+import time
+import unittest
+
+
+class testUsdImportParallelRead(unittest.TestCase):
+
+    # More meshes than fit in a single prefetch window.
+    NUM_MESHES = 300
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+
+        cls.usdFilePath = os.path.abspath('ParallelRead.usda')
+        stage = Usd.Stage.CreateNew(cls.usdFilePath)
+        UsdGeom.Xform.Define(stage, '/Root')
+        for i in range(cls.NUM_MESHES):
+            mesh = UsdGeom.Mesh.Define(stage, '/Root/Mesh%d' % i)
+            mesh.CreateFaceVertexCountsAttr([4, 3])
+            mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 3, 0, 3, 4])
+            mesh.CreatePointsAttr([Gf.Vec3f(i, 0, 0), Gf.Vec3f(i + 1, 0, 0),
+                Gf.Vec3f(i + 1, 1, 0), Gf.Vec3f(i, 1, 0),
+                Gf.Vec3f(i, 0.5, 1)])
+            mesh.CreateNormalsAttr([Gf.Vec3f(0, 0, 1)] * 4 +
+                [Gf.Vec3f(-1, 0, 0)] * 3)
+            mesh.SetNormalsInterpolation(UsdGeom.Tokens.faceVarying)
+            mesh.CreateSubdivisionSchemeAttr(UsdGeom.Tokens.none)
+
+        # A mesh with invalid topology, which is skipped in both modes.
+        mesh = UsdGeom.Mesh.Define(stage, '/Root/InvalidMesh')
+        mesh.CreateFaceVertexCountsAttr([4])
+        mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 7])
+        mesh.CreatePointsAttr([Gf.Vec3f(0, 0, 0)] * 4)
+        stage.GetRootLayer().Save()
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _Import(self, parallelRead):
+        """
+        Imports the test file, and returns how long the import took.
+        """
+        cmds.file(new=True, force=True)
+        start = time.time()
+        cmds.usdImport(file=self.usdFilePath, shadingMode='none',
+            parallelRead=parallelRead)
+        return time.time() - start
+
+    def _GetMeshData(self):
+        data = {}
+        for i in range(self.NUM_MESHES):
+            mesh = 'Mesh%dShape' % i
+            data[mesh] = (
+                cmds.polyEvaluate(mesh, vertex=True, face=True),
+                cmds.xform('%s.vtx[*]' % mesh, query=True, translation=True,
+                    objectSpace=True),
+                cmds.polyNormalPerVertex('%s.vtxFace[*][*]' % mesh,
+                    query=True, xyz=True),
+                cmds.attributeQuery('USD_EmitNormals', node=mesh,
+                    exists=True))
+        return data
+
+    def testParallelReadMatchesSerialRead(self):
+        """
+        Tests that importing with parallelRead creates the same meshes as the
+        serial import.
+        """
+        serialTime = self._Import(parallelRead=False)
+        serialData = self._GetMeshData()
+        self.assertFalse(cmds.objExists('InvalidMeshShape'))
+
+        parallelTime = self._Import(parallelRead=True)
+        parallelData = self._GetMeshData()
+        self.assertFalse(cmds.objExists('InvalidMeshShape'))
+
+        # The timings are only reported, since they depend on the machine.
+        sys.stdout.write('Imported %d meshes in %.3f seconds serially, and '
+            '%.3f seconds with parallelRead\n' % (
+                self.NUM_MESHES, serialTime, parallelTime))
+
+        self.assertEqual(len(parallelData), self.NUM_MESHES)
+        for mesh, data in serialData.items():
+            self.assertEqual(parallelData[mesh], data)
+            self.assertTrue(data[3])
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,143 @@
+#!/pxrpythonsubst
+#
+# Copyright 2018 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import math
+import os
+import time
+import unittest
+
+from pxr import UsdGeom
+from pxr import UsdMaya
+from pxr import Vt
+
+from maya import cmds
+from maya import standalone
+from maya.api import OpenMaya
+
+
+class testUsdMayaPrimvarIndices(unittest.TestCase):
+    """
+    Checks MergeEquivalentIndexedValues() and
+    CompressFaceVaryingPrimvarIndices() on synthetic face-varying data at
+    sizes on both sides of the threshold at which they switch to running in
+    parallel.
+
+    Setting PXRUSDMAYA_PRIMVAR_INDICES_BENCHMARK runs the benchmark, which
+    reports how long they take on up to 1e7 elements.
+    """
+
+    SIZES = [10000, 200000]
+
+    BENCHMARK_SIZES = [10000, 100000, 1000000, 10000000]
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _MergeEquivalentIndexedValues(self, numElements):
+        # Every value is repeated four times, and the face-varying indices
+        # reference each value once.
+        numUnique = numElements / 4
+        values = Vt.FloatArray(
+            [float(i % numUnique) for i in xrange(numElements)])
+        indices = Vt.IntArray(range(numElements))
+
+        startTime = time.time()
+        mergedValues, mergedIndices = \
+            UsdMaya.MeshUtil.MergeEquivalentIndexedValues(values, indices)
+        elapsed = time.time() - startTime
+
+        self.assertEqual(len(mergedValues), numUnique)
+        self.assertEqual(len(mergedIndices), numElements)
+
+        # Unique values are numbered in the order in which they are first
+        # referenced.
+        for i in [0, 1, numUnique - 1, numUnique, numElements - 1]:
+            self.assertEqual(mergedIndices[i], i % numUnique)
+            self.assertEqual(mergedValues[mergedIndices[i]], values[i])
+
+        return elapsed
+
+    def _CompressFaceVaryingPrimvarIndices(self, numElements):
+        cmds.file(new=True, force=True)
+
+        # Each quad has four face-vertices.
+        subdivisions = int(math.sqrt(numElements / 4))
+        meshName = cmds.polyPlane(subdivisionsX=subdivisions,
+            subdivisionsY=subdivisions, constructionHistory=False)[0]
+
+        selection = OpenMaya.MSelectionList()
+        selection.add(meshName)
+        meshFn = OpenMaya.MFnMesh(selection.getDagPath(0))
+        _, faceVertexIndices = meshFn.getVertices()
+
+        # Indexing each face-vertex by its vertex can be compressed to vertex
+        # interpolation.
+        indices = Vt.IntArray(list(faceVertexIndices))
+        startTime = time.time()
+        interpolation, compressedIndices = \
+            UsdMaya.MeshUtil.CompressFaceVaryingPrimvarIndices(
+                meshName, indices)
+        elapsed = time.time() - startTime
+
+        self.assertEqual(interpolation, UsdGeom.Tokens.vertex)
+        self.assertEqual(len(compressedIndices), meshFn.numVertices)
+        for i in [0, 1, meshFn.numVertices - 1]:
+            self.assertEqual(compressedIndices[i], i)
+
+        # Indexing each face-vertex by its face can be compressed to uniform
+        # interpolation.
+        faceIndices = []
+        for face in xrange(meshFn.numPolygons):
+            faceIndices.extend([face] * 4)
+        interpolation, compressedIndices = \
+            UsdMaya.MeshUtil.CompressFaceVaryingPrimvarIndices(
+                meshName, Vt.IntArray(faceIndices))
+        self.assertEqual(interpolation, UsdGeom.Tokens.uniform)
+        self.assertEqual(len(compressedIndices), meshFn.numPolygons)
+
+        return elapsed
+
+    def testMergeEquivalentIndexedValues(self):
+        for numElements in self.SIZES:
+            self._MergeEquivalentIndexedValues(numElements)
+
+    def testCompressFaceVaryingPrimvarIndices(self):
+        for numElements in self.SIZES:
+            self._CompressFaceVaryingPrimvarIndices(numElements)
+
+    @unittest.skipUnless(
+        os.environ.get('PXRUSDMAYA_PRIMVAR_INDICES_BENCHMARK'),
+        'PXRUSDMAYA_PRIMVAR_INDICES_BENCHMARK is not set')
+    def testBenchmark(self):
+        for numElements in self.BENCHMARK_SIZES:
+            elapsed = self._MergeEquivalentIndexedValues(numElements)
+            print('MergeEquivalentIndexedValues: %d elements in %f seconds' % (
+                numElements, elapsed))
+
+            elapsed = self._CompressFaceVaryingPrimvarIndices(numElements)
+            print('CompressFaceVaryingPrimvarIndices: %d elements in %f '
+                'seconds' % (numElements, elapsed))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
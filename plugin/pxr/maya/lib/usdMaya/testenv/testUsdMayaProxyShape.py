@@ -15,7 +15,9 @@
 # limitations under the License.
 #
 
+from pxr import Sdf
 from pxr import Usd
+from pxr import UsdMaya
 
 from maya import cmds
 from maya import standalone
@@ -77,6 +79,83 @@ class testUsdMayaProxyShape(unittest.TestCase):
         cmds.reorder("testNode1", back=True)
         cmds.reorder("testNode2", front=True)
 
+    def testProxyShapeStagesOpenedOnFileOpen(self):
+        cmds.loadPlugin('pxrUsd', quiet=True)
+
+        usdFilePath = os.path.abspath('CubeModel.usda')
+        mayaFile = os.path.abspath('ProxyShapeStageLoadQueue.ma')
+        numShapes = 3
+
+        cmds.file(new=True, force=True)
+        for i in range(numShapes):
+            transform = cmds.createNode('transform', name='Cube%d' % i)
+            shape = cmds.createNode('pxrUsdProxyShape',
+                name='Cube%dShape' % i, parent=transform)
+            cmds.setAttr('%s.filePath' % shape, usdFilePath, type='string')
+        cmds.file(rename=mayaFile)
+        cmds.file(save=True, type='mayaAscii')
+
+        cmds.file(mayaFile, open=True, force=True)
+
+        # Opening the file clears the stage cache, and nothing has pulled on
+        # the shapes yet, so the stage in the cache was opened by the queue
+        # once the file was read. The shapes that read the same file share it.
+        rootLayer = Sdf.Layer.Find(usdFilePath)
+        self.assertTrue(rootLayer)
+        stages = UsdMaya.StageCache.Get().FindAllMatching(rootLayer)
+        self.assertEqual(len(stages), 1)
+
+        # Every shape then finds that stage in the cache.
+        for i in range(numShapes):
+            bboxSize = cmds.getAttr('Cube%dShape.boundingBoxSize' % i)[0]
+            self.assertEqual(bboxSize, (1.0, 1.0, 1.0))
+
+        stagesAfterEvaluation = \
+            UsdMaya.StageCache.Get().FindAllMatching(rootLayer)
+        self.assertEqual(len(stagesAfterEvaluation), 1)
+        self.assertEqual(stagesAfterEvaluation[0], stages[0])
+
+    def testReferenceAssemblyStagesOpenedOnFileOpen(self):
+        cmds.loadPlugin('pxrUsd', quiet=True)
+
+        usdFilePath = os.path.abspath('CubeModel.usda')
+        mayaFile = os.path.abspath('ReferenceAssemblyStageLoadQueue.ma')
+        numAssemblies = 3
+
+        cmds.file(new=True, force=True)
+        for i in range(numAssemblies):
+            assembly = cmds.assembly(name='CubeAssembly%d' % i,
+                type='pxrUsdReferenceAssembly')
+            cmds.setAttr('%s.filePath' % assembly, usdFilePath,
+                type='string')
+            cmds.setAttr('%s.primPath' % assembly, '/CubeModel',
+                type='string')
+            cmds.assembly(assembly, edit=True, active='Collapsed')
+        cmds.file(rename=mayaFile)
+        cmds.file(save=True, type='mayaAscii')
+
+        cmds.file(mayaFile, open=True, force=True)
+
+        # The assemblies activate their initial representations while the
+        # file is read, after the queue has opened their stage. They share a
+        # single stage in the cache, and nothing else had opened it, since
+        # opening the file clears the cache.
+        rootLayer = Sdf.Layer.Find(usdFilePath)
+        self.assertTrue(rootLayer)
+        stages = UsdMaya.StageCache.Get().FindAllMatching(rootLayer)
+        self.assertEqual(len(stages), 1)
+
+        for i in range(numAssemblies):
+            assembly = 'CubeAssembly%d' % i
+            self.assertEqual(
+                cmds.assembly(assembly, query=True, active=True),
+                'Collapsed')
+
+        stagesAfterActivation = \
+            UsdMaya.StageCache.Get().FindAllMatching(rootLayer)
+        self.assertEqual(len(stagesAfterActivation), 1)
+        self.assertEqual(stagesAfterActivation[0], stages[0])
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -18,6 +18,7 @@
 
 #include "usdMaya/adaptor.h"
 #include "usdMaya/primWriterRegistry.h"
+#include "usdMaya/stagedValueWriter.h"
 #include "usdMaya/util.h"
 #include "usdMaya/writeJobContext.h"
 #include "usdMaya/xformStack.h"
@@ -33,7 +34,6 @@
 #include "pxr/usd/usdGeom/xformOp.h"
 #include "pxr/usd/usdGeom/xformable.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
-#include "pxr/usd/usdUtils/sparseValueWriter.h"
 
 #include <maya/MFn.h>
 #include <maya/MFnDependencyNode.h>
@@ -57,7 +57,7 @@ setXformOp(
         const UsdGeomXformOp& op,
         const GfVec3d& value,
         const UsdTimeCode& usdTime,
-        UsdUtilsSparseValueWriter* valueWriter)
+        UsdMayaStagedValueWriter* valueWriter)
 {
     if (!op) {
         TF_CODING_ERROR("Xform op is not valid");
@@ -91,7 +91,7 @@ UsdMayaTransformWriter::_ComputeXformOps(
         const UsdTimeCode& usdTime,
         const bool eulerFilter,
         UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
-        UsdUtilsSparseValueWriter* valueWriter)
+        UsdMayaStagedValueWriter* valueWriter)
 {
     if (!TF_VERIFY(previousRotates)) {
         return;
@@ -469,7 +469,7 @@ UsdMayaTransformWriter::Write(const UsdTimeCode& usdTime)
                 usdTime,
                 _GetExportArgs().eulerFilter,
                 &_previousRotates,
-                _GetSparseValueWriter());
+                _GetStagedValueWriter());
         }
     }
 }
@@ -22,6 +22,7 @@
 #include "usdMaya/api.h"
 
 #include "usdMaya/primWriter.h"
+#include "usdMaya/stagedValueWriter.h"
 #include "usdMaya/writeJobContext.h"
 
 #include "pxr/base/gf/vec3d.h"
@@ -30,7 +31,6 @@
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/xformOp.h"
 #include "pxr/usd/usdGeom/xformable.h"
-#include "pxr/usd/usdUtils/sparseValueWriter.h"
 
 #include <maya/MFnDependencyNode.h>
 #include <maya/MEulerRotation.h>
@@ -95,7 +95,7 @@ private:
             const UsdTimeCode& usdTime,
             const bool eulerFilter,
             UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
-            UsdUtilsSparseValueWriter* valueWriter);
+            UsdMayaStagedValueWriter* valueWriter);
 
     // Creates an _AnimChannel from a Maya compound attribute if there is
     // meaningful data. This means we found data that is non-identity.
@@ -19,6 +19,7 @@
 #include "usdMaya/pointBasedDeformerNode.h"
 #include "usdMaya/primReaderArgs.h"
 #include "usdMaya/primReaderContext.h"
+#include "usdMaya/readPrefetchCache.h"
 #include "usdMaya/readUtil.h"
 #include "usdMaya/roundTripUtil.h"
 #include "usdMaya/stageNode.h"
@@ -33,12 +34,14 @@
 #include "pxr/base/vt/array.h"
 #include "pxr/base/vt/types.h"
 
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/sdf/tokens.h"
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/sdf/valueTypeName.h"
 #include "pxr/usd/usd/attribute.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usdGeom/primvar.h"
@@ -73,6 +76,51 @@
 PXR_NAMESPACE_OPEN_SCOPE
 
 
+// Returns the USD stage node of the import, creating it the first time a
+// point based deformer needs it, so that imports without any streamed meshes
+// don't leave an unused stage node behind.
+static
+MObject
+_GetOrCreateStageNode(
+        const UsdPrim& prim,
+        UsdMayaPrimReaderContext* context)
+{
+    const SdfPath stageNodePath(
+        UsdMayaStageNodeTokens->MayaTypeName.GetString());
+
+    MObject stageNode = context->GetMayaNode(stageNodePath, false);
+    if (!stageNode.isNull()) {
+        return stageNode;
+    }
+
+    MStatus status;
+    MDGModifier dgMod;
+    stageNode = dgMod.createNode(UsdMayaStageNode::typeId, &status);
+    CHECK_MSTATUS_AND_RETURN(status, MObject());
+
+    MFnDependencyNode depNodeFn(stageNode, &status);
+    CHECK_MSTATUS_AND_RETURN(status, MObject());
+
+    MPlug filePathPlug = depNodeFn.findPlug(UsdMayaStageNode::filePathAttr,
+                                            true,
+                                            &status);
+    CHECK_MSTATUS_AND_RETURN(status, MObject());
+
+    status = dgMod.newPlugValueString(
+        filePathPlug,
+        prim.GetStage()->GetRootLayer()->GetIdentifier().c_str());
+    CHECK_MSTATUS_AND_RETURN(status, MObject());
+
+    status = dgMod.doIt();
+    CHECK_MSTATUS_AND_RETURN(status, MObject());
+
+    // We only ever create a single stage node per import, so we can simply
+    // register it and later look it up in the registry using its type name.
+    context->RegisterNewMayaNode(stageNodePath.GetString(), stageNode);
+
+    return stageNode;
+}
+
 static
 bool
 _SetupPointBasedDeformerForMayaNode(
@@ -80,16 +128,13 @@ _SetupPointBasedDeformerForMayaNode(
         const UsdPrim& prim,
         UsdMayaPrimReaderContext* context)
 {
-    // We try to get the USD stage node from the context's registry, so if we
-    // don't have a reader context, we can't continue.
+    // We keep the USD stage node in the context's registry, so if we don't
+    // have a reader context, we can't continue.
     if (!context) {
         return false;
     }
 
-    MObject stageNode =
-        context->GetMayaNode(
-            SdfPath(UsdMayaStageNodeTokens->MayaTypeName.GetString()),
-            false);
+    MObject stageNode = _GetOrCreateStageNode(prim, context);
     if (stageNode.isNull()) {
         return false;
     }
@@ -240,101 +285,36 @@ UsdMayaTranslatorMesh::Create(
         return false;
     }
 
-    VtIntArray faceVertexCounts;
-    VtIntArray faceVertexIndices;
-
-    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
-    if (fvc.ValueMightBeTimeVarying()){
-        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
-        // for the mesh, perhaps?  For now, better to give a more specific error
-        TF_RUNTIME_ERROR(
-                "<%s> is a topologically varying Mesh (has animated "
-                "faceVertexCounts), which isn't currently supported. "
-                "Skipping...",
-                prim.GetPath().GetText());
-        return false;
-    } else {
-        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
-    }
-
-    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
-    if (fvi.ValueMightBeTimeVarying()){
-        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
-        // for the mesh, perhaps?  For now, better to give a more specific error
-        TF_RUNTIME_ERROR(
-                "<%s> is a topologically varying Mesh (has animated "
-                "faceVertexIndices), which isn't currently supported. "
-                "Skipping...",
-                prim.GetPath().GetText());
-        return false;
-    } else {
-        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
-    }
-
-    // Sanity Checks. If the vertex arrays are empty, skip this mesh
-    if (faceVertexCounts.empty() || faceVertexIndices.empty()) {
-        TF_RUNTIME_ERROR(
-                "faceVertexCounts or faceVertexIndices array is empty "
-                "[count: %zu, indices:%zu] on Mesh <%s>. Skipping...",
-                faceVertexCounts.size(), faceVertexIndices.size(),
-                prim.GetPath().GetText());
-        return false; // invalid mesh, so exit
+    // Use the data read ahead of this prim reader if there is any. If not, or
+    // if the mesh could not be read, read it here so that errors get
+    // reported.
+    UsdMaya_ReadPrefetchCache::MeshData* meshData = nullptr;
+    if (UsdMaya_ReadPrefetchCache* prefetchCache = args.GetPrefetchCache()) {
+        meshData = prefetchCache->GetMesh(prim);
     }
 
-    // Gather points and normals
-    // If timeInterval is non-empty, pick the first available sample in the
-    // timeInterval or default.
-    VtVec3fArray points;
-    VtVec3fArray normals;
-    UsdTimeCode pointsTimeSample = UsdTimeCode::EarliestTime();
-    UsdTimeCode normalsTimeSample = UsdTimeCode::EarliestTime();
-    std::vector<double> pointsTimeSamples;
-    size_t pointsNumTimeSamples = 0u;
-    if (!args.GetTimeInterval().IsEmpty()) {
-        mesh.GetPointsAttr().GetTimeSamplesInInterval(args.GetTimeInterval(),
-                                                      &pointsTimeSamples);
-        if (!pointsTimeSamples.empty()) {
-            pointsNumTimeSamples = pointsTimeSamples.size();
-            pointsTimeSample = pointsTimeSamples.front();
-        }
-
-        std::vector<double> normalsTimeSamples;
-        mesh.GetNormalsAttr().GetTimeSamplesInInterval(args.GetTimeInterval(),
-                                                       &normalsTimeSamples);
-        if (!normalsTimeSamples.empty()) {
-            normalsTimeSample = normalsTimeSamples.front();
+    UsdMaya_ReadPrefetchCache::MeshData readMeshData;
+    if (!meshData) {
+        std::string reason;
+        if (!UsdMaya_ReadPrefetchCache::ReadMesh(mesh,
+                                                 args.GetTimeInterval(),
+                                                 &readMeshData,
+                                                 &reason)) {
+            TF_RUNTIME_ERROR("%s", reason.c_str());
+            return false;
         }
+        meshData = &readMeshData;
     }
 
-    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
-    mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
-
-    if (points.empty()) {
-        TF_RUNTIME_ERROR("points array is empty on Mesh <%s>. Skipping...",
-                         prim.GetPath().GetText());
-        return false;
-    }
-
-    std::string reason;
-    if (!UsdGeomMesh::ValidateTopology(faceVertexIndices,
-                                       faceVertexCounts,
-                                       points.size(),
-                                       &reason)) {
-        TF_RUNTIME_ERROR("Skipping Mesh <%s> with invalid topology: %s",
-                         prim.GetPath().GetText(), reason.c_str());
-        return false;
-    }
-
-
-    // == Convert data
-    const size_t mayaNumVertices = points.size();
-    MPointArray mayaPoints(mayaNumVertices);
-    for (size_t i = 0u; i < mayaNumVertices; ++i) {
-        mayaPoints.set(i, points[i][0], points[i][1], points[i][2]);
-    }
-
-    MIntArray polygonCounts(faceVertexCounts.cdata(), faceVertexCounts.size());
-    MIntArray polygonConnects(faceVertexIndices.cdata(), faceVertexIndices.size());
+    // MFnMesh takes some of the arrays by non-const reference.
+    MPointArray& mayaPoints = meshData->points;
+    MIntArray& polygonCounts = meshData->polygonCounts;
+    MIntArray& polygonConnects = meshData->polygonConnects;
+    MIntArray& normalsFaceIds = meshData->normalsFaceIds;
+    const std::vector<double>& pointsTimeSamples =
+        meshData->pointsTimeSamples;
+    const size_t pointsNumTimeSamples = pointsTimeSamples.size();
+    const size_t mayaNumVertices = mayaPoints.length();
 
     // == Create Mesh Shape Node
     MFnMesh meshFn;
@@ -374,28 +354,13 @@ UsdMayaTranslatorMesh::Create(
     UsdMayaTranslatorGprim::Read(mesh, meshObj, context);
 
     // Set normals if supplied
-    MIntArray normalsFaceIds;
-    if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices())) {
-        for (size_t i = 0u; i < polygonCounts.length(); ++i) {
-            for (int j = 0; j < polygonCounts[i]; ++j) {
-                normalsFaceIds.append(i);
-            }
-        }
-
-        if (normalsFaceIds.length() == static_cast<size_t>(meshFn.numFaceVertices())) {
-            MVectorArray mayaNormals(normals.size());
-            for (size_t i = 0u; i < normals.size(); ++i) {
-                mayaNormals.set(MVector(normals[i][0u],
-                                        normals[i][1u],
-                                        normals[i][2u]),
-                                i);
-            }
-
-            meshFn.setFaceVertexNormals(mayaNormals,
-                                        normalsFaceIds,
-                                        polygonConnects);
-        }
-     }
+    const bool hasFaceVertexNormals = meshData->normals.length() ==
+        static_cast<unsigned int>(meshFn.numFaceVertices());
+    if (hasFaceVertexNormals) {
+        meshFn.setFaceVertexNormals(meshData->normals,
+                                    normalsFaceIds,
+                                    polygonConnects);
+    }
 
     // Copy UsdGeomMesh schema attrs into Maya if they're authored.
     UsdMayaReadUtil::ReadSchemaAttributesFromPrim<UsdGeomMesh>(
@@ -413,7 +378,7 @@ UsdMayaTranslatorMesh::Create(
     TfToken subdScheme;
     if (mesh.GetSubdivisionSchemeAttr().Get(&subdScheme) &&
             subdScheme == UsdGeomTokens->none) {
-        if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices()) &&
+        if (hasFaceVertexNormals &&
                 mesh.GetNormalsInterpolation() == UsdGeomTokens->faceVarying) {
             UsdMayaMeshUtil::SetEmitNormalsTag(meshFn, true);
         }
@@ -532,10 +497,11 @@ UsdMayaTranslatorMesh::Create(
         return true;
     }
 
-    // If we're using the imported USD as an animation cache, try to setup the
-    // point based deformer for this prim. If that fails, we'll fallback on
-    // creating a blend shape deformer.
-    if (args.GetUseAsAnimationCache() &&
+    // If we're using the imported USD as an animation cache, or if this mesh
+    // has too many point samples to bake, try to setup the point based
+    // deformer for this prim. If that fails, we'll fallback on creating a
+    // blend shape deformer.
+    if (args.ShouldStreamPoints(mayaNumVertices, pointsNumTimeSamples) &&
             _SetupPointBasedDeformerForMayaNode(meshObj, prim, context)) {
         return true;
     }
@@ -548,6 +514,8 @@ UsdMayaTranslatorMesh::Create(
 
     MFnBlendShapeDeformer blendFn;
     MObject blendObj = blendFn.create(meshObj);
+    VtVec3fArray points;
+    VtVec3fArray normals;
     if (context) {
         context->RegisterNewMayaNode(blendFn.name().asChar(), blendObj); // used for undo/redo
     }
@@ -28,6 +28,8 @@
 #include "pxr/base/vt/array.h"
 #include "pxr/base/vt/types.h"
 #include "pxr/base/vt/value.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/base/work/threadLimits.h"
 #include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usdGeom/metrics.h"
 
@@ -49,9 +51,9 @@
 #include <maya/MFnSet.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MItDependencyNodes.h>
-#include <maya/MItMeshFaceVertex.h>
 #include <maya/MItMeshPolygon.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
@@ -64,6 +66,8 @@
 #include <maya/MStringArray.h>
 #include <maya/MTime.h>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -957,21 +961,18 @@ struct _ValuesEqual
 
 } // anonymous namespace
 
+// Primvars with fewer values or components than this are processed serially,
+// since partitioning the work costs more than it saves on small meshes.
+static const size_t _parallelPrimvarThreshold = 100000u;
+
 template <typename T>
 static
 void
-_MergeEquivalentIndexedValues(
+_MergeEquivalentIndexedValuesSerial(
         VtArray<T>* valueData,
         VtIntArray* assignmentIndices)
 {
-    if (!valueData || !assignmentIndices) {
-        return;
-    }
-
     const size_t numValues = valueData->size();
-    if (numValues == 0u) {
-        return;
-    }
 
     // We maintain a map of values to that value's index in our uniqueValues
     // array.
@@ -1011,6 +1012,126 @@ _MergeEquivalentIndexedValues(
     }
 }
 
+template <typename T>
+static
+void
+_MergeEquivalentIndexedValuesParallel(
+        VtArray<T>* valueData,
+        VtIntArray* assignmentIndices)
+{
+    const size_t numValues = valueData->size();
+    const T* values = valueData->cdata();
+
+    typedef std::unordered_map<T, size_t, _ValuesHash<T>, _ValuesEqual<T> >
+        _ValuesMap;
+
+    // Find the first of each set of equivalent values within contiguous
+    // chunks of the values in parallel.
+    const size_t concurrencyLimit = std::max(1u, WorkGetConcurrencyLimit());
+    const size_t numChunks = std::min(numValues, concurrencyLimit);
+    const size_t chunkSize = (numValues + numChunks - 1u) / numChunks;
+    std::vector<_ValuesMap> chunkMaps(numChunks);
+    std::vector<size_t> firstEquivalent(numValues);
+    WorkParallelForN(
+        numChunks,
+        [numValues, chunkSize, values, &chunkMaps, &firstEquivalent](
+                size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                const size_t chunkBegin = chunk * chunkSize;
+                const size_t chunkEnd =
+                    std::min(numValues, chunkBegin + chunkSize);
+                _ValuesMap& valuesMap = chunkMaps[chunk];
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                    auto inserted = valuesMap.insert(
+                        std::pair<T, size_t>(values[i], i));
+                    firstEquivalent[i] = inserted.first->second;
+                }
+            }
+        });
+
+    // Merge the chunk maps in order, pointing the first value of each chunk
+    // at the first equivalent value across all of the chunks. Values are
+    // then resolved with two lookups into firstEquivalent.
+    _ValuesMap& valuesMap = chunkMaps.front();
+    for (size_t chunk = 1u; chunk < numChunks; ++chunk) {
+        for (const auto& valueAndIndex : chunkMaps[chunk]) {
+            auto inserted = valuesMap.insert(valueAndIndex);
+            firstEquivalent[valueAndIndex.second] = inserted.first->second;
+        }
+        _ValuesMap().swap(chunkMaps[chunk]);
+    }
+
+    // Number the unique values in the order in which they are first
+    // referenced, exactly as the serial version does.
+    const VtIntArray& indices = *assignmentIndices;
+    const size_t numIndices = indices.size();
+    std::vector<int> uniqueIndexOf(numValues, -1);
+    VtArray<T> uniqueValues;
+    for (size_t i = 0u; i < numIndices; ++i) {
+        const int index = indices[i];
+        if (index < 0 || static_cast<size_t>(index) >= numValues) {
+            continue;
+        }
+
+        int& uniqueIndex =
+            uniqueIndexOf[firstEquivalent[firstEquivalent[index]]];
+        if (uniqueIndex < 0) {
+            uniqueIndex = static_cast<int>(uniqueValues.size());
+            uniqueValues.push_back(values[index]);
+        }
+    }
+
+    if (uniqueValues.size() >= numValues) {
+        return;
+    }
+
+    VtIntArray uniqueIndices(numIndices);
+    int* uniqueIndicesData = uniqueIndices.data();
+    WorkParallelForN(
+        numIndices,
+        [numValues, &indices, &firstEquivalent, &uniqueIndexOf,
+                uniqueIndicesData](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const int index = indices[i];
+                if (index < 0 || static_cast<size_t>(index) >= numValues) {
+                    // This is an unassigned or otherwise unknown index, so
+                    // just keep it.
+                    uniqueIndicesData[i] = index;
+                } else {
+                    uniqueIndicesData[i] = uniqueIndexOf[
+                        firstEquivalent[firstEquivalent[index]]];
+                }
+            }
+        });
+
+    (*valueData) = uniqueValues;
+    (*assignmentIndices) = uniqueIndices;
+}
+
+template <typename T>
+static
+void
+_MergeEquivalentIndexedValues(
+        VtArray<T>* valueData,
+        VtIntArray* assignmentIndices)
+{
+    if (!valueData || !assignmentIndices) {
+        return;
+    }
+
+    const size_t numValues = valueData->size();
+    if (numValues == 0u) {
+        return;
+    }
+
+    if (numValues < _parallelPrimvarThreshold &&
+            assignmentIndices->size() < _parallelPrimvarThreshold) {
+        _MergeEquivalentIndexedValuesSerial(valueData, assignmentIndices);
+    } else {
+        _MergeEquivalentIndexedValuesParallel(valueData, assignmentIndices);
+    }
+}
+
 void
 UsdMayaUtil::MergeEquivalentIndexedValues(
         VtFloatArray* valueData,
@@ -1051,9 +1172,18 @@ UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
         return;
     }
 
+    MIntArray faceVertexCounts;
+    MIntArray faceVertexIndices;
+    mesh.getVertices(faceVertexCounts, faceVertexIndices);
+
+    const size_t numFaceVertices = faceVertexIndices.length();
+    if (assignmentIndices->size() < numFaceVertices) {
+        return;
+    }
+
     // Use -2 as the initial "un-stored" sentinel value, since -1 is the
     // default unauthored value index for primvars.
-    int numPolygons = mesh.numPolygons();
+    const unsigned int numPolygons = faceVertexCounts.length();
     VtIntArray uniformAssignments;
     uniformAssignments.assign((size_t)numPolygons, -2);
 
@@ -1061,47 +1191,66 @@ UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
     VtIntArray vertexAssignments;
     vertexAssignments.assign((size_t)numVertices, -2);
 
+    std::vector<unsigned int> faceOffsets(numPolygons);
+    unsigned int faceOffset = 0u;
+    for (unsigned int i = 0u; i < numPolygons; ++i) {
+        faceOffsets[i] = faceOffset;
+        faceOffset += faceVertexCounts[i];
+    }
+
     // We assume that the data is constant/uniform/vertex until we can
     // prove otherwise that two components have differing values.
-    bool isConstant = true;
-    bool isUniform = true;
-    bool isVertex = true;
-
-    MItMeshFaceVertex itFV(mesh.object());
-    unsigned int fvi = 0;
-    for (itFV.reset(); !itFV.isDone(); itFV.next(), ++fvi) {
-        int faceIndex = itFV.faceId();
-        int vertexIndex = itFV.vertId();
-
-        int assignedIndex = (*assignmentIndices)[fvi];
-
-        if (isConstant) {
-            if (assignedIndex != (*assignmentIndices)[0]) {
-                isConstant = false;
+    // Each face can be checked for uniformity independently, so the constant
+    // and uniform checks are done in parallel for large meshes.
+    const int* assigned = assignmentIndices->cdata();
+    int* uniformData = uniformAssignments.data();
+    std::atomic<bool> isConstant(true);
+    std::atomic<bool> isUniform(true);
+    auto checkFaces = [&](size_t begin, size_t end) {
+        bool constant = isConstant;
+        bool uniform = isUniform;
+        for (size_t face = begin;
+                face < end && (constant || uniform); ++face) {
+            const unsigned int faceBegin = faceOffsets[face];
+            const unsigned int faceEnd = faceBegin + faceVertexCounts[face];
+            for (unsigned int fvi = faceBegin; fvi < faceEnd; ++fvi) {
+                const int assignedIndex = assigned[fvi];
+                if (constant && assignedIndex != assigned[0]) {
+                    constant = false;
+                }
+                if (uniform) {
+                    if (fvi == faceBegin) {
+                        // No value for this face yet, so store one.
+                        uniformData[face] = assignedIndex;
+                    } else if (assignedIndex != uniformData[face]) {
+                        uniform = false;
+                    }
+                }
             }
         }
-
-        if (isUniform) {
-            if (uniformAssignments[faceIndex] < -1) {
-                // No value for this face yet, so store one.
-                uniformAssignments[faceIndex] = assignedIndex;
-            } else if (assignedIndex != uniformAssignments[faceIndex]) {
-                isUniform = false;
-            }
+        if (!constant) {
+            isConstant = false;
         }
-
-        if (isVertex) {
-            if (vertexAssignments[vertexIndex] < -1) {
-                // No value for this vertex yet, so store one.
-                vertexAssignments[vertexIndex] = assignedIndex;
-            } else if (assignedIndex != vertexAssignments[vertexIndex]) {
-                isVertex = false;
-            }
+        if (!uniform) {
+            isUniform = false;
         }
+    };
+    if (numFaceVertices < _parallelPrimvarThreshold) {
+        checkFaces(0u, numPolygons);
+    } else {
+        WorkParallelForN(numPolygons, checkFaces);
+    }
 
-        if (!isConstant && !isUniform && !isVertex) {
+    bool isVertex = !isConstant && !isUniform;
+    for (unsigned int fvi = 0u; isVertex && fvi < numFaceVertices; ++fvi) {
+        const int vertexIndex = faceVertexIndices[fvi];
+        const int assignedIndex = assigned[fvi];
+        if (vertexAssignments[vertexIndex] < -1) {
+            // No value for this vertex yet, so store one.
+            vertexAssignments[vertexIndex] = assignedIndex;
+        } else if (assignedIndex != vertexAssignments[vertexIndex]) {
             // No compression will be possible, so stop trying.
-            break;
+            isVertex = false;
         }
     }
 
@@ -1772,11 +1921,12 @@ UsdMayaUtil::GetDictionaryFromArgDatabase(
         const MArgDatabase& argData,
         const VtDictionary& guideDict)
 {
-    // We handle three types of arguments:
+    // We handle four types of arguments:
     // 1 - bools: Some bools are actual boolean flags (t/f) in Maya, and others
     //     are false if omitted, true if present (simple flags).
-    // 2 - strings: Just strings!
-    // 3 - vectors (multi-use args): Try to mimic the way they're passed in the
+    // 2 - ints: Just ints!
+    // 3 - strings: Just strings!
+    // 4 - vectors (multi-use args): Try to mimic the way they're passed in the
     //     Python command API. If single arg per flag, make it a vector of
     //     strings. Multi arg per flag, vector of vector of strings.
     VtDictionary args;
@@ -1787,7 +1937,7 @@ UsdMayaUtil::GetDictionaryFromArgDatabase(
             continue;
         }
 
-        // The usdExport command must handle bools, strings, and vectors.
+        // The usdExport command must handle bools, ints, strings, and vectors.
         if (guideValue.IsHolding<bool>()) {
             // The flag should be either 0-arg or 1-arg. If 0-arg, it's true by
             // virtue of being present (getFlagArgument won't change val). If
@@ -1797,6 +1947,11 @@ UsdMayaUtil::GetDictionaryFromArgDatabase(
             argData.getFlagArgument(key.c_str(), 0, val);
             args[key] = val;
         }
+        else if (guideValue.IsHolding<int>()) {
+            int val = guideValue.UncheckedGet<int>();
+            argData.getFlagArgument(key.c_str(), 0, val);
+            args[key] = val;
+        }
         else if (guideValue.IsHolding<std::string>()) {
             const std::string val =
                     argData.flagArgumentString(key.c_str(), 0).asChar();
@@ -1851,18 +2006,22 @@ UsdMayaUtil::ParseArgumentValue(
         const std::string& value,
         const VtDictionary& guideDict)
 {
-    // We handle two types of arguments:
+    // We handle three types of arguments:
     // 1 - bools: Should be encoded by translator UI as a "1" or "0" string.
-    // 2 - strings: Just strings!
+    // 2 - ints: Encoded by the translator UI as a decimal string.
+    // 3 - strings: Just strings!
     // We don't handle any vectors because none of the translator UIs currently
     // pass around any of the vector flags.
     auto iter = guideDict.find(key);
     if (iter != guideDict.end()) {
         const VtValue& guideValue = iter->second;
-        // The export UI only has boolean and string parameters.
+        // The export UI only has boolean, int and string parameters.
         if (guideValue.IsHolding<bool>()) {
             return VtValue(TfUnstringify<bool>(value));
         }
+        else if (guideValue.IsHolding<int>()) {
+            return VtValue(TfUnstringify<int>(value));
+        }
         else if (guideValue.IsHolding<std::string>()) {
             return VtValue(value);
         }
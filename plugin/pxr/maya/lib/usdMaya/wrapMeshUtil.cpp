@@ -18,10 +18,14 @@
 #include "usdMaya/meshUtil.h"
 #include "usdMaya/util.h"
 
+#include "pxr/base/gf/vec2f.h"
 #include "pxr/base/gf/vec3f.h"
+#include "pxr/base/gf/vec4f.h"
 #include "pxr/base/tf/pyResultConversions.h"
 #include "pxr/base/tf/token.h"
 #include "pxr/base/vt/array.h"
+#include "pxr/base/vt/types.h"
+#include "pxr/usd/usdGeom/tokens.h"
 
 #include <maya/MFnMesh.h>
 #include <maya/MObject.h>
@@ -67,6 +71,46 @@ _GetMeshNormals(const std::string& meshDagPath)
     return make_tuple(normalsArray, interpolation);
 }
 
+template <typename T>
+static
+tuple
+_MergeEquivalentIndexedValues(
+        VtArray<T> valueData,
+        VtIntArray assignmentIndices)
+{
+    UsdMayaUtil::MergeEquivalentIndexedValues(&valueData, &assignmentIndices);
+    return make_tuple(valueData, assignmentIndices);
+}
+
+static
+tuple
+_CompressFaceVaryingPrimvarIndices(
+        const std::string& meshDagPath,
+        VtIntArray assignmentIndices)
+{
+    TfToken interpolation = UsdGeomTokens->faceVarying;
+
+    MObject meshObj;
+    MStatus status = UsdMayaUtil::GetMObjectByName(meshDagPath, meshObj);
+    if (status != MS::kSuccess) {
+        TF_CODING_ERROR("Could not get MObject for dagPath: %s",
+                        meshDagPath.c_str());
+        return make_tuple(interpolation, assignmentIndices);
+    }
+
+    MFnMesh meshFn(meshObj, &status);
+    if (status != MS::kSuccess) {
+        TF_CODING_ERROR("MFnMesh() failed for object at dagPath: %s",
+                        meshDagPath.c_str());
+        return make_tuple(interpolation, assignmentIndices);
+    }
+
+    UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
+        meshFn, &interpolation, &assignmentIndices);
+
+    return make_tuple(interpolation, assignmentIndices);
+}
+
 // Dummy class for putting UsdMayaMeshUtil namespace functions in a Python
 // MeshUtil namespace.
 class DummyScopeClass{};
@@ -81,5 +125,21 @@ void wrapMeshUtil()
         .def("GetMeshNormals", &_GetMeshNormals)
             .staticmethod("GetMeshNormals")
 
+        // Overloads are tried in reverse order, so the scalar version is
+        // registered last to stop float arrays converting to vector arrays.
+        .def("MergeEquivalentIndexedValues",
+                &_MergeEquivalentIndexedValues<GfVec4f>)
+        .def("MergeEquivalentIndexedValues",
+                &_MergeEquivalentIndexedValues<GfVec3f>)
+        .def("MergeEquivalentIndexedValues",
+                &_MergeEquivalentIndexedValues<GfVec2f>)
+        .def("MergeEquivalentIndexedValues",
+                &_MergeEquivalentIndexedValues<float>)
+            .staticmethod("MergeEquivalentIndexedValues")
+
+        .def("CompressFaceVaryingPrimvarIndices",
+                &_CompressFaceVaryingPrimvarIndices)
+            .staticmethod("CompressFaceVaryingPrimvarIndices")
+
         ;
 }
@@ -20,24 +20,33 @@
 #include "usdMaya/modelKindProcessor.h"
 #include "usdMaya/primWriter.h"
 #include "usdMaya/primWriterRegistry.h"
+#include "usdMaya/stagedValueWriter.h"
 #include "usdMaya/shadingModeExporterContext.h"
 #include "usdMaya/transformWriter.h"
 #include "usdMaya/translatorMaterial.h"
 #include "usdMaya/util.h"
+#include "usdMaya/writeJobReport.h"
 
 #include "usdMaya/chaser.h"
 #include "usdMaya/chaserRegistry.h"
 
+#include "pxr/base/gf/vec2d.h"
 #include "pxr/base/tf/fileUtils.h"
 #include "pxr/base/tf/hash.h"
 #include "pxr/base/tf/hashset.h"
 #include "pxr/base/tf/pathUtils.h"
 #include "pxr/base/tf/stl.h"
 #include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/vt/types.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/ar/resolver.h"
 #include "pxr/usd/kind/registry.h"
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/changeBlock.h"
 #include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/usd/clipsAPI.h"
 // Needed for directly removing a UsdVariant via Sdf
 //   Remove when UsdVariantSet::RemoveVariant() is exposed
 //   XXX [bug 75864]
@@ -73,9 +82,14 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 
 UsdMaya_WriteJob::UsdMaya_WriteJob(const UsdMayaJobExportArgs& iArgs)
-    : mJobCtx(iArgs),
+    : _clipChunkSize(0),
+      _clipStartTime(0.0),
+      mJobCtx(iArgs),
       _modelKindProcessor(new UsdMaya_ModelKindProcessor(iArgs))
 {
+    if (iArgs.profileReport) {
+        _report.reset(new UsdMaya_WriteJobReport());
+    }
 }
 
 
@@ -101,6 +115,73 @@ _MakeTmpStageName(const std::string& dir)
     return TfStringCatPaths(dir, fileName);
 }
 
+/// Generates the name of the value clip file holding chunk \p clipIndex of the
+/// time-samples exported to \p fileName.
+static
+std::string
+_MakeClipFileName(const std::string& fileName, size_t clipIndex)
+{
+    return TfStringPrintf(
+            "%s.clip%04zu.%s",
+            TfStringGetBeforeSuffix(fileName).c_str(),
+            clipIndex,
+            UsdMayaTranslatorTokens->UsdFileExtensionCrate.GetText());
+}
+
+/// Generates the name of the value clip manifest for \p fileName.
+static
+std::string
+_MakeClipManifestFileName(const std::string& fileName)
+{
+    return TfStringPrintf(
+            "%s.manifest.%s",
+            TfStringGetBeforeSuffix(fileName).c_str(),
+            UsdMayaTranslatorTokens->UsdFileExtensionCrate.GetText());
+}
+
+/// Makes sure \p dstLayer has an attribute spec at \p attrPath matching the
+/// one in \p srcLayer, creating over prim specs for its ancestors as needed.
+static
+bool
+_CopyAttributeSpec(
+        const SdfLayerHandle& srcLayer,
+        const SdfLayerHandle& dstLayer,
+        const SdfPath& attrPath)
+{
+    if (dstLayer->GetAttributeAtPath(attrPath)) {
+        return true;
+    }
+
+    const SdfAttributeSpecHandle srcAttrSpec =
+        srcLayer->GetAttributeAtPath(attrPath);
+    if (!srcAttrSpec) {
+        return false;
+    }
+
+    const SdfPrimSpecHandle primSpec =
+        SdfCreatePrimInLayer(dstLayer, attrPath.GetPrimPath());
+    if (!primSpec) {
+        return false;
+    }
+
+    return static_cast<bool>(SdfAttributeSpec::New(
+        primSpec,
+        attrPath.GetName(),
+        srcAttrSpec->GetTypeName(),
+        srcAttrSpec->GetVariability(),
+        srcAttrSpec->IsCustom()));
+}
+
+/// Generates the name of the export report written next to \p fileName.
+static
+std::string
+_MakeReportFileName(const std::string& fileName)
+{
+    return TfStringPrintf(
+            "%s.report.json",
+            TfStringGetBeforeSuffix(fileName).c_str());
+}
+
 /// Chooses the fallback extension based on the compatibility profile, e.g.
 /// ARKit-compatible files should be usdz's by default.
 static
@@ -130,7 +211,12 @@ UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
     }
 
     // Default-time export.
-    if (!_BeginWriting(fileName, append)) {
+    bool success;
+    {
+        UsdMaya_WriteJobReport::ScopedPhase phase(_report.get(), "begin");
+        success = _BeginWriting(fileName, append);
+    }
+    if (!success) {
         computation.endComputation();
         return false;
     }
@@ -139,22 +225,64 @@ UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
     if (!timeSamples.empty()) {
         const MTime oldCurTime = MAnimControl::currentTime();
 
+        if (mJobCtx.mArgs.clipChunkSize > 0) {
+            if (SdfLayer::IsAnonymousLayerIdentifier(_fileName)) {
+                TF_WARN("Cannot write value clips for anonymous layer '%s'; "
+                        "ignoring clipChunkSize",
+                        _fileName.c_str());
+            }
+            else {
+                _clipChunkSize = mJobCtx.mArgs.clipChunkSize;
+                _clipStartTime = timeSamples.front();
+            }
+        }
+
         int progress = 0;
         for (double t : timeSamples) {
             if (mJobCtx.mArgs.verbose) {
                 TF_STATUS("%f", t);
             }
-            MGlobal::viewFrame(t);
+            if (_report) {
+                _report->BeginFrame(t);
+            }
+
+            {
+                UsdMaya_WriteJobReport::ScopedPhase phase(
+                    _report.get(), "viewFrame");
+                MGlobal::viewFrame(t);
+            }
             computation.setProgress(progress);
             progress++;
 
             // Process per frame data.
-            if (!_WriteFrame(t)) {
+            {
+                UsdMaya_WriteJobReport::ScopedPhase phase(
+                    _report.get(), "frame");
+                success = _WriteFrame(t);
+            }
+            if (_report) {
+                _report->EndFrame();
+            }
+            if (!success) {
                 MGlobal::viewFrame(oldCurTime);
                 computation.endComputation();
                 return false;
             }
 
+            // Once the first frame of the next chunk has been written, the
+            // current chunk is complete and its samples can leave the stage.
+            if (_clipChunkSize > 0 &&
+                    static_cast<size_t>(progress - 1) % _clipChunkSize == 0 &&
+                    t > _clipStartTime) {
+                UsdMaya_WriteJobReport::ScopedPhase phase(
+                    _report.get(), "writeClip");
+                if (!_WriteClip(t)) {
+                    MGlobal::viewFrame(oldCurTime);
+                    computation.endComputation();
+                    return false;
+                }
+            }
+
             // Allow user cancellation.
             if (computation.isInterruptRequested()) {
                 break;
@@ -166,11 +294,20 @@ UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
     }
 
     // Finalize the export, close the stage.
-    if (!_FinishWriting()) {
+    {
+        UsdMaya_WriteJobReport::ScopedPhase phase(_report.get(), "finish");
+        success = _FinishWriting();
+    }
+    if (!success) {
         computation.endComputation();
         return false;
     }
 
+    if (_report && !_reportFileName.empty()) {
+        TF_STATUS("Writing export report '%s'", _reportFileName.c_str());
+        _report->Write(_reportFileName);
+    }
+
     computation.endComputation();
     return true;
 }
@@ -245,6 +382,17 @@ UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
         _packageName = std::string();
     }
 
+    if (_report) {
+        if (SdfLayer::IsAnonymousLayerIdentifier(fileNameWithExt)) {
+            TF_WARN("Cannot write export report for anonymous layer '%s'; "
+                    "ignoring profileReport",
+                    fileNameWithExt.c_str());
+        }
+        else {
+            _reportFileName = _MakeReportFileName(fileNameWithExt);
+        }
+    }
+
     TF_STATUS("Opening layer '%s' for writing", _fileName.c_str());
     if (mJobCtx.mArgs.renderLayerMode ==
             UsdMayaJobExportArgsTokens->modelingVariant) {
@@ -344,6 +492,8 @@ UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
 
     // Now do a depth-first traversal of the Maya DAG from the world root.
     // We keep a reference to arg dagPaths as we encounter them.
+    UsdMaya_WriteJobReport::ScopedPhase traversalPhase(
+        _report.get(), "dagTraversal");
     MDagPath curLeafDagPath;
     for (MItDag itDag(MItDag::kDepthFirst, MFn::kInvalid); !itDag.isDone(); itDag.next()) {
         MDagPath curDagPath;
@@ -384,7 +534,11 @@ UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
                         return false;
                     }
 
-                    primWriter->Write(UsdTimeCode::Default());
+                    {
+                        UsdMaya_WriteJobReport::ScopedPrimWriter scope(
+                            _report.get(), *primWriter);
+                        primWriter->Write(UsdTimeCode::Default());
+                    }
 
                     const UsdMayaUtil::MDagPathMap<SdfPath>& mapping =
                             primWriter->GetDagToUsdPathMapping();
@@ -400,14 +554,21 @@ UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
         }
     }
 
+    traversalPhase.Release();
+
     // Writing Materials/Shading
+    UsdMaya_WriteJobReport::ScopedPhase shadingPhase(
+        _report.get(), "exportShadingEngines");
     UsdMayaTranslatorMaterial::ExportShadingEngines(
         mJobCtx,
         mDagPathToUsdPathMap);
+    shadingPhase.Release();
 
     // Perform post-processing for instances, skel, etc.
     // We shouldn't be creating new instance masters after this point, and we
     // want to cleanup the InstanceSources prim before writing model hierarchy.
+    UsdMaya_WriteJobReport::ScopedPhase postProcessPhase(
+        _report.get(), "postProcess");
     if (!mJobCtx._PostProcess()) {
         return false;
     }
@@ -415,8 +576,10 @@ UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
     if (!_modelKindProcessor->MakeModelHierarchy(mJobCtx.mStage)) {
         return false;
     }
+    postProcessPhase.Release();
 
     // now we populate the chasers and run export default
+    UsdMaya_WriteJobReport::ScopedPhase chasersPhase(_report.get(), "chasers");
     mChasers.clear();
     UsdMayaChaserRegistry::FactoryContext ctx(mJobCtx.mStage, mDagPathToUsdPathMap, mJobCtx.mArgs);
     for (const std::string& chaserName : mJobCtx.mArgs.chaserNames) {
@@ -443,25 +606,78 @@ UsdMaya_WriteJob::_WriteFrame(double iFrame)
 {
     const UsdTimeCode usdTime(iFrame);
 
+    // With parallelWrite, the prim writers still pull their data from Maya
+    // on the main thread, but the resulting time-samples are staged and only
+    // merged into the layer once every prim writer is done with the frame.
+    mJobCtx.mStagingValues = mJobCtx.mArgs.parallelWrite;
+
+    UsdMaya_WriteJobReport::ScopedPhase writePrimsPhase(
+        _report.get(), "writePrims");
     for (const UsdMayaPrimWriterSharedPtr& primWriter :
             mJobCtx.mMayaPrimWriterList) {
         const UsdPrim& usdPrim = primWriter->GetUsdPrim();
         if (usdPrim) {
+            UsdMaya_WriteJobReport::ScopedPrimWriter scope(
+                _report.get(), *primWriter);
             primWriter->Write(usdTime);
         }
     }
+    writePrimsPhase.Release();
 
+    if (mJobCtx.mStagingValues) {
+        UsdMaya_WriteJobReport::ScopedPhase mergePhase(
+            _report.get(), "mergeStagedValues");
+        mJobCtx.mStagingValues = false;
+        _MergeStagedValues();
+    }
+
+    UsdMaya_WriteJobReport::ScopedPhase chasersPhase(_report.get(), "chasers");
     for (UsdMayaChaserRefPtr& chaser : mChasers) {
         if (!chaser->ExportFrame(iFrame)) {
             return false;
         }
     }
+    chasersPhase.Release();
 
+    UsdMaya_WriteJobReport::ScopedPhase callbackPhase(
+        _report.get(), "perFrameCallback");
     _PerFrameCallback(iFrame);
 
     return true;
 }
 
+void
+UsdMaya_WriteJob::_MergeStagedValues()
+{
+    std::vector<UsdMayaStagedValueWriter*>& valueWriters =
+        mJobCtx.mStagingValueWriters;
+
+    const UsdEditTarget editTarget = mJobCtx.mStage->GetEditTarget();
+
+    // Comparing against the previously written samples, mapping values into
+    // the edit target and casting them only touches state owned by each
+    // value writer, so this can be spread across threads. Nothing authors to
+    // the stage until all of them are done.
+    WorkParallelForN(
+        valueWriters.size(),
+        [&valueWriters, &editTarget](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                valueWriters[i]->_ResolveStagedValues(editTarget);
+            }
+        });
+
+    {
+        // The attribute specs were all created when the values were staged,
+        // so we only author time-samples here, straight into the layer.
+        SdfChangeBlock changeBlock;
+        for (UsdMayaStagedValueWriter* valueWriter : valueWriters) {
+            valueWriter->_AuthorStagedValues(editTarget);
+        }
+    }
+
+    valueWriters.clear();
+}
+
 bool
 UsdMaya_WriteJob::_FinishWriting()
 {
@@ -527,27 +743,50 @@ UsdMaya_WriteJob::_FinishWriting()
     }
 
     // Running post export function on all the prim writers.
+    UsdMaya_WriteJobReport::ScopedPhase postExportPhase(
+        _report.get(), "postExport");
     for (auto& primWriter: mJobCtx.mMayaPrimWriterList) {
         primWriter->PostExport();
     }
+    postExportPhase.Release();
 
     // Run post export function on the chasers.
+    UsdMaya_WriteJobReport::ScopedPhase chasersPhase(_report.get(), "chasers");
     for (const UsdMayaChaserRefPtr& chaser : mChasers) {
         if (!chaser->PostExport()) {
             return false;
         }
     }
+    chasersPhase.Release();
+
+    // Move whatever is left of the time-samples into the last clip, so that
+    // the exported layer only holds default values.
+    if (_clipChunkSize > 0) {
+        UsdMaya_WriteJobReport::ScopedPhase clipPhase(
+            _report.get(), "writeClip");
+        if (!_WriteClip(std::numeric_limits<double>::infinity())) {
+            return false;
+        }
+        _WriteClipMetadata();
+    }
 
+    UsdMaya_WriteJobReport::ScopedPhase callbackPhase(
+        _report.get(), "postCallback");
     _PostCallback();
+    callbackPhase.Release();
 
     TF_STATUS("Saving stage");
+    UsdMaya_WriteJobReport::ScopedPhase savePhase(_report.get(), "save");
     if (mJobCtx.mStage->GetRootLayer()->PermissionToSave()) {
         mJobCtx.mStage->GetRootLayer()->Save();
     }
+    savePhase.Release();
 
     // If we are making a usdz archive, invoke the packaging API and then clean
     // up the non-packaged stage file.
     if (!_packageName.empty()) {
+        UsdMaya_WriteJobReport::ScopedPhase packagePhase(
+            _report.get(), "package");
         TF_STATUS("Packaging USDZ file");
         _CreatePackage();
     }
@@ -561,11 +800,160 @@ UsdMaya_WriteJob::_FinishWriting()
     // access issues on Windows.
     if (!_packageName.empty()) {
         TfDeleteFile(_fileName);
+        for (const std::string& clipFileName : _clipFileNames) {
+            TfDeleteFile(clipFileName);
+        }
+        if (_clipManifest) {
+            TfDeleteFile(_clipManifest->GetRealPath());
+        }
     }
+    _clipManifest = SdfLayerRefPtr();
 
     return true;
 }
 
+bool
+UsdMaya_WriteJob::_WriteClip(double clipEndTime)
+{
+    const SdfLayerHandle rootLayer = mJobCtx.mStage->GetRootLayer();
+
+    const std::string clipFileName =
+        _MakeClipFileName(_fileName, _clipFileNames.size());
+    TF_STATUS("Writing value clip '%s'", clipFileName.c_str());
+
+    SdfLayerRefPtr clipLayer = SdfLayer::CreateNew(clipFileName);
+    if (!clipLayer) {
+        TF_RUNTIME_ERROR(
+                "Failed to create value clip '%s'", clipFileName.c_str());
+        return false;
+    }
+
+    if (!_clipManifest) {
+        const std::string manifestFileName =
+            _MakeClipManifestFileName(_fileName);
+        _clipManifest = SdfLayer::CreateNew(manifestFileName);
+        if (!_clipManifest) {
+            TF_RUNTIME_ERROR(
+                    "Failed to create value clip manifest '%s'",
+                    manifestFileName.c_str());
+            return false;
+        }
+    }
+
+    // Attributes that have been clipped before must be looked at as well,
+    // even if nothing has been authored for them during this chunk.
+    SdfPathVector attrPaths;
+    rootLayer->Traverse(
+        SdfPath::AbsoluteRootPath(),
+        [&rootLayer, this, &attrPaths](const SdfPath& path) {
+            if (path.IsPropertyPath() &&
+                    (rootLayer->GetNumTimeSamplesForPath(path) > 0 ||
+                     _clipLastValues.count(path) > 0)) {
+                attrPaths.push_back(path);
+            }
+        });
+
+    for (const SdfPath& attrPath : attrPaths) {
+        if (!_CopyAttributeSpec(rootLayer, clipLayer, attrPath) ||
+                !_CopyAttributeSpec(rootLayer, _clipManifest, attrPath)) {
+            TF_RUNTIME_ERROR(
+                    "Failed to create attribute <%s> in value clip '%s'",
+                    attrPath.GetText(),
+                    clipFileName.c_str());
+            return false;
+        }
+
+        bool hasStartSample = false;
+        VtValue lastValue;
+        for (const double time : rootLayer->ListTimeSamplesForPath(attrPath)) {
+            if (time > clipEndTime) {
+                break;
+            }
+
+            VtValue value;
+            rootLayer->QueryTimeSample(attrPath, time, &value);
+            clipLayer->SetTimeSample(attrPath, time, value);
+            hasStartSample |= (time <= _clipStartTime);
+
+            // The sample at the end time also starts the next clip.
+            if (time < clipEndTime) {
+                rootLayer->EraseTimeSample(attrPath, time);
+            }
+            lastValue.Swap(value);
+        }
+
+        // Sparse value writing may have skipped the samples at the start of
+        // this chunk; they are the same as the last one of the previous clip.
+        const auto lastValueIter = _clipLastValues.find(attrPath);
+        if (!hasStartSample && lastValueIter != _clipLastValues.end()) {
+            clipLayer->SetTimeSample(
+                attrPath, _clipStartTime, lastValueIter->second);
+        }
+
+        if (!lastValue.IsEmpty()) {
+            _clipLastValues[attrPath].Swap(lastValue);
+        }
+    }
+
+    if (!clipLayer->Save()) {
+        TF_RUNTIME_ERROR(
+                "Failed to save value clip '%s'", clipFileName.c_str());
+        return false;
+    }
+
+    _clipFileNames.push_back(clipFileName);
+    _clipStartTimes.push_back(_clipStartTime);
+    _clipStartTime = clipEndTime;
+
+    return true;
+}
+
+void
+UsdMaya_WriteJob::_WriteClipMetadata()
+{
+    if (_clipFileNames.empty() || !_clipManifest) {
+        return;
+    }
+
+    _clipManifest->Save();
+
+    // The clips live next to the exported layer, so we reference them with
+    // paths relative to it.
+    VtArray<SdfAssetPath> clipAssetPaths;
+    VtVec2dArray clipActive;
+    for (size_t i = 0; i < _clipFileNames.size(); ++i) {
+        clipAssetPaths.push_back(
+            SdfAssetPath("./" + TfGetBaseName(_clipFileNames[i])));
+        clipActive.push_back(GfVec2d(_clipStartTimes[i], i));
+    }
+
+    // Clip times map stage time to clip time one-to-one.
+    const std::vector<double>& timeSamples = mJobCtx.mArgs.timeSamples;
+    VtVec2dArray clipTimes;
+    clipTimes.push_back(GfVec2d(timeSamples.front(), timeSamples.front()));
+    clipTimes.push_back(GfVec2d(timeSamples.back(), timeSamples.back()));
+
+    const SdfAssetPath manifestAssetPath(
+        "./" + TfGetBaseName(_clipManifest->GetRealPath()));
+
+    // Every root prim with clipped attributes beneath it anchors the clips.
+    for (const SdfPrimSpecHandle& rootPrimSpec :
+            _clipManifest->GetRootPrims()) {
+        const UsdPrim rootPrim =
+            mJobCtx.mStage->GetPrimAtPath(rootPrimSpec->GetPath());
+        if (!rootPrim) {
+            continue;
+        }
+
+        UsdClipsAPI clipsAPI(rootPrim);
+        clipsAPI.SetClipPrimPath(rootPrim.GetPath().GetString());
+        clipsAPI.SetClipAssetPaths(clipAssetPaths);
+        clipsAPI.SetClipActive(clipActive);
+        clipsAPI.SetClipTimes(clipTimes);
+        clipsAPI.SetClipManifestAssetPath(manifestAssetPath);
+    }
+}
+
 TfToken UsdMaya_WriteJob::_WriteVariants(const UsdPrim &usdRootPrim)
 {
     // Some notes about the expected structure that this function will create:
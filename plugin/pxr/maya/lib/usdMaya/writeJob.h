@@ -25,14 +25,19 @@
 #include "pxr/pxr.h"
 
 #include "pxr/base/tf/hashmap.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
 
 #include <maya/MObjectHandle.h>
 
 #include <string>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
 class UsdMaya_ModelKindProcessor;
+class UsdMaya_WriteJobReport;
 
 class UsdMaya_WriteJob
 {
@@ -59,6 +64,20 @@ private:
     /// WriteFrame() call, internal code may generate errors.
     bool _WriteFrame(double iFrame);
 
+    /// Filters the values staged by prim writers for the current frame in
+    /// parallel, then authors the remaining ones in a single change block.
+    void _MergeStagedValues();
+
+    /// Moves the time-samples authored on the root layer for times before
+    /// \p clipEndTime into a new value clip file, which is saved and released
+    /// right away. Samples at \p clipEndTime are copied but kept on the root
+    /// layer, since they also start the next clip.
+    bool _WriteClip(double clipEndTime);
+
+    /// Authors the value clip metadata stitching together the clips written
+    /// by _WriteClip(), and saves the clip manifest.
+    void _WriteClipMetadata();
+
     /// Runs any post-export processes, closes the USD stage, and writes it out
     /// to disk.
     bool _FinishWriting();
@@ -80,6 +99,24 @@ private:
     // Name of destination packaged archive.
     std::string _packageName;
 
+    // Number of frames per value clip, or zero when not streaming clips.
+    size_t _clipChunkSize;
+
+    // Stage time at which the clip currently being written becomes active.
+    double _clipStartTime;
+
+    // Value clips written so far when exporting with a clip chunk size, along
+    // with the stage time at which each of them becomes active.
+    std::vector<std::string> _clipFileNames;
+    std::vector<double> _clipStartTimes;
+
+    // Declares every attribute that has time-samples in the value clips.
+    SdfLayerRefPtr _clipManifest;
+
+    // The last value written to a clip for each clipped attribute, used to
+    // seed the following clips that don't get a sample at their start time.
+    TfHashMap<SdfPath, VtValue, SdfPath::Hash> _clipLastValues;
+
     // Name of current layer since it should be restored after looping over them
     MString mCurrentRenderLayerName;
     
@@ -96,6 +133,13 @@ private:
     UsdMayaWriteJobContext mJobCtx;
 
     std::unique_ptr<UsdMaya_ModelKindProcessor> _modelKindProcessor;
+
+    // Collects the statistics of the export when the profileReport export
+    // arg is enabled, and is null otherwise.
+    std::unique_ptr<UsdMaya_WriteJobReport> _report;
+
+    // Name of the JSON file the report is written to.
+    std::string _reportFileName;
 };
 
 
@@ -89,6 +89,7 @@ const SdfPath INSTANCES_SCOPE_PATH("/InstanceSources");
 
 UsdMayaWriteJobContext::UsdMayaWriteJobContext(const UsdMayaJobExportArgs& args)
     : mArgs(args),
+      mStagingValues(false),
       _skelBindingsProcessor(new UsdMaya_SkelBindingsProcessor())
 {
 }
@@ -107,6 +108,12 @@ UsdMayaWriteJobContext::GetUsdStage() const
     return mStage;
 }
 
+bool
+UsdMayaWriteJobContext::IsStagingValues() const
+{
+    return mStagingValues;
+}
+
 bool
 UsdMayaWriteJobContext::IsMergedTransform(const MDagPath& path) const
 {
@@ -22,6 +22,7 @@
 #include "usdMaya/jobArgs.h"
 #include "usdMaya/primWriter.h"
 #include "usdMaya/primWriterRegistry.h"
+#include "usdMaya/stagedValueWriter.h"
 
 #include "pxr/pxr.h"
 
@@ -49,6 +50,7 @@ class UsdMaya_WriteJob;
 class UsdMayaWriteJobContext
 {
 protected:
+    friend class UsdMayaStagedValueWriter;
     friend class UsdMaya_WriteJob;
 
     PXRUSDMAYA_API
@@ -61,6 +63,13 @@ public:
     const UsdMayaJobExportArgs& GetArgs() const;
     const UsdStageRefPtr& GetUsdStage() const;
 
+    /// Whether prim writers are currently staging their time-sampled values
+    /// instead of authoring them directly on the stage. This is only the case
+    /// while the write job exports a frame with the parallelWrite export arg
+    /// enabled.
+    PXRUSDMAYA_API
+    bool IsStagingValues() const;
+
     /// Whether we will merge the transform at \p path with its single
     /// exportable child shape, given its hierarchy and the current path
     /// translation rules. (This always returns false if the export args
@@ -154,6 +163,12 @@ protected:
     std::vector<UsdMayaPrimWriterSharedPtr> mMayaPrimWriterList;
     // Stage used to write out USD file
     UsdStageRefPtr mStage;
+    // Whether prim writers should stage time-sampled values for the frame
+    // currently being written
+    bool mStagingValues;
+    // Value writers holding staged values for the frame currently being
+    // written
+    std::vector<UsdMayaStagedValueWriter*> mStagingValueWriters;
 
 private:
     /// A pair of paths, the first being the "export path", or where the
@@ -0,0 +1,291 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "pxr/pxr.h"
+#include "usdMaya/writeJobReport.h"
+
+#include "pxr/base/arch/demangle.h"
+#include "pxr/base/js/json.h"
+#include "pxr/base/js/value.h"
+#include "pxr/base/tf/diagnostic.h"
+#include "pxr/base/tf/mallocTag.h"
+
+#include <fstream>
+#include <limits>
+#include <typeinfo>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+// Parent index of the phases started outside of any other phase.
+static constexpr size_t _NoParent = std::numeric_limits<size_t>::max();
+
+UsdMaya_WriteJobReport::UsdMaya_WriteJobReport()
+    : _inFrame(false),
+      _frameStartBytes(0)
+{
+    _totalStopwatch.Start();
+}
+
+/* static */
+int64_t
+UsdMaya_WriteJobReport::_GetAllocatedBytes()
+{
+    if (!TfMallocTag::IsInitialized()) {
+        return 0;
+    }
+    return static_cast<int64_t>(TfMallocTag::GetTotalBytes());
+}
+
+UsdMaya_WriteJobReport::ScopedPhase::ScopedPhase(
+        UsdMaya_WriteJobReport* report,
+        const char* name)
+    : _report(report)
+{
+    if (_report) {
+        _report->_BeginPhase(name);
+    }
+}
+
+UsdMaya_WriteJobReport::ScopedPhase::~ScopedPhase()
+{
+    Release();
+}
+
+void
+UsdMaya_WriteJobReport::ScopedPhase::Release()
+{
+    if (_report) {
+        _report->_EndPhase();
+        _report = nullptr;
+    }
+}
+
+UsdMaya_WriteJobReport::ScopedPrimWriter::ScopedPrimWriter(
+        UsdMaya_WriteJobReport* report,
+        const UsdMayaPrimWriter& primWriter)
+    : _report(report),
+      _writerTypeIndex(0),
+      _startBytes(0)
+{
+    if (_report) {
+        _writerTypeIndex = _report->_GetWriterTypeIndex(primWriter);
+        _startBytes = _GetAllocatedBytes();
+        _stopwatch.Start();
+    }
+}
+
+UsdMaya_WriteJobReport::ScopedPrimWriter::~ScopedPrimWriter()
+{
+    if (_report) {
+        _stopwatch.Stop();
+        _report->_AddWriterSample(
+            _writerTypeIndex,
+            _stopwatch.GetSeconds(),
+            _GetAllocatedBytes() - _startBytes);
+    }
+}
+
+void
+UsdMaya_WriteJobReport::_BeginPhase(const char* name)
+{
+    const size_t parentIndex = _runningPhases.empty() ?
+        _NoParent : _runningPhases.back().phaseIndex;
+
+    // Nested phases are keyed by their full path, e.g. "frame/writePrims".
+    const std::string key = parentIndex == _NoParent ?
+        std::string(name) : _phases[parentIndex].name + "/" + name;
+
+    size_t phaseIndex;
+    const auto phaseIter = _phaseIndices.find(key);
+    if (phaseIter == _phaseIndices.end()) {
+        phaseIndex = _phases.size();
+        _phases.emplace_back();
+        _phases.back().name = key;
+        _phases.back().parentIndex = parentIndex;
+        _phaseIndices.emplace(key, phaseIndex);
+    }
+    else {
+        phaseIndex = phaseIter->second;
+    }
+
+    _runningPhases.emplace_back();
+    _RunningPhase& runningPhase = _runningPhases.back();
+    runningPhase.phaseIndex = phaseIndex;
+    runningPhase.startBytes = _GetAllocatedBytes();
+    runningPhase.stopwatch.Start();
+}
+
+void
+UsdMaya_WriteJobReport::_EndPhase()
+{
+    if (!TF_VERIFY(!_runningPhases.empty())) {
+        return;
+    }
+
+    _RunningPhase& runningPhase = _runningPhases.back();
+    runningPhase.stopwatch.Stop();
+
+    _Phase& phase = _phases[runningPhase.phaseIndex];
+    phase.calls++;
+    phase.seconds += runningPhase.stopwatch.GetSeconds();
+    phase.allocatedBytes += _GetAllocatedBytes() - runningPhase.startBytes;
+
+    _runningPhases.pop_back();
+}
+
+size_t
+UsdMaya_WriteJobReport::_GetWriterTypeIndex(
+        const UsdMayaPrimWriter& primWriter)
+{
+    const std::type_index writerType(typeid(primWriter));
+    const auto writerTypeIter = _writerTypeIndices.find(writerType);
+    if (writerTypeIter != _writerTypeIndices.end()) {
+        return writerTypeIter->second;
+    }
+
+    const size_t writerTypeIndex = _writerTypes.size();
+    _writerTypes.emplace_back();
+    _writerTypes.back().name = ArchGetDemangled(typeid(primWriter));
+    _writerTypeIndices.emplace(writerType, writerTypeIndex);
+    return writerTypeIndex;
+}
+
+void
+UsdMaya_WriteJobReport::_AddWriterSample(
+        size_t writerTypeIndex,
+        double seconds,
+        int64_t allocatedBytes)
+{
+    _WriterType& writerType = _writerTypes[writerTypeIndex];
+    writerType.allocatedBytes += allocatedBytes;
+
+    if (!_inFrame) {
+        writerType.defaultCalls++;
+        writerType.defaultSeconds += seconds;
+        return;
+    }
+
+    writerType.frameCalls++;
+    writerType.frameSeconds += seconds;
+
+    std::vector<double>& writerSeconds = _frames.back().writerSeconds;
+    if (writerSeconds.size() <= writerTypeIndex) {
+        writerSeconds.resize(writerTypeIndex + 1, 0.0);
+    }
+    writerSeconds[writerTypeIndex] += seconds;
+}
+
+void
+UsdMaya_WriteJobReport::BeginFrame(double time)
+{
+    if (!TF_VERIFY(!_inFrame)) {
+        return;
+    }
+
+    _frames.emplace_back();
+    _frames.back().time = time;
+
+    _inFrame = true;
+    _frameStartBytes = _GetAllocatedBytes();
+    _frameStopwatch.Reset();
+    _frameStopwatch.Start();
+}
+
+void
+UsdMaya_WriteJobReport::EndFrame()
+{
+    if (!TF_VERIFY(_inFrame)) {
+        return;
+    }
+
+    _frameStopwatch.Stop();
+
+    _Frame& frame = _frames.back();
+    frame.seconds = _frameStopwatch.GetSeconds();
+    frame.allocatedBytes = _GetAllocatedBytes() - _frameStartBytes;
+
+    _inFrame = false;
+}
+
+bool
+UsdMaya_WriteJobReport::Write(const std::string& fileName) const
+{
+    TfStopwatch totalStopwatch = _totalStopwatch;
+    totalStopwatch.Stop();
+
+    JsArray phases;
+    for (const _Phase& phase : _phases) {
+        JsObject phaseObj;
+        phaseObj["name"] = phase.name;
+        if (phase.parentIndex != _NoParent) {
+            phaseObj["parent"] = _phases[phase.parentIndex].name;
+        }
+        phaseObj["calls"] = static_cast<uint64_t>(phase.calls);
+        phaseObj["seconds"] = phase.seconds;
+        phaseObj["allocatedBytes"] = phase.allocatedBytes;
+        phases.push_back(JsValue(phaseObj));
+    }
+
+    JsArray writerTypes;
+    for (const _WriterType& writerType : _writerTypes) {
+        JsObject writerTypeObj;
+        writerTypeObj["type"] = writerType.name;
+        writerTypeObj["defaultCalls"] =
+            static_cast<uint64_t>(writerType.defaultCalls);
+        writerTypeObj["defaultSeconds"] = writerType.defaultSeconds;
+        writerTypeObj["frameCalls"] =
+            static_cast<uint64_t>(writerType.frameCalls);
+        writerTypeObj["frameSeconds"] = writerType.frameSeconds;
+        writerTypeObj["allocatedBytes"] = writerType.allocatedBytes;
+        writerTypes.push_back(JsValue(writerTypeObj));
+    }
+
+    JsArray frames;
+    for (const _Frame& frame : _frames) {
+        JsObject writerSecondsObj;
+        for (size_t i = 0; i < frame.writerSeconds.size(); ++i) {
+            writerSecondsObj[_writerTypes[i].name] = frame.writerSeconds[i];
+        }
+
+        JsObject frameObj;
+        frameObj["time"] = frame.time;
+        frameObj["seconds"] = frame.seconds;
+        frameObj["allocatedBytes"] = frame.allocatedBytes;
+        frameObj["writerSeconds"] = writerSecondsObj;
+        frames.push_back(JsValue(frameObj));
+    }
+
+    JsObject report;
+    report["version"] = 1;
+    report["allocationTracking"] = TfMallocTag::IsInitialized();
+    report["totalSeconds"] = totalStopwatch.GetSeconds();
+    report["phases"] = phases;
+    report["writerTypes"] = writerTypes;
+    report["frames"] = frames;
+
+    std::ofstream reportFile(fileName.c_str());
+    if (!reportFile) {
+        TF_RUNTIME_ERROR(
+                "Failed to open export report '%s' for writing",
+                fileName.c_str());
+        return false;
+    }
+    reportFile << JsWriteToString(JsValue(report)) << std::endl;
+    return static_cast<bool>(reportFile);
+}
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,152 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_WRITE_JOB_REPORT_H
+#define PXRUSDMAYA_WRITE_JOB_REPORT_H
+
+/// \file usdMaya/writeJobReport.h
+
+#include "usdMaya/primWriter.h"
+
+#include "pxr/pxr.h"
+
+#include "pxr/base/tf/stopwatch.h"
+
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/// Collects timing and allocation statistics for the phases of a
+/// UsdMaya_WriteJob and for each type of prim writer it runs, and writes them
+/// out as a JSON report once the export is done.
+///
+/// Allocated bytes are only tracked when TfMallocTag has been initialized;
+/// they are reported as zero otherwise.
+class UsdMaya_WriteJobReport
+{
+public:
+    UsdMaya_WriteJobReport();
+
+    /// Times the enclosing scope as the export phase \p name. Phases started
+    /// while another one is running are reported as children of that phase.
+    /// Does nothing if \p report is null.
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase(UsdMaya_WriteJobReport* report, const char* name);
+        ~ScopedPhase();
+
+        /// Ends the phase before the end of the enclosing scope.
+        void Release();
+
+    private:
+        UsdMaya_WriteJobReport* _report;
+    };
+
+    /// Times the enclosing scope as a call to Write() on \p primWriter.
+    /// Does nothing if \p report is null.
+    class ScopedPrimWriter
+    {
+    public:
+        ScopedPrimWriter(
+                UsdMaya_WriteJobReport* report,
+                const UsdMayaPrimWriter& primWriter);
+        ~ScopedPrimWriter();
+
+    private:
+        UsdMaya_WriteJobReport* _report;
+        size_t _writerTypeIndex;
+        TfStopwatch _stopwatch;
+        int64_t _startBytes;
+    };
+
+    /// Starts collecting the statistics of the frame at \p time. Prim writer
+    /// timings recorded until EndFrame() are also attributed to that frame.
+    void BeginFrame(double time);
+    void EndFrame();
+
+    /// Writes the report collected so far to \p fileName as JSON.
+    /// Returns \c true if successful.
+    bool Write(const std::string& fileName) const;
+
+private:
+    struct _Phase {
+        std::string name;
+        size_t parentIndex;
+        size_t calls = 0;
+        double seconds = 0.0;
+        int64_t allocatedBytes = 0;
+    };
+
+    struct _WriterType {
+        std::string name;
+        size_t defaultCalls = 0;
+        double defaultSeconds = 0.0;
+        size_t frameCalls = 0;
+        double frameSeconds = 0.0;
+        int64_t allocatedBytes = 0;
+    };
+
+    struct _Frame {
+        double time;
+        double seconds = 0.0;
+        int64_t allocatedBytes = 0;
+        // Seconds spent in each writer type, indexed like _writerTypes.
+        std::vector<double> writerSeconds;
+    };
+
+    struct _RunningPhase {
+        size_t phaseIndex;
+        TfStopwatch stopwatch;
+        int64_t startBytes;
+    };
+
+    static int64_t _GetAllocatedBytes();
+
+    void _BeginPhase(const char* name);
+    void _EndPhase();
+
+    size_t _GetWriterTypeIndex(const UsdMayaPrimWriter& primWriter);
+    void _AddWriterSample(
+            size_t writerTypeIndex,
+            double seconds,
+            int64_t allocatedBytes);
+
+    TfStopwatch _totalStopwatch;
+
+    // Phases in the order they were first started. Phases with the same name
+    // but a different parent are kept apart.
+    std::vector<_Phase> _phases;
+    std::unordered_map<std::string, size_t> _phaseIndices;
+    std::vector<_RunningPhase> _runningPhases;
+
+    std::vector<_WriterType> _writerTypes;
+    std::unordered_map<std::type_index, size_t> _writerTypeIndices;
+
+    std::vector<_Frame> _frames;
+    bool _inFrame;
+    TfStopwatch _frameStopwatch;
+    int64_t _frameStartBytes;
+};
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
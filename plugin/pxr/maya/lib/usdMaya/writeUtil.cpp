@@ -18,6 +18,7 @@
 
 #include "usdMaya/adaptor.h"
 #include "usdMaya/colorSpace.h"
+#include "usdMaya/stagedValueWriter.h"
 #include "usdMaya/translatorUtil.h"
 #include "usdMaya/userTaggedAttribute.h"
 
@@ -463,6 +464,18 @@ _SetAttribute(const UsdAttribute& usdAttr,
            usdAttr.Set(value, usdTime);
 }
 
+template <typename T>
+static bool
+_SetAttribute(const UsdAttribute& usdAttr,
+              const T &value,
+              const UsdTimeCode &usdTime,
+              UsdMayaStagedValueWriter *valueWriter)
+{
+    return valueWriter ?
+           valueWriter->SetAttribute(usdAttr, VtValue(value), usdTime) :
+           usdAttr.Set(value, usdTime);
+}
+
 /// Converts a vec from display to linear color if its role is color.
 template <typename T>
 static
@@ -856,12 +869,13 @@ UsdMayaWriteUtil::GetVtValue(
     return VtValue();
 }
 
-bool
-UsdMayaWriteUtil::SetUsdAttr(
+template <typename ValueWriter>
+static bool
+_SetUsdAttr(
         const MPlug& attrPlug,
         const UsdAttribute& usdAttr,
         const UsdTimeCode& usdTime,
-        UsdUtilsSparseValueWriter *valueWriter)
+        ValueWriter *valueWriter)
 {
     if (!usdAttr || attrPlug.isNull()) {
         return false;
@@ -882,6 +896,28 @@ UsdMayaWriteUtil::SetUsdAttr(
     return _SetAttribute(usdAttr, val, usdTime, valueWriter);
 }
 
+bool
+UsdMayaWriteUtil::SetUsdAttr(
+        const MPlug& attrPlug,
+        const UsdAttribute& usdAttr,
+        const UsdTimeCode& usdTime,
+        UsdUtilsSparseValueWriter *valueWriter)
+{
+    return _SetUsdAttr(
+        attrPlug, usdAttr, usdTime, valueWriter);
+}
+
+bool
+UsdMayaWriteUtil::SetUsdAttr(
+        const MPlug& attrPlug,
+        const UsdAttribute& usdAttr,
+        const UsdTimeCode& usdTime,
+        UsdMayaStagedValueWriter *valueWriter)
+{
+    return _SetUsdAttr(
+        attrPlug, usdAttr, usdTime, valueWriter);
+}
+
 // This method inspects the JSON blob stored in the
 // 'USD_UserExportedAttributesJson' attribute on the Maya node mayaNode and
 // exports any attributes specified there onto usdPrim at time usdTime.
@@ -918,12 +954,13 @@ UsdMayaWriteUtil::SetUsdAttr(
 // USD attribute name collisions will be resolved by using the first attribute
 // visited and warning about subsequent attribute tags.
 //
-bool
-UsdMayaWriteUtil::WriteUserExportedAttributes(
+template <typename ValueWriter>
+static bool
+_WriteUserExportedAttributes(
         const MObject& mayaNode,
         const UsdPrim& usdPrim,
         const UsdTimeCode& usdTime,
-        UsdUtilsSparseValueWriter *valueWriter)
+        ValueWriter *valueWriter)
 {
     std::vector<UsdMayaUserTaggedAttribute> exportedAttributes =
         UsdMayaUserTaggedAttribute::GetUserTaggedAttributesForNode(mayaNode);
@@ -994,6 +1031,28 @@ UsdMayaWriteUtil::WriteUserExportedAttributes(
     return true;
 }
 
+bool
+UsdMayaWriteUtil::WriteUserExportedAttributes(
+        const MObject& mayaNode,
+        const UsdPrim& usdPrim,
+        const UsdTimeCode& usdTime,
+        UsdUtilsSparseValueWriter *valueWriter)
+{
+    return _WriteUserExportedAttributes(
+        mayaNode, usdPrim, usdTime, valueWriter);
+}
+
+bool
+UsdMayaWriteUtil::WriteUserExportedAttributes(
+        const MObject& mayaNode,
+        const UsdPrim& usdPrim,
+        const UsdTimeCode& usdTime,
+        UsdMayaStagedValueWriter *valueWriter)
+{
+    return _WriteUserExportedAttributes(
+        mayaNode, usdPrim, usdTime, valueWriter);
+}
+
 /* static */
 bool
 UsdMayaWriteUtil::WriteMetadataToPrim(
@@ -1011,12 +1070,12 @@ UsdMayaWriteUtil::WriteMetadataToPrim(
     return true;
 }
 
-/* static */
-bool
-UsdMayaWriteUtil::WriteAPISchemaAttributesToPrim(
+template <typename ValueWriter>
+static bool
+_WriteAPISchemaAttributesToPrim(
     const MObject& mayaObject,
     const UsdPrim& prim,
-    UsdUtilsSparseValueWriter *valueWriter)
+    ValueWriter *valueWriter)
 {
     UsdMayaAdaptor adaptor(mayaObject);
     if (!adaptor) {
@@ -1050,14 +1109,36 @@ UsdMayaWriteUtil::WriteAPISchemaAttributesToPrim(
 }
 
 /* static */
-size_t
-UsdMayaWriteUtil::WriteSchemaAttributesToPrim(
+bool
+UsdMayaWriteUtil::WriteAPISchemaAttributesToPrim(
+    const MObject& mayaObject,
+    const UsdPrim& prim,
+    UsdUtilsSparseValueWriter *valueWriter)
+{
+    return _WriteAPISchemaAttributesToPrim(
+        mayaObject, prim, valueWriter);
+}
+
+/* static */
+bool
+UsdMayaWriteUtil::WriteAPISchemaAttributesToPrim(
+    const MObject& mayaObject,
+    const UsdPrim& prim,
+    UsdMayaStagedValueWriter *valueWriter)
+{
+    return _WriteAPISchemaAttributesToPrim(
+        mayaObject, prim, valueWriter);
+}
+
+template <typename ValueWriter>
+static size_t
+_WriteSchemaAttributesToPrim(
     const MObject& object,
     const UsdPrim& prim,
     const TfType& schemaType,
     const std::vector<TfToken>& attributeNames,
     const UsdTimeCode& usdTime,
-    UsdUtilsSparseValueWriter *valueWriter)
+    ValueWriter *valueWriter)
 {
     UsdMayaAdaptor::SchemaAdaptor schema;
     if (UsdMayaAdaptor adaptor = UsdMayaAdaptor(object)) {
@@ -1092,6 +1173,34 @@ UsdMayaWriteUtil::WriteSchemaAttributesToPrim(
     return count;
 }
 
+/* static */
+size_t
+UsdMayaWriteUtil::WriteSchemaAttributesToPrim(
+    const MObject& object,
+    const UsdPrim& prim,
+    const TfType& schemaType,
+    const std::vector<TfToken>& attributeNames,
+    const UsdTimeCode& usdTime,
+    UsdUtilsSparseValueWriter *valueWriter)
+{
+    return _WriteSchemaAttributesToPrim(
+        object, prim, schemaType, attributeNames, usdTime, valueWriter);
+}
+
+/* static */
+size_t
+UsdMayaWriteUtil::WriteSchemaAttributesToPrim(
+    const MObject& object,
+    const UsdPrim& prim,
+    const TfType& schemaType,
+    const std::vector<TfToken>& attributeNames,
+    const UsdTimeCode& usdTime,
+    UsdMayaStagedValueWriter *valueWriter)
+{
+    return _WriteSchemaAttributesToPrim(
+        object, prim, schemaType, attributeNames, usdTime, valueWriter);
+}
+
 // static
 bool
 UsdMayaWriteUtil::WriteClassInherits(
@@ -1133,14 +1242,14 @@ _MapMayaToVtArray(
     return vtArray;
 }
 
-// static
-bool
-UsdMayaWriteUtil::WriteArrayAttrsToInstancer(
+template <typename ValueWriter>
+static bool
+_WriteArrayAttrsToInstancer(
     MFnArrayAttrsData& inputPointsData,
     const UsdGeomPointInstancer& instancer,
     const size_t numPrototypes,
     const UsdTimeCode& usdTime,
-    UsdUtilsSparseValueWriter *valueWriter)
+    ValueWriter *valueWriter)
 {
     MStatus status;
 
@@ -1298,6 +1407,32 @@ UsdMayaWriteUtil::WriteArrayAttrsToInstancer(
     return true;
 }
 
+// static
+bool
+UsdMayaWriteUtil::WriteArrayAttrsToInstancer(
+    MFnArrayAttrsData& inputPointsData,
+    const UsdGeomPointInstancer& instancer,
+    const size_t numPrototypes,
+    const UsdTimeCode& usdTime,
+    UsdUtilsSparseValueWriter *valueWriter)
+{
+    return _WriteArrayAttrsToInstancer(
+        inputPointsData, instancer, numPrototypes, usdTime, valueWriter);
+}
+
+// static
+bool
+UsdMayaWriteUtil::WriteArrayAttrsToInstancer(
+    MFnArrayAttrsData& inputPointsData,
+    const UsdGeomPointInstancer& instancer,
+    const size_t numPrototypes,
+    const UsdTimeCode& usdTime,
+    UsdMayaStagedValueWriter *valueWriter)
+{
+    return _WriteArrayAttrsToInstancer(
+        inputPointsData, instancer, numPrototypes, usdTime, valueWriter);
+}
+
 bool
 UsdMayaWriteUtil::ReadMayaAttribute(
         const MFnDependencyNode& depNode,
@@ -43,6 +43,7 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+class UsdMayaStagedValueWriter;
 class UsdUtilsSparseValueWriter;
 
 /// This struct contains helpers for writing USD (thus reading Maya data).
@@ -155,6 +156,16 @@ struct UsdMayaWriteUtil
             const UsdTimeCode& usdTime,
             UsdUtilsSparseValueWriter *valueWriter=nullptr);
 
+    /// \overload
+    /// Values are written through \p valueWriter, which stages them when
+    /// the write job is staging time-samples.
+    PXRUSDMAYA_API
+    static bool SetUsdAttr(
+            const MPlug& attrPlug,
+            const UsdAttribute& usdAttr,
+            const UsdTimeCode& usdTime,
+            UsdMayaStagedValueWriter *valueWriter);
+
     /// Given a Maya node \p mayaNode, inspect it for attributes tagged by
     /// the user for export to USD and write them onto \p usdPrim at time
     /// \p usdTime.
@@ -165,6 +176,14 @@ struct UsdMayaWriteUtil
             const UsdTimeCode& usdTime,
             UsdUtilsSparseValueWriter *valueWriter=nullptr);
 
+    /// \overload
+    PXRUSDMAYA_API
+    static bool WriteUserExportedAttributes(
+            const MObject& mayaNode,
+            const UsdPrim& usdPrim,
+            const UsdTimeCode& usdTime,
+            UsdMayaStagedValueWriter *valueWriter);
+
     /// Writes all of the adaptor metadata from \p mayaObject onto the \p prim.
     /// Returns true if successful (even if there was nothing to export).
     PXRUSDMAYA_API
@@ -183,6 +202,13 @@ struct UsdMayaWriteUtil
             const UsdPrim& prim,
             UsdUtilsSparseValueWriter *valueWriter=nullptr);
 
+    /// \overload
+    PXRUSDMAYA_API
+    static bool WriteAPISchemaAttributesToPrim(
+            const MObject& mayaObject,
+            const UsdPrim& prim,
+            UsdMayaStagedValueWriter *valueWriter);
+
     template <typename T>
     static size_t WriteSchemaAttributesToPrim(
             const MObject& object,
@@ -200,6 +226,24 @@ struct UsdMayaWriteUtil
                 valueWriter);
     }
 
+    /// \overload
+    template <typename T>
+    static size_t WriteSchemaAttributesToPrim(
+            const MObject& object,
+            const UsdPrim& prim,
+            const std::vector<TfToken>& attributeNames,
+            const UsdTimeCode& usdTime,
+            UsdMayaStagedValueWriter *valueWriter)
+    {
+        return WriteSchemaAttributesToPrim(
+                object,
+                prim,
+                TfType::Find<T>(),
+                attributeNames,
+                usdTime,
+                valueWriter);
+    }
+
     /// Writes schema attributes specified by \attributeNames for the schema
     /// with type \p schemaType to the prim \p prim.
     /// Values are read at the current Maya time, and are written into the USD
@@ -214,6 +258,15 @@ struct UsdMayaWriteUtil
             const UsdTimeCode& usdTime = UsdTimeCode::Default(),
             UsdUtilsSparseValueWriter *valueWriter=nullptr);
 
+    /// \overload
+    static size_t WriteSchemaAttributesToPrim(
+            const MObject& object,
+            const UsdPrim& prim,
+            const TfType& schemaType,
+            const std::vector<TfToken>& attributeNames,
+            const UsdTimeCode& usdTime,
+            UsdMayaStagedValueWriter *valueWriter);
+
     /// Authors class inherits on \p usdPrim.  \p inheritClassNames are
     /// specified as names (not paths).  For example, they should be
     /// ["_class_Special", ...].
@@ -234,6 +287,15 @@ struct UsdMayaWriteUtil
             const UsdTimeCode& usdTime,
             UsdUtilsSparseValueWriter *valueWriter=nullptr);
 
+    /// \overload
+    PXRUSDMAYA_API
+    static bool WriteArrayAttrsToInstancer(
+            MFnArrayAttrsData& inputPointsData,
+            const UsdGeomPointInstancer& instancer,
+            const size_t numPrototypes,
+            const UsdTimeCode& usdTime,
+            UsdMayaStagedValueWriter *valueWriter);
+
     /// \}
 
     /// \name Helpers for reading Maya data
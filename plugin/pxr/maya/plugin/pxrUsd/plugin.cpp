@@ -33,6 +33,7 @@
 #include "usdMaya/proxyShape.h"
 #include "usdMaya/referenceAssembly.h"
 #include "usdMaya/stageData.h"
+#include "usdMaya/stageLoadQueue.h"
 #include "usdMaya/stageNode.h"
 #include "usdMaya/undoHelperCommand.h"
 
@@ -206,6 +207,7 @@ initializePlugin(MObject obj)
     }
 
     UsdMayaSceneResetNotice::InstallListener();
+    UsdMaya_StageLoadQueue::InstallListener();
     UsdMayaDiagnosticDelegate::InstallDelegate();
 
     return status;
@@ -284,6 +286,7 @@ uninitializePlugin(MObject obj)
     CHECK_MSTATUS(status);
 
     UsdMayaSceneResetNotice::RemoveListener();
+    UsdMaya_StageLoadQueue::RemoveListener();
     UsdMayaDiagnosticDelegate::RemoveDelegate();
 
     return status;
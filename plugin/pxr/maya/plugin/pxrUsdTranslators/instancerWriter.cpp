@@ -409,7 +409,7 @@ PxrUsdTranslators_InstancerWriter::writeInstancerAttrs(
 
     if (!UsdMayaWriteUtil::WriteArrayAttrsToInstancer(
             inputPointsData, instancer, _numPrototypes, usdTime,
-            _GetSparseValueWriter())) {
+            _GetStagedValueWriter())) {
         return false;
     }
 
@@ -38,6 +38,7 @@
 #include "pxr/usd/sdf/pathTable.h"
 
 #include <maya/MAnimUtil.h>
+#include <maya/MDGContext.h>
 #include <maya/MDagPath.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnMatrixData.h>
@@ -495,6 +496,51 @@ _GetJointLocalTransforms(
     return true;
 }
 
+/// Resolves the worldMatrix element plug matching the instance of each of
+/// \p dagPaths. Joints whose plug can't be resolved get a null plug.
+static
+void
+_GetJointWorldMatrixPlugs(
+        const std::vector<MDagPath>& dagPaths,
+        std::vector<MPlug>* plugs)
+{
+    plugs->clear();
+    plugs->reserve(dagPaths.size());
+    for (const MDagPath& dagPath : dagPaths) {
+        MStatus status;
+        MFnDependencyNode depNode(dagPath.node(), &status);
+        MPlug plug;
+        if (status) {
+            plug = depNode.findPlug("worldMatrix", true, &status);
+            if (status) {
+                plug = plug.elementByLogicalIndex(
+                    dagPath.instanceNumber(), &status);
+            }
+        }
+        plugs->push_back(status ? plug : MPlug());
+    }
+}
+
+/// Gets the world-space transform of a joint at the current time from its
+/// resolved worldMatrix \p plug, falling back on walking \p dagPath if the
+/// plug is unavailable.
+static
+GfMatrix4d
+_GetJointWorldTransform(const MPlug& plug, const MDagPath& dagPath)
+{
+    if (!plug.isNull()) {
+        MStatus status;
+        MObject matrixObj = plug.asMObject(MDGContext::fsNormal, &status);
+        if (status) {
+            MFnMatrixData matrixData(matrixObj, &status);
+            if (status) {
+                return GfMatrix4d(matrixData.matrix().matrix);
+            }
+        }
+    }
+    return _GetJointWorldTransform(dagPath);
+}
+
 /// Returns true if the joint's transform definitely matches its rest transform
 /// over all exported frames.
 static
@@ -639,6 +685,8 @@ PxrUsdTranslators_JointWriter::_WriteRestState()
 
     if (!animJointNames.empty()) {
 
+        _InitJointSampling();
+
         SdfPath animPath = _GetAnimationPath(skelPath);
         _skelAnim = UsdSkelAnimation::Define(GetUsdStage(), animPath);
 
@@ -693,36 +741,78 @@ PxrUsdTranslators_JointWriter::Write(const UsdTimeCode& usdTime)
             return;
         }
 
-        GfMatrix4d rootXf = _GetJointWorldTransform(_jointHierarchyRootPath);
-
-        VtMatrix4dArray localXforms;
-        if (_GetJointLocalTransforms(_topology, _joints,
-                                     rootXf, &localXforms)) {
-
-            // Remap local xforms into the (possibly sparse) anim order.
-            VtMatrix4dArray animLocalXforms;
-            if (_skelToAnimMapper.Remap(localXforms, &animLocalXforms)) {
-
-                VtVec3fArray translations;
-                VtQuatfArray rotations;
-                VtVec3hArray scales;
-                if (UsdSkelDecomposeTransforms(animLocalXforms, &translations,
-                                               &rotations, &scales)) {
-
-                    // XXX It is difficult for us to tell which components are
-                    // actually animated since we rely on decomposition to get
-                    // separate anim components.
-                    // In the future, we may want to RLE-compress the data in
-                    // PostExport to remove redundant time samples.
-                    _SetAttribute(_skelAnim.GetTranslationsAttr(),
-                                  &translations, usdTime);
-                    _SetAttribute(_skelAnim.GetRotationsAttr(),
-                                  &rotations, usdTime);
-                    _SetAttribute(_skelAnim.GetScalesAttr(),
-                                  &scales, usdTime);
-                }
-            }
+        _WriteAnimation(usdTime);
+    }
+}
+
+void
+PxrUsdTranslators_JointWriter::_InitJointSampling()
+{
+    _GetJointWorldMatrixPlugs(_joints, &_jointWorldMatrixPlugs);
+
+    _worldXforms.resize(_joints.size());
+    _worldInvXforms.resize(_joints.size());
+    _localXforms.resize(_joints.size());
+}
+
+void
+PxrUsdTranslators_JointWriter::_WriteAnimation(const UsdTimeCode& usdTime)
+{
+    if (!TF_VERIFY(_jointWorldMatrixPlugs.size() == _joints.size())) {
+        return;
+    }
+
+    // Sample the world-space transforms of every joint, since computing
+    // the local transform of an animated joint requires its parent's.
+    // The buffers are only mutated in place, so they keep their storage
+    // from one frame to the next.
+    GfMatrix4d* worldXforms = _worldXforms.data();
+    GfMatrix4d* worldInvXforms = _worldInvXforms.data();
+    for (size_t i = 0; i < _joints.size(); ++i) {
+        worldXforms[i] =
+            _GetJointWorldTransform(_jointWorldMatrixPlugs[i], _joints[i]);
+        worldInvXforms[i] = worldXforms[i].GetInverse();
+    }
+
+    const GfMatrix4d rootInvXf =
+        _GetJointWorldTransform(_jointHierarchyRootPath).GetInverse();
+
+    if (!UsdSkelComputeJointLocalTransforms(_topology, _worldXforms,
+                                            _worldInvXforms, &_localXforms,
+                                            &rootInvXf)) {
+        return;
+    }
+
+    // Remap local xforms into the (possibly sparse) anim order. Identity
+    // mappings are decomposed straight from the local xforms, since remapping
+    // would share their storage and force a copy on the next frame.
+    const VtMatrix4dArray* animLocalXforms = &_localXforms;
+    if (!_skelToAnimMapper.IsIdentity()) {
+        if (!_skelToAnimMapper.Remap(_localXforms, &_animLocalXforms)) {
+            return;
         }
+        animLocalXforms = &_animLocalXforms;
+    }
+
+    // The decomposed components are handed over to the value writer without
+    // copying, so they need fresh storage on every frame.
+    VtVec3fArray translations(animLocalXforms->size());
+    VtQuatfArray rotations(animLocalXforms->size());
+    VtVec3hArray scales(animLocalXforms->size());
+    if (UsdSkelDecomposeTransforms(*animLocalXforms, &translations,
+                                   &rotations, &scales)) {
+
+        // XXX It is difficult for us to tell which components are
+        // actually animated since we rely on decomposition to get
+        // separate anim components.
+        // In the future, we may want to RLE-compress the data in
+        // PostExport to remove redundant time samples.
+        _SetAttribute(_skelAnim.GetTranslationsAttr(),
+                      &translations, usdTime);
+        _SetAttribute(_skelAnim.GetRotationsAttr(),
+                      &rotations, usdTime);
+        _SetAttribute(_skelAnim.GetScalesAttr(),
+                      &scales, usdTime);
     }
 }
 
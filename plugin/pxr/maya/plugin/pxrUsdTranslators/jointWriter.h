@@ -23,6 +23,7 @@
 
 #include "usdMaya/writeJobContext.h"
 
+#include "pxr/base/vt/types.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/xform.h"
@@ -32,6 +33,9 @@
 #include "pxr/usd/usdSkel/topology.h"
 
 #include <maya/MFnDependencyNode.h>
+#include <maya/MPlug.h>
+
+#include <vector>
 
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -78,6 +82,14 @@ public:
 private:
     bool _WriteRestState();
 
+    /// Resolves the plugs sampled by _WriteAnimation() for every joint of
+    /// the skeleton, and sizes the per-frame buffers accordingly.
+    void _InitJointSampling();
+
+    /// Samples the transforms of all joints at the current time in bulk,
+    /// and writes the animated ones to the SkelAnimation at \p usdTime.
+    void _WriteAnimation(const UsdTimeCode& usdTime);
+
     bool _valid;
     UsdSkelSkeleton _skel;
     UsdSkelAnimation _skelAnim;
@@ -93,6 +105,16 @@ private:
     std::vector<MDagPath> _joints, _animatedJoints;
     UsdAttribute _skelXformAttr;
     bool _skelXformIsAnimated;
+
+    /// The worldMatrix element plug of each joint in \c _joints, resolved
+    /// once so that the joints don't need to be looked up on every frame.
+    std::vector<MPlug> _jointWorldMatrixPlugs;
+
+    /// Scratch buffers reused when sampling the joints on every frame.
+    VtMatrix4dArray _worldXforms;
+    VtMatrix4dArray _worldInvXforms;
+    VtMatrix4dArray _localXforms;
+    VtMatrix4dArray _animLocalXforms;
 };
 
 
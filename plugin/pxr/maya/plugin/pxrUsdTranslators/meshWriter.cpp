@@ -229,7 +229,6 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     }
 
     unsigned int numVertices = geomMesh.numVertices();
-    unsigned int numPolygons = geomMesh.numPolygons();
 
     // Set mesh attrs ==========
     // Get points
@@ -250,19 +249,19 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     _SetAttribute(primSchema.GetPointsAttr(), &points, usdTime);
     _SetAttribute(primSchema.CreateExtentAttr(), &extent, usdTime);
 
-    // Get faceVertexIndices
-    unsigned int numFaceVertices = geomMesh.numFaceVertices(&status);
-    VtArray<int>     faceVertexCounts(numPolygons);
-    VtArray<int>     faceVertexIndices(numFaceVertices);
-    MIntArray mayaFaceVertexIndices; // used in loop below
-    unsigned int curFaceVertexIndex = 0;
-    for (unsigned int i = 0; i < numPolygons; i++) {
-        geomMesh.getPolygonVertices(i, mayaFaceVertexIndices);
-        faceVertexCounts[i] = mayaFaceVertexIndices.length();
-        for (unsigned int j=0; j < mayaFaceVertexIndices.length(); j++) {
-            faceVertexIndices[ curFaceVertexIndex ] = mayaFaceVertexIndices[j]; // push_back
-            curFaceVertexIndex++;
-        }
+    // Get faceVertexIndices. Both arrays are fetched from Maya in one call.
+    // On animated meshes they are written every time sample, and the sparse
+    // value writer drops the samples that match the previous one.
+    MIntArray mayaFaceVertexCounts;
+    MIntArray mayaFaceVertexIndices;
+    geomMesh.getVertices(mayaFaceVertexCounts, mayaFaceVertexIndices);
+    VtArray<int>     faceVertexCounts(mayaFaceVertexCounts.length());
+    VtArray<int>     faceVertexIndices(mayaFaceVertexIndices.length());
+    if (!faceVertexCounts.empty()) {
+        mayaFaceVertexCounts.get(faceVertexCounts.data());
+    }
+    if (!faceVertexIndices.empty()) {
+        mayaFaceVertexIndices.get(faceVertexIndices.data());
     }
     _SetAttribute(primSchema.GetFaceVertexCountsAttr(), &faceVertexCounts, usdTime);
     _SetAttribute(primSchema.GetFaceVertexIndicesAttr(), &faceVertexIndices, usdTime);
@@ -24,10 +24,10 @@
 
 #include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usdSkel/bindingAPI.h"
 #include "pxr/usd/usdSkel/root.h"
-#include "pxr/usd/usdSkel/utils.h"
 
 #include <maya/MDagPath.h>
 #include <maya/MDagPathArray.h>
@@ -37,7 +37,11 @@
 #include <maya/MItDependencyGraph.h>
 #include <maya/MMatrix.h>
 
+#include <algorithm>
+#include <atomic>
 #include <ostream>
+#include <utility>
+#include <vector>
 
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -157,7 +161,8 @@ _GetRootJoint(const std::vector<MDagPath>& jointDagPaths)
 
 /// Gets skin weights, and compresses them into the form expected by
 /// UsdSkelBindingAPI, which allows us to omit zero-weight influences from the
-/// joint weights list.
+/// joint weights list. The influences of each vertex are sorted by decreasing
+/// weight, as UsdSkelSortInfluences() would sort them.
 static int
 _GetCompressedSkinWeights(
     const MFnMesh& mesh,
@@ -183,46 +188,98 @@ _GetCompressedSkinWeights(
     MFnSingleIndexedComponent components;
     components.create(MFn::kMeshVertComponent);
     components.setCompleteData(numVertices);
-    MDoubleArray weights;
+    MDoubleArray mayaWeights;
     unsigned int numInfluences;
     skinCluster.getWeights(
-            outputDagPath, components.object(), weights, numInfluences);
+            outputDagPath, components.object(), mayaWeights, numInfluences);
+
+    // Copy the weight matrix out into contiguous memory so that the vertices
+    // can be processed in parallel.
+    std::vector<double> weights(mayaWeights.length());
+    if (weights.empty() ||
+            weights.size() < size_t(numVertices) * numInfluences) {
+        return 0;
+    }
+    mayaWeights.get(weights.data());
 
     // Determine how many influence/weight "slots" we actually need per point.
     // For example, if there are the joints /a, /a/b, and /a/c, but each point
     // only has non-zero weighting for a single joint, then we only need one
     // slot instead of three.
-    int maxInfluenceCount = 0;
-    for (unsigned int vert = 0; vert < numVertices; ++vert) {
-        // Looping through each vertex.
-        const unsigned int offset = vert * numInfluences;
-        int influenceCount = 0;
-        for (unsigned int i = 0; i < numInfluences; ++i) {
-            // Looping through each weight for vertex.
-            if (weights[offset + i] != 0.0) {
-                influenceCount++;
+    std::atomic<int> maxInfluenceCount(0);
+    WorkParallelForN(
+        numVertices,
+        [&weights, numInfluences, &maxInfluenceCount](
+                size_t begin, size_t end) {
+            int chunkMaxInfluenceCount = 0;
+            for (size_t vert = begin; vert < end; ++vert) {
+                // Looping through each vertex.
+                const double* vertWeights = &weights[vert * numInfluences];
+                int influenceCount = 0;
+                for (unsigned int i = 0; i < numInfluences; ++i) {
+                    // Looping through each weight for vertex.
+                    if (vertWeights[i] != 0.0) {
+                        influenceCount++;
+                    }
+                }
+                chunkMaxInfluenceCount =
+                    std::max(chunkMaxInfluenceCount, influenceCount);
             }
-        }
-        maxInfluenceCount = std::max(maxInfluenceCount, influenceCount);
-    }
 
-    usdJointIndices->assign(maxInfluenceCount * numVertices, 0);
-    usdJointWeights->assign(maxInfluenceCount * numVertices, 0.0);
-    for (unsigned int vert = 0; vert < numVertices; ++vert) {
-        // Looping through each vertex.
-        const unsigned int inputOffset = vert * numInfluences;
-        int outputOffset = vert * maxInfluenceCount;
-        for (unsigned int i = 0; i < numInfluences; ++i) {
-            // Looping through each weight for vertex.
-            float weight = weights[inputOffset + i];
-            if (!GfIsClose(weight, 0.0, 1e-8)) {
-                (*usdJointIndices)[outputOffset] = i;
-                (*usdJointWeights)[outputOffset] = weight;
-                outputOffset++;
+            int current = maxInfluenceCount;
+            while (chunkMaxInfluenceCount > current &&
+                    !maxInfluenceCount.compare_exchange_weak(
+                        current, chunkMaxInfluenceCount)) {
             }
-        }
-    }
-    return maxInfluenceCount;
+        });
+
+    const int numSlots = maxInfluenceCount;
+    usdJointIndices->assign(numSlots * numVertices, 0);
+    usdJointWeights->assign(numSlots * numVertices, 0.0);
+    int* jointIndices = usdJointIndices->data();
+    float* jointWeights = usdJointWeights->data();
+    WorkParallelForN(
+        numVertices,
+        [&weights, numInfluences, numSlots, jointIndices, jointWeights](
+                size_t begin, size_t end) {
+            // The non-zero (weight, joint index) pairs of a vertex. The buffer
+            // is reused for every vertex of the chunk.
+            std::vector<std::pair<float, int>> vertInfluences;
+            vertInfluences.reserve(numInfluences);
+            for (size_t vert = begin; vert < end; ++vert) {
+                // Looping through each vertex.
+                const double* vertWeights = &weights[vert * numInfluences];
+                vertInfluences.clear();
+                for (unsigned int i = 0; i < numInfluences; ++i) {
+                    // Looping through each weight for vertex.
+                    float weight = vertWeights[i];
+                    if (!GfIsClose(weight, 0.0, 1e-8)) {
+                        vertInfluences.emplace_back(weight, int(i));
+                    }
+                }
+
+                // Only the numSlots heaviest influences fit in the output,
+                // so only those need to be put in order.
+                const size_t numKept =
+                    std::min(vertInfluences.size(), size_t(numSlots));
+                std::partial_sort(
+                    vertInfluences.begin(),
+                    vertInfluences.begin() + numKept,
+                    vertInfluences.end(),
+                    [](const std::pair<float, int>& a,
+                       const std::pair<float, int>& b) {
+                        return a.first > b.first ||
+                            (a.first == b.first && a.second < b.second);
+                    });
+
+                const size_t outputOffset = vert * numSlots;
+                for (size_t i = 0; i < numKept; ++i) {
+                    jointIndices[outputOffset + i] = vertInfluences[i].second;
+                    jointWeights[outputOffset + i] = vertInfluences[i].first;
+                }
+            }
+        });
+    return numSlots;
 }
 
 
@@ -305,8 +362,6 @@ _WriteJointInfluences(const MFnSkinCluster& skinCluster,
     if (maxInfluenceCount <= 0)
         return false;
 
-    UsdSkelSortInfluences(&jointIndices, &jointWeights, maxInfluenceCount);
-
     UsdGeomPrimvar indicesPrimvar =
         binding.CreateJointIndicesPrimvar(false, maxInfluenceCount);
     indicesPrimvar.Set(jointIndices);
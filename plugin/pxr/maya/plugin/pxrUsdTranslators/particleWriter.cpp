@@ -18,6 +18,7 @@
 
 #include "usdMaya/adaptor.h"
 #include "usdMaya/primWriterRegistry.h"
+#include "usdMaya/stagedValueWriter.h"
 #include "usdMaya/transformWriter.h"
 #include "usdMaya/writeJobContext.h"
 
@@ -128,7 +129,7 @@ namespace {
     inline void _addAttr(UsdGeomPoints& points, const TfToken& name,
                          const SdfValueTypeName& typeName,
                          const VtArray<T>& a, const UsdTimeCode& usdTime,
-                         UsdUtilsSparseValueWriter *valueWriter) {
+                         UsdMayaStagedValueWriter *valueWriter) {
         auto attr = points.GetPrim().CreateAttribute(name, typeName, false, SdfVariabilityVarying);
         VtValue val(a);
         valueWriter->SetAttribute(attr, &val, usdTime);
@@ -144,7 +145,7 @@ namespace {
     void _addAttrVec(UsdGeomPoints& points, const SdfValueTypeName& typeName,
                      const _strVecPairVec<T>& a,
                      const UsdTimeCode& usdTime,
-                     UsdUtilsSparseValueWriter *valueWriter) {
+                     UsdMayaStagedValueWriter *valueWriter) {
         for (const auto& v : a) {
             _addAttr(points, v.first, typeName, *v.second, usdTime,
                      valueWriter);
@@ -360,14 +361,14 @@ PxrUsdTranslators_ParticleWriter::writeParams(
     _SetAttribute(points.GetWidthsAttr(), radii.get(), usdTime);
 
     _addAttr(points, _massName, SdfValueTypeNames->FloatArray, *masses, usdTime,
-             _GetSparseValueWriter());
+             _GetStagedValueWriter());
     // TODO: check if we need the array suffix!!
     _addAttrVec(points, SdfValueTypeNames->Vector3fArray, vectors, usdTime,
-                _GetSparseValueWriter());
+                _GetStagedValueWriter());
     _addAttrVec(points, SdfValueTypeNames->FloatArray, floats, usdTime,
-                _GetSparseValueWriter());
+                _GetStagedValueWriter());
     _addAttrVec(points, SdfValueTypeNames->IntArray, ints, usdTime,
-                _GetSparseValueWriter());
+                _GetStagedValueWriter());
 }
 
 void